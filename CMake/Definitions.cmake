@@ -14,10 +14,12 @@ foreach(
   GPERF
   GPERF_HEAP_MAIN
   GPERF_HEAP_FIRST_GAME_ITERATION
+  DEVILUTIONX_PROFILER
   PACKET_ENCRYPTION
   DEVILUTIONX_RESAMPLER_SPEEX
   DEVILUTIONX_RESAMPLER_SDL
   DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
+  DEVILUTIONX_PACKED_DUNGEON_TILES
   UNPACKED_MPQS
   UNPACKED_SAVES
 )
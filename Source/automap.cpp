@@ -825,9 +825,10 @@ void InitAutomap()
 
 	memset(AutomapView, 0, sizeof(AutomapView));
 
-	for (auto &column : dFlags)
-		for (auto &dFlag : column)
-			dFlag &= ~DungeonFlag::Explored;
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++)
+			dFlags[x][y] &= ~DungeonFlag::Explored;
+	}
 }
 
 void StartAutomap()
@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <list>
 
 #ifdef USE_SDL1
 #include "utils/sdl2_to_1_2_backports.h"
@@ -80,6 +79,7 @@ int Slot = SLOTXY_INV_FIRST;
 Point ActiveStashSlot = InvalidStashPoint;
 int PreviousInventoryColumn = -1;
 bool BeltReturnsToStash = false;
+DistanceField MyPlayerDistanceField;
 
 const Direction FaceDir[3][3] = {
 	// NONE             UP                DOWN
@@ -131,10 +131,8 @@ int GetDistance(Point destination, int maxDistance)
 		return 0;
 	}
 
-	int8_t walkpath[MaxPathLength];
-	Player &myPlayer = *MyPlayer;
-	int steps = FindPath([&myPlayer](Point position) { return PosOkPlayer(myPlayer, position); }, myPlayer.position.future, destination, walkpath);
-	if (steps > maxDistance)
+	const int steps = GetMyPlayerDistanceField().distance(destination);
+	if (steps <= 0 || steps > maxDistance)
 		return 0;
 
 	return steps;
@@ -288,71 +286,34 @@ void FindRangedTarget()
 
 void FindMeleeTarget()
 {
-	bool visited[MAXDUNX][MAXDUNY] = { {} };
-	int maxSteps = 25; // Max steps for FindPath is 25
+	int maxDistance = DistanceField::MaxDistance;
 	int rotations = 0;
 	bool canTalk = false;
 
-	struct SearchNode {
-		int x, y;
-		int steps;
-	};
-	std::list<SearchNode> queue;
-
-	Player &myPlayer = *MyPlayer;
+	const DistanceField &distanceField = GetMyPlayerDistanceField();
 
-	{
-		const int startX = myPlayer.position.future.x;
-		const int startY = myPlayer.position.future.y;
-		visited[startX][startY] = true;
-		queue.push_back({ startX, startY, 0 });
-	}
-
-	while (!queue.empty()) {
-		SearchNode node = queue.front();
-		queue.pop_front();
-
-		for (auto pathDir : PathDirs) {
-			const int dx = node.x + pathDir.deltaX;
-			const int dy = node.y + pathDir.deltaY;
-
-			if (visited[dx][dy])
-				continue; // already visisted
-
-			if (node.steps > maxSteps) {
-				visited[dx][dy] = true;
-				continue;
-			}
-
-			if (!PosOkPlayer(myPlayer, { dx, dy })) {
-				visited[dx][dy] = true;
-
-				if (dMonster[dx][dy] != 0) {
-					const int mi = abs(dMonster[dx][dy]) - 1;
-					const auto &monster = Monsters[mi];
-					if (CanTargetMonster(monster)) {
-						const bool newCanTalk = CanTalkToMonst(monster);
-						if (pcursmonst != -1 && !canTalk && newCanTalk)
-							continue;
-						const int newRotations = GetRotaryDistance({ dx, dy });
-						if (pcursmonst != -1 && canTalk == newCanTalk && rotations < newRotations)
-							continue;
-						rotations = newRotations;
-						canTalk = newCanTalk;
-						pcursmonst = mi;
-						if (!canTalk)
-							maxSteps = node.steps; // Monsters found, cap search to current steps
-					}
-				}
-
-				continue;
-			}
+	// Monsters block the player, so they are among the obstacles, which are ordered by distance.
+	for (const Point position : distanceField.obstacles()) {
+		if (distanceField.distance(position) > maxDistance)
+			break;
+		if (dMonster[position.x][position.y] == 0)
+			continue;
 
-			if (path_solid_pieces({ node.x, node.y }, { dx, dy })) {
-				queue.push_back({ dx, dy, node.steps + 1 });
-				visited[dx][dy] = true;
-			}
-		}
+		const int mi = abs(dMonster[position.x][position.y]) - 1;
+		const auto &monster = Monsters[mi];
+		if (!CanTargetMonster(monster))
+			continue;
+		const bool newCanTalk = CanTalkToMonst(monster);
+		if (pcursmonst != -1 && !canTalk && newCanTalk)
+			continue;
+		const int newRotations = GetRotaryDistance(position);
+		if (pcursmonst != -1 && canTalk == newCanTalk && rotations < newRotations)
+			continue;
+		rotations = newRotations;
+		canTalk = newCanTalk;
+		pcursmonst = mi;
+		if (!canTalk)
+			maxDistance = distanceField.distance(position); // Monsters found, cap search to current distance
 	}
 }
 
@@ -1805,8 +1766,23 @@ void plrctrls_every_frame()
 	HandleRightStickMotion();
 }
 
+const DistanceField &GetMyPlayerDistanceField()
+{
+	const Player &myPlayer = *MyPlayer;
+	if (!MyPlayerDistanceField.isValid() || MyPlayerDistanceField.origin() != myPlayer.position.future)
+		MyPlayerDistanceField.update([&myPlayer](Point position) { return PosOkPlayer(myPlayer, position); }, myPlayer.position.future);
+	return MyPlayerDistanceField;
+}
+
+void InvalidateMyPlayerDistanceField()
+{
+	MyPlayerDistanceField.invalidate();
+}
+
 void plrctrls_after_game_logic()
 {
+	// Monsters, players and objects may have moved during the tick.
+	InvalidateMyPlayerDistanceField();
 	Movement(MyPlayerId);
 }
 
@@ -8,6 +8,7 @@
 
 #include "controls/controller.h"
 #include "controls/game_controls.h"
+#include "engine/distance_field.hpp"
 #include "player.h"
 
 namespace devilution {
@@ -50,6 +51,19 @@ void plrctrls_every_frame();
 // Handles player movement.
 void plrctrls_after_game_logic();
 
+/**
+ * @brief Walking distances from the local player's future position, shared by the targeting code.
+ *
+ * Computed when first needed after a game tick or after the player moved, so that monsters, players
+ * and doors that moved or changed during the tick are accounted for.
+ */
+const DistanceField &GetMyPlayerDistanceField();
+
+/**
+ * @brief Forces the distances to be recomputed, for when the level changes.
+ */
+void InvalidateMyPlayerDistanceField();
+
 // Runs at the end of CheckCursMove()
 // Handles item, object, and monster auto-aim.
 void plrctrls_after_check_curs_move();
@@ -13,12 +13,16 @@
 #include "automap.h"
 #include "control.h"
 #include "cursor.h"
+#include "engine/animation_store.hpp"
 #include "engine/backbuffer_state.hpp"
 #include "engine/events.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/point.hpp"
+#include "engine/sound_bank.hpp"
 #include "error.h"
 #include "inv.h"
+#include "items.h"
+#include "levels/layout_cache.h"
 #include "levels/setmaps.h"
 #include "lighting.h"
 #include "monstdat.h"
@@ -31,6 +35,7 @@
 #include "utils/file_util.h"
 #include "utils/language.h"
 #include "utils/log.hpp"
+#include "utils/profiler.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
 
@@ -948,6 +953,66 @@ std::string DebugCmdPlayerInfo(const string_view parameter)
 	    "\nInvincible:", player._pInvincible ? 1 : 0, " HitPoints:", player._pHitPoints);
 }
 
+std::string DebugCmdSoundBanks(const string_view parameter)
+{
+	const SoundBankStats stats = GetSoundBankStats();
+	return StrCat("Sound banks: ", stats.resources, " (", stats.unusedResources, " unused)",
+	    "\nMemory: ", stats.memoryUsed / 1024, " KiB (", stats.unusedMemory / 1024, " KiB unused) of ", stats.memoryBudget / 1024, " KiB",
+	    "\nLoads: ", stats.loads, " Evictions: ", stats.evictions);
+}
+
+std::string DebugCmdAnimations(const string_view parameter)
+{
+	const AnimationStoreStats stats = GetAnimationStoreStats();
+	std::string result = StrCat("Animation sheets: ", stats.resources, " (", stats.unusedResources, " unused)",
+	    "\nMemory: ", stats.memoryUsed / 1024, " KiB (", stats.unusedMemory / 1024, " KiB unused) of ", stats.memoryBudget / 1024, " KiB",
+	    "\nLoads: ", stats.loads, " Evictions: ", stats.evictions);
+	const std::vector<AnimationSheetUsage> usage = GetAnimationSheetUsage();
+	for (size_t i = 0; i < usage.size() && i < 10; i++) {
+		StrAppend(result, "\n", usage[i].memorySize / 1024, " KiB ", usage[i].key, usage[i].inUse ? "" : " (unused)");
+	}
+	return result;
+}
+
+std::string DebugCmdItemCache(const string_view parameter)
+{
+	const ItemRecreationCacheStats stats = GetItemRecreationCacheStats();
+	const size_t lookups = stats.hits + stats.misses;
+	return StrCat("Recreated items: ", stats.entries, " of ", stats.capacity, " cached",
+	    "\nHits: ", stats.hits, " Misses: ", stats.misses, " (", lookups != 0 ? stats.hits * 100 / lookups : 0, "% hits)",
+	    "\nEvictions: ", stats.evictions);
+}
+
+std::string DebugCmdLayoutCache(const string_view parameter)
+{
+	const LayoutCacheStats stats = GetLayoutCacheStats();
+	const size_t lookups = stats.hits + stats.misses;
+	return StrCat("Level layouts: ", stats.layouts, " cached (", stats.memoryUsed / 1024, " KiB)",
+	    "\nHits: ", stats.hits, " Misses: ", stats.misses, " (", lookups != 0 ? stats.hits * 100 / lookups : 0, "% hits)");
+}
+
+std::string DebugCmdProfiler(const string_view parameter)
+{
+#ifdef DEVILUTIONX_PROFILER
+	const auto parts = SplitByChar(parameter, ' ');
+	auto it = parts.begin();
+	if (it == parts.end() || *it == "overlay") {
+		SetProfilerOverlay(!IsProfilerOverlayEnabled());
+		return IsProfilerOverlayEnabled() ? "Showing where the time goes." : "Hiding where the time goes.";
+	}
+	if (*it == "capture") {
+		int frames = 100;
+		if (++it != parts.end())
+			frames = std::max(atoi(std::string(*it).c_str()), 1);
+		const std::string path = StartProfilerCapture(frames);
+		return StrCat("Recording ", frames, " frames to ", path);
+	}
+	return "Use overlay or capture ({frames}).";
+#else
+	return "The profiler is not built in, configure with -DDEVILUTIONX_PROFILER=ON.";
+#endif
+}
+
 std::string DebugCmdToggleFPS(const string_view parameter)
 {
 	frameflag = !frameflag;
@@ -1076,6 +1141,11 @@ std::vector<DebugCmdItem> DebugCmdList = {
 	{ "questinfo", "Shows info of quests.", "{id}", &DebugCmdQuestInfo },
 	{ "playerinfo", "Shows info of player.", "{playerid}", &DebugCmdPlayerInfo },
 	{ "fps", "Toggles displaying FPS", "", &DebugCmdToggleFPS },
+	{ "profiler", "Toggles the profiler overlay or records {frames} frames to a Chrome trace file.", "(overlay|capture ({frames}))", &DebugCmdProfiler },
+	{ "soundbanks", "Shows the memory used by the monster sounds.", "", &DebugCmdSoundBanks },
+	{ "animations", "Shows the memory used by the cached monster, player and missile sprites and the largest sheets.", "", &DebugCmdAnimations },
+	{ "itemcache", "Shows how often recreated items came from the cache.", "", &DebugCmdItemCache },
+	{ "layoutcache", "Shows how often level layouts were reused instead of generated.", "", &DebugCmdLayoutCache },
 	{ "trn", "Makes player use TRN {trn} - Write 'plr' before it to look in plrgfx\\ or 'mon' to look in monsters\\monsters\\ - example: trn plr infra is equal to 'plrgfx\\infra.trn'", "{trn}", &DebugCmdChangeTRN },
 	{ "searchmonster", "Searches the automap for {monster}", "{monster}", &DebugCmdSearchMonster },
 	{ "searchitem", "Searches the automap for {item}", "{item}", &DebugCmdSearchItem },
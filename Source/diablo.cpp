@@ -23,6 +23,7 @@
 #include "discord/discord.h"
 #include "doom.h"
 #include "encrypt.h"
+#include "engine/animation_store.hpp"
 #include "engine/backbuffer_state.hpp"
 #include "engine/clx_sprite.hpp"
 #include "engine/demomode.h"
@@ -33,6 +34,7 @@
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "engine/sound.h"
+#include "engine/sound_bank.hpp"
 #include "error.h"
 #include "gamemenu.h"
 #include "gmenu.h"
@@ -44,6 +46,7 @@
 #include "levels/drlg_l3.h"
 #include "levels/drlg_l4.h"
 #include "levels/gendung.h"
+#include "levels/layout_cache.h"
 #include "levels/setmaps.h"
 #include "levels/themes.h"
 #include "levels/town.h"
@@ -79,6 +82,7 @@
 #include "utils/display.h"
 #include "utils/language.h"
 #include "utils/paths.h"
+#include "utils/profiler.hpp"
 #include "utils/stdcompat/string_view.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/utf8.hpp"
@@ -174,6 +178,7 @@ void FreeGame()
 	FreeMonsterHealthBar();
 	FreeXPBar();
 	FreeControlPan();
+	FreeFloorCache();
 	FreeInvGFX();
 	FreeGMenu();
 	FreeQuestText();
@@ -188,6 +193,8 @@ void FreeGame()
 	FreeDebugGFX();
 #endif
 	FreeGameMem();
+	FreeAnimationSheets();
+	ClearLayoutCache();
 	music_stop();
 }
 
@@ -814,6 +821,9 @@ void RunGameLoop(interface_mode uMsg)
 #endif
 
 	while (gbRunGame) {
+#ifdef DEVILUTIONX_PROFILER
+		ProfilerNextFrame();
+#endif
 
 #ifdef _DEBUG
 		if (!gbGameLoopStartup && !DebugCmdsFromCommandLine.empty()) {
@@ -1339,33 +1349,46 @@ void UpdateMonsterLights()
 
 void GameLogic()
 {
+	DVL_PROFILE_ZONE("GameLogic");
+	DVL_PROFILE_STEPS(steps);
+	DVL_PROFILE_STEP(steps, "ProcessInput");
 	if (!ProcessInput()) {
 		return;
 	}
 	if (gbProcessPlayers) {
 		gGameLogicStep = GameLogicStep::ProcessPlayers;
+		DVL_PROFILE_STEP(steps, "ProcessPlayers");
 		ProcessPlayers();
 	}
 	if (leveltype != DTYPE_TOWN) {
 		gGameLogicStep = GameLogicStep::ProcessMonsters;
+		DVL_PROFILE_STEP(steps, "ProcessMonsters");
 		ProcessMonsters();
 		gGameLogicStep = GameLogicStep::ProcessObjects;
+		DVL_PROFILE_STEP(steps, "ProcessObjects");
 		ProcessObjects();
 		gGameLogicStep = GameLogicStep::ProcessMissiles;
+		DVL_PROFILE_STEP(steps, "ProcessMissiles");
 		ProcessMissiles();
 		gGameLogicStep = GameLogicStep::ProcessItems;
+		DVL_PROFILE_STEP(steps, "ProcessItems");
 		ProcessItems();
+		DVL_PROFILE_STEP(steps, "ProcessLightAndVision");
 		ProcessLightList();
 		ProcessVisionList();
 	} else {
 		gGameLogicStep = GameLogicStep::ProcessTowners;
+		DVL_PROFILE_STEP(steps, "ProcessTowners");
 		ProcessTowners();
 		gGameLogicStep = GameLogicStep::ProcessItemsTown;
+		DVL_PROFILE_STEP(steps, "ProcessItems");
 		ProcessItems();
 		gGameLogicStep = GameLogicStep::ProcessMissilesTown;
+		DVL_PROFILE_STEP(steps, "ProcessMissiles");
 		ProcessMissiles();
 	}
 	gGameLogicStep = GameLogicStep::None;
+	DVL_PROFILE_STEP(steps, "TriggersAndQuests");
 
 #ifdef _DEBUG
 	if (DebugScrollViewEnabled && (SDL_GetModState() & KMOD_SHIFT) != 0) {
@@ -2653,6 +2676,9 @@ void DisableInputEventHandler(const SDL_Event &event, uint16_t modState)
 
 void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 {
+	DVL_PROFILE_ZONE("LoadGameLevel");
+	DVL_PROFILE_STEPS(steps);
+	DVL_PROFILE_STEP(steps, "LoadLvlGFX");
 	_music_id neededTrack = GetLevelMusic(leveltype);
 	ClearFloatingNumbers();
 
@@ -2662,12 +2688,17 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 		NewCursor(CURSOR_HAND);
 	}
 	SetRndSeed(glSeedTbl[currlevel]);
+	if (firstflag)
+		InitStores();
+	if (leveltype == DTYPE_TOWN)
+		QueueTownStores();
 	IncProgress();
 	MakeLightTable();
 	SetDungeonMicros();
 	LoadLvlGFX();
 	IncProgress();
 
+	DVL_PROFILE_STEP(steps, "InitStores");
 	if (firstflag) {
 		CloseInventory();
 		qtextflag = false;
@@ -2677,13 +2708,12 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 			InitInfoBoxGfx();
 			InitHelp();
 		}
-		InitStores();
 		InitAutomapOnce();
 	}
 	SetRndSeed(glSeedTbl[currlevel]);
 
 	if (leveltype == DTYPE_TOWN) {
-		SetupTownStores();
+		FinishTownStores();
 	} else {
 		FreeStoreMem();
 	}
@@ -2693,6 +2723,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	}
 
 	IncProgress();
+	DVL_PROFILE_STEP(steps, "InitLevelState");
 	InitAutomap();
 
 	if (leveltype != DTYPE_TOWN && lvldir != ENTRY_LOAD) {
@@ -2706,11 +2737,13 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	Player &myPlayer = *MyPlayer;
 
 	if (!setlevel) {
+		DVL_PROFILE_STEP(steps, "CreateLevel");
 		CreateLevel(lvldir);
 		IncProgress();
 		LoadLevelSOLData();
 		SetRndSeed(glSeedTbl[currlevel]);
 
+		DVL_PROFILE_STEP(steps, "LoadMonsterAndLevelGFX");
 		if (leveltype != DTYPE_TOWN) {
 			GetLevelMTypes();
 			InitThemes();
@@ -2739,6 +2772,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 
 		IncProgress();
 
+		DVL_PROFILE_STEP(steps, "InitPlayers");
 		for (Player &player : Players) {
 			if (player.plractive && player.isOnActiveLevel()) {
 				InitPlayerGFX(player);
@@ -2759,6 +2793,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 
 		SetRndSeed(glSeedTbl[currlevel]);
 
+		DVL_PROFILE_STEP(steps, "PopulateLevel");
 		if (leveltype != DTYPE_TOWN) {
 			if (firstflag || lvldir == ENTRY_LOAD || !myPlayer._pLvlVisited[currlevel] || gbIsMultiplayer) {
 				HoldThemeRooms();
@@ -2821,6 +2856,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 		else
 			ResyncQuests();
 	} else {
+		DVL_PROFILE_STEP(steps, "LoadSetLevel");
 		LoadSetMap();
 		IncProgress();
 		GetLevelMTypes();
@@ -2872,6 +2908,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 		IncProgress();
 	}
 
+	DVL_PROFILE_STEP(steps, "FinishLevel");
 	SyncPortals();
 
 	for (Player &player : Players) {
@@ -2910,6 +2947,17 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 		}
 	}
 
+	// The monster sounds were loaded in the background while the rest of the level was.
+	DVL_PROFILE_STEP(steps, "WaitForSoundBanks");
+	WaitForSoundBanks();
+	TrimSoundBanks();
+	// The sheets of the previous level that this one didn't request again can be freed now.
+	TrimAnimationSheets();
+
+	// The layout and lighting of the level were replaced as a whole.
+	DungeonLayoutVersion++;
+	LightingVersion++;
+
 #ifndef USE_SDL1
 	ActivateVirtualGamepad();
 #endif
@@ -2928,6 +2976,7 @@ void LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	sgbMouseDown = CLICK_NONE;
 	ResetItemlabelHighlighted(); // level changed => item changed
 	pcursmonst = -1;             // ensure pcurstemp is set to a valid value
+	InvalidateMyPlayerDistanceField();
 	CheckCursMove();
 }
 
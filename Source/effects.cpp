@@ -7,6 +7,7 @@
 
 #include "engine/random.hpp"
 #include "engine/sound.h"
+#include "engine/sound_bank.hpp"
 #include "engine/sound_defs.hpp"
 #include "engine/sound_position.hpp"
 #include "init.h"
@@ -991,6 +992,15 @@ void StreamUpdate()
 	}
 }
 
+SoundPriority GetSoundPriority(const TSFX &sfx)
+{
+	if ((sfx.bFlags & sfx_UI) != 0)
+		return SoundPriority::Interface;
+	if ((sfx.bFlags & (sfx_WARRIOR | sfx_ROGUE | sfx_SORCERER | sfx_MONK)) != 0)
+		return SoundPriority::Hero;
+	return SoundPriority::World;
+}
+
 void PlaySfxPriv(TSFX *pSFX, bool loc, Point position)
 {
 	if (MyPlayer->pLvlLoad != 0 && gbIsMultiplayer) {
@@ -1019,7 +1029,7 @@ void PlaySfxPriv(TSFX *pSFX, bool loc, Point position)
 		pSFX->pSnd = sound_file_load(pSFX->pszName);
 
 	if (pSFX->pSnd != nullptr && pSFX->pSnd->DSB.IsLoaded())
-		snd_play_snd(pSFX->pSnd.get(), lVolume, lPan);
+		snd_play_snd(pSFX->pSnd.get(), lVolume, lPan, GetSoundPriority(*pSFX));
 }
 
 _sfx_id RndSFX(_sfx_id psfx)
@@ -1147,6 +1157,7 @@ void effects_cleanup_sfx()
 
 	for (auto &sfx : sgSFX)
 		sfx.pSnd = nullptr;
+	FreeSoundBanks();
 }
 
 void sound_init()
@@ -1195,7 +1206,7 @@ void effects_play_sound(_sfx_id id)
 
 	TSFX &sfx = sgSFX[id];
 	if (sfx.pSnd != nullptr && !sfx.pSnd->isPlaying()) {
-		snd_play_snd(sfx.pSnd.get(), 0, 0);
+		snd_play_snd(sfx.pSnd.get(), 0, 0, SoundPriority::Interface);
 	}
 }
 
@@ -0,0 +1,236 @@
+/**
+ * @file animation_store.cpp
+ *
+ * Implementation of sprite files that are loaded in the background when first needed and cached within a memory budget.
+ */
+#include "engine/animation_store.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "appfat.h"
+#include "engine/assets.hpp"
+#include "engine/render/clx_render.hpp"
+#include "utils/cl2_to_clx.hpp"
+#include "utils/endian.hpp"
+#include "utils/log.hpp"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+/**
+ * Sheets beyond this that nothing holds are freed. The player and missile sheets are held all game,
+ * monster sheets are released by `ReleaseIdleMonsterGraphics` once they exceed 40 MiB (6 MiB on 3DS).
+ */
+#ifdef __3DS__
+constexpr size_t DefaultMemoryBudget = 12 * 1024 * 1024;
+#else
+constexpr size_t DefaultMemoryBudget = 64 * 1024 * 1024;
+#endif
+
+ResourceCache<AnimationSheet> Sheets { DefaultMemoryBudget };
+
+/**
+ * @brief Reads a whole file, on any thread.
+ */
+std::unique_ptr<uint8_t[]> ReadAsset(const std::string &path, size_t &size, std::string &error)
+{
+	AssetHandle handle = OpenAsset(path.c_str(), size, /*threadsafe=*/true);
+	if (!handle.ok()) {
+		error = StrCat(path, "\n\n", handle.error());
+		return nullptr;
+	}
+	std::unique_ptr<uint8_t[]> data { new uint8_t[size] };
+	if (!handle.read(data.get(), size)) {
+		error = StrCat(path, "\n\n", handle.error());
+		return nullptr;
+	}
+	return data;
+}
+
+/**
+ * @brief Converts a loaded file to CLX in place and returns its number of lists, 0 for a single list.
+ */
+uint16_t ConvertToClx(uint8_t *data, size_t size, uint16_t width)
+{
+#ifdef UNPACKED_MPQS
+	// Unpacked assets are already converted.
+	(void)width;
+	return GetNumListsFromClxListOrSheetBuffer(data, size);
+#else
+	return Cl2ToClx(data, size, PointerOrValue<uint16_t> { width });
+#endif
+}
+
+/**
+ * @brief Reads one file per direction into a single sheet, like `LoadMultipleCl2Sheet`.
+ */
+std::unique_ptr<uint8_t[]> ReadSheet(const std::vector<std::string> &paths, uint16_t width, size_t &size, std::string &error)
+{
+	std::vector<std::unique_ptr<uint8_t[]>> files;
+	std::vector<size_t> fileSizes;
+	const size_t sheetHeaderSize = 4 * paths.size();
+	size = sheetHeaderSize;
+	for (const std::string &path : paths) {
+		size_t fileSize;
+		files.push_back(ReadAsset(path, fileSize, error));
+		if (files.back() == nullptr)
+			return nullptr;
+		fileSizes.push_back(fileSize);
+		size += fileSize;
+	}
+
+	std::unique_ptr<uint8_t[]> data { new uint8_t[size] };
+	size_t accumulatedSize = sheetHeaderSize;
+	for (size_t i = 0; i < files.size(); i++) {
+		std::copy_n(files[i].get(), fileSizes[i], &data[accumulatedSize]);
+		WriteLE32(&data[i * 4], static_cast<uint32_t>(accumulatedSize));
+		[[maybe_unused]] const uint16_t numLists = ConvertToClx(&data[accumulatedSize], fileSizes[i], width);
+		assert(numLists == 0);
+		accumulatedSize += fileSizes[i];
+	}
+	return data;
+}
+
+std::string GetSheetKey(const std::string &path, const std::optional<AnimationSheetTrn> &trn)
+{
+	return trn ? StrCat(path, "+", trn->path) : path;
+}
+
+/**
+ * @brief Reads the colour translation of a sheet, on any thread.
+ * @return Whether the sheet can be loaded, which is the case without translation when an optional file is missing
+ */
+bool ReadTrn(const AnimationSheetTrn &trn, std::optional<std::array<uint8_t, 256>> &colors, std::string &error)
+{
+	AssetHandle handle = OpenAsset(trn.path.c_str(), /*threadsafe=*/true);
+	if (!handle.ok()) {
+		if (trn.optional)
+			return true;
+		error = StrCat(trn.path, "\n\n", handle.error());
+		return false;
+	}
+	colors.emplace();
+	if (!handle.read(colors->data(), colors->size())) {
+		colors = std::nullopt;
+		error = StrCat(trn.path, "\n\n", handle.error());
+		return false;
+	}
+	if (trn.transparent255)
+		std::replace(colors->begin(), colors->end(), 255, 0);
+	return true;
+}
+
+} // namespace
+
+AnimationSheet::AnimationSheet(std::string key, std::vector<std::string> paths, uint16_t width, std::optional<AnimationSheetTrn> trn)
+    : key_(std::move(key))
+    , paths_(std::move(paths))
+    , trn_(std::move(trn))
+    , width_(width)
+{
+}
+
+void AnimationSheet::load()
+{
+	std::optional<std::array<uint8_t, 256>> trn;
+	if (trn_ && !ReadTrn(*trn_, trn, error_)) {
+		loaded_.store(true, std::memory_order_release);
+		return;
+	}
+
+	size_t size;
+	std::unique_ptr<uint8_t[]> data;
+	if (paths_.size() == 1) {
+		data = ReadAsset(paths_[0], size, error_);
+		if (data != nullptr)
+			numLists_ = ConvertToClx(data.get(), size, width_);
+	} else {
+		data = ReadSheet(paths_, width_, size, error_);
+		numLists_ = static_cast<uint16_t>(paths_.size());
+	}
+	if (data != nullptr && trn) {
+		if (numLists_ != 0) {
+			ClxApplyTrans(ClxSpriteSheet { data.get(), numLists_ }, trn->data());
+		} else {
+			ClxApplyTrans(ClxSpriteList { data.get() }, trn->data());
+		}
+	}
+	if (data != nullptr) {
+		data_ = std::move(data);
+		memorySize_ = size;
+	}
+	loaded_.store(true, std::memory_order_release);
+}
+
+void AnimationSheet::checkError() const
+{
+	if (isLoaded() && data_ == nullptr)
+		app_fatal(StrCat("Failed to open file:\n", error_));
+}
+
+std::shared_ptr<AnimationSheet> RequestAnimationSheet(const std::string &path, uint16_t width, const std::optional<AnimationSheetTrn> &trn)
+{
+	std::string key = GetSheetKey(path, trn);
+	std::shared_ptr<AnimationSheet> sheet = Sheets.find(key);
+	if (sheet != nullptr)
+		return sheet;
+
+	sheet = std::make_shared<AnimationSheet>(std::move(key), std::vector<std::string> { path }, width, trn);
+	Sheets.queue(sheet);
+	return sheet;
+}
+
+std::shared_ptr<AnimationSheet> RequestAnimationSheet(const std::string &key, std::vector<std::string> paths, uint16_t width)
+{
+	std::shared_ptr<AnimationSheet> sheet = Sheets.find(key);
+	if (sheet != nullptr)
+		return sheet;
+
+	sheet = std::make_shared<AnimationSheet>(key, std::move(paths), width, std::nullopt);
+	Sheets.queue(sheet);
+	return sheet;
+}
+
+void WaitForAnimationSheet(AnimationSheet &sheet)
+{
+	Sheets.wait(sheet);
+}
+
+void TrimAnimationSheets()
+{
+	const AnimationStoreStats stats = Sheets.trim();
+	LogVerbose("Animation sheets: {} loaded ({} unused), {} of {} KiB used ({} KiB unused), {} loads, {} evictions",
+	    stats.resources, stats.unusedResources, stats.memoryUsed / 1024, stats.memoryBudget / 1024, stats.unusedMemory / 1024, stats.loads, stats.evictions);
+}
+
+void SetAnimationMemoryBudget(size_t bytes)
+{
+	Sheets.setMemoryBudget(bytes);
+}
+
+AnimationStoreStats GetAnimationStoreStats()
+{
+	return Sheets.stats();
+}
+
+std::vector<AnimationSheetUsage> GetAnimationSheetUsage()
+{
+	std::vector<AnimationSheetUsage> usage;
+	usage.reserve(Sheets.resources().size());
+	for (const std::shared_ptr<AnimationSheet> &sheet : Sheets.resources())
+		usage.push_back({ sheet->key(), sheet->memorySize(), ResourceCache<AnimationSheet>::IsInUse(sheet) });
+	std::sort(usage.begin(), usage.end(), [](const AnimationSheetUsage &a, const AnimationSheetUsage &b) {
+		return a.memorySize > b.memorySize;
+	});
+	return usage;
+}
+
+void FreeAnimationSheets()
+{
+	Sheets.clear();
+}
+
+} // namespace devilution
@@ -0,0 +1,161 @@
+/**
+ * @file animation_store.hpp
+ *
+ * Sprite files that are loaded in the background when first needed and cached within a memory budget.
+ *
+ * Monster, player and missile graphics all come from here, so a file is only held once however many
+ * actors use it and it survives level changes for as long as the budget allows.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/clx_sprite.hpp"
+#include "engine/resource_cache.hpp"
+#include "utils/stdcompat/optional.hpp"
+
+namespace devilution {
+
+/**
+ * @brief A colour translation applied to the frames of a sheet when it is loaded.
+ *
+ * The file is only read when the sheet is built, sheets that are still cached are reused without reading it.
+ */
+struct AnimationSheetTrn {
+	/** The TRN file, also identifies the translation. */
+	std::string path;
+	/** Whether the sheet is loaded without translation if the file doesn't exist. */
+	bool optional = false;
+	/** Whether colours translated to 255 become transparent instead, as the monster translations expect. */
+	bool transparent255 = false;
+};
+
+/**
+ * @brief A CL2 animation file converted to CLX, such as the walking animation of a monster type.
+ *
+ * A sheet can also be made of one file per direction, like most missiles.
+ *
+ * Sheets are loaded on a background thread and kept after the last user releases them,
+ * until `TrimAnimationSheets` frees them to stay within the memory budget.
+ */
+class AnimationSheet {
+public:
+	/**
+	 * @param key Identifies the sheet
+	 * @param paths The animation file, or one file per direction
+	 * @param width Width of the frames
+	 * @param trn Colour translation applied to the frames
+	 */
+	AnimationSheet(std::string key, std::vector<std::string> paths, uint16_t width, std::optional<AnimationSheetTrn> trn);
+
+	/**
+	 * @brief Identifies the sheet, requesting the same files and colour translation again returns the same sheet.
+	 */
+	[[nodiscard]] const std::string &key() const
+	{
+		return key_;
+	}
+
+	[[nodiscard]] bool isLoaded() const
+	{
+		return loaded_.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief The sprite lists, empty while the sheet is still being loaded.
+	 */
+	[[nodiscard]] OptionalClxSpriteListOrSheet sprites() const
+	{
+		if (!isLoaded() || data_ == nullptr)
+			return std::nullopt;
+		return ClxSpriteListOrSheet { data_.get(), numLists_ };
+	}
+
+	/**
+	 * @brief Bytes held by the sheet, 0 until it is loaded.
+	 */
+	[[nodiscard]] size_t memorySize() const
+	{
+		return isLoaded() ? memorySize_ : 0;
+	}
+
+	/**
+	 * @brief Loads the files, called on the loader thread.
+	 */
+	void load();
+
+	/**
+	 * @brief Shows the error and quits if a file couldn't be loaded, called on the main thread.
+	 */
+	void checkError() const;
+
+	/** @brief When the sheet was last requested, used to free the least recently used sheets first. */
+	uint32_t lastRequest = 0;
+
+private:
+	std::string key_;
+	std::vector<std::string> paths_;
+	std::optional<AnimationSheetTrn> trn_;
+	uint16_t width_;
+	std::unique_ptr<uint8_t[]> data_;
+	uint16_t numLists_ = 0;
+	size_t memorySize_ = 0;
+	std::string error_;
+	std::atomic<bool> loaded_ { false };
+};
+
+using AnimationStoreStats = ResourceCacheStats;
+
+/**
+ * @brief Memory held by one sheet.
+ */
+struct AnimationSheetUsage {
+	std::string key;
+	size_t memorySize;
+	bool inUse;
+};
+
+/**
+ * @brief Returns the sheet for `path`, which is queued to be loaded in the background if it isn't cached.
+ *
+ * A sheet is in use for as long as the returned pointer (or a copy) is held.
+ */
+std::shared_ptr<AnimationSheet> RequestAnimationSheet(const std::string &path, uint16_t width, const std::optional<AnimationSheetTrn> &trn = std::nullopt);
+
+/**
+ * @brief Returns the sheet made of one file per direction, identified by `key`.
+ */
+std::shared_ptr<AnimationSheet> RequestAnimationSheet(const std::string &key, std::vector<std::string> paths, uint16_t width);
+
+/**
+ * @brief Blocks until `sheet` is loaded, loading it on the calling thread if the loader hasn't started on it yet.
+ */
+void WaitForAnimationSheet(AnimationSheet &sheet);
+
+/**
+ * @brief Frees unused sheets, the least recently requested first, until the sheets fit within the memory budget.
+ *
+ * Sheets that are in use are never freed, even when they alone exceed the budget.
+ */
+void TrimAnimationSheets();
+
+void SetAnimationMemoryBudget(size_t bytes);
+AnimationStoreStats GetAnimationStoreStats();
+
+/**
+ * @brief The memory held by each sheet, the largest first.
+ */
+std::vector<AnimationSheetUsage> GetAnimationSheetUsage();
+
+/**
+ * @brief Waits for the loader and forgets all sheets, those in use are freed once they are released.
+ */
+void FreeAnimationSheets();
+
+} // namespace devilution
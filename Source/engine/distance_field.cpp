@@ -0,0 +1,72 @@
+/**
+ * @file distance_field.cpp
+ *
+ * Implementation of walking distances from one tile to all tiles around it.
+ */
+#include "engine/distance_field.hpp"
+
+#include <cstring>
+
+#include "engine/path.h"
+#include "levels/gendung.h"
+
+namespace devilution {
+
+DistanceField::DistanceField()
+{
+	tiles_.reserve(Size * Size);
+}
+
+bool DistanceField::inWindow(Point position) const
+{
+	return origin_.WalkingDistance(position) <= MaxDistance;
+}
+
+uint8_t &DistanceField::at(Point position)
+{
+	return distances_[position.x - origin_.x + MaxDistance][position.y - origin_.y + MaxDistance];
+}
+
+void DistanceField::update(tl::function_ref<bool(Point)> posOk, Point start)
+{
+	origin_ = start;
+	valid_ = true;
+	std::memset(distances_, Unreached, sizeof(distances_));
+	tiles_.clear();
+	obstacles_.clear();
+	if (!InDungeonBounds(start))
+		return;
+
+	at(start) = 0;
+	tiles_.push_back(start);
+	for (size_t i = 0; i < tiles_.size(); i++) {
+		const Point position = tiles_[i];
+		const uint8_t steps = at(position);
+		if (steps >= MaxDistance)
+			continue;
+		for (const Displacement &pathDir : PathDirs) {
+			const Point next = position + pathDir;
+			if (!InDungeonBounds(next) || at(next) != Unreached)
+				continue;
+			if (!posOk(next)) {
+				at(next) = steps + 1;
+				obstacles_.push_back(next);
+				continue;
+			}
+			if (path_solid_pieces(position, next)) {
+				at(next) = steps + 1;
+				tiles_.push_back(next);
+			}
+		}
+	}
+}
+
+int DistanceField::distance(Point position) const
+{
+	if (!valid_ || !inWindow(position))
+		return -1;
+	const uint8_t steps = distances_[position.x - origin_.x + MaxDistance][position.y - origin_.y + MaxDistance];
+	return steps == Unreached ? -1 : steps;
+}
+
+} // namespace devilution
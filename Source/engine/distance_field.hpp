@@ -0,0 +1,80 @@
+/**
+ * @file distance_field.hpp
+ *
+ * Walking distances from one tile to all tiles around it.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <function_ref.hpp>
+
+#include "engine/point.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Walking steps from a start tile to every tile within `MaxDistance` steps, found with a single breadth-first search.
+ *
+ * Steps follow the same rules as `FindPath`: a tile can be entered if it passes the check and the step
+ * doesn't cut a solid corner. Tiles that fail the check are still given the distance at which they were
+ * first reached, as they can be the target of a path (e.g. a monster or a towner).
+ */
+class DistanceField {
+public:
+	/** Tiles reached after this many steps aren't expanded further. */
+	static constexpr int MaxDistance = 26;
+
+	DistanceField();
+
+	/**
+	 * @brief Recomputes the distances from `start`, using `posOk` to check whether a tile can be walked on.
+	 */
+	void update(tl::function_ref<bool(Point)> posOk, Point start);
+
+	/** @brief Forgets the distances, `isValid` returns false until the next `update`. */
+	void invalidate()
+	{
+		valid_ = false;
+	}
+
+	[[nodiscard]] bool isValid() const
+	{
+		return valid_;
+	}
+
+	[[nodiscard]] Point origin() const
+	{
+		return origin_;
+	}
+
+	/**
+	 * @brief Number of steps to reach `position`, -1 if it can't be reached within `MaxDistance` steps.
+	 */
+	[[nodiscard]] int distance(Point position) const;
+
+	/**
+	 * @brief The reachable tiles that failed the check, in the order the search found them (by increasing distance).
+	 */
+	[[nodiscard]] const std::vector<Point> &obstacles() const
+	{
+		return obstacles_;
+	}
+
+private:
+	static constexpr int Size = 2 * MaxDistance + 1;
+	static constexpr uint8_t Unreached = 0xFF;
+
+	[[nodiscard]] bool inWindow(Point position) const;
+	uint8_t &at(Point position);
+
+	Point origin_ {};
+	bool valid_ = false;
+	uint8_t distances_[Size][Size];
+	/** Walkable tiles in the order they were reached, doubles as the search queue. */
+	std::vector<Point> tiles_;
+	std::vector<Point> obstacles_;
+};
+
+} // namespace devilution
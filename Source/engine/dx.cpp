@@ -5,6 +5,9 @@
  */
 #include "engine/dx.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include <SDL.h>
 
 #include "controls/plrctrls.h"
@@ -12,6 +15,7 @@
 #include "options.h"
 #include "utils/display.h"
 #include "utils/log.hpp"
+#include "utils/palette_blit.hpp"
 #include "utils/sdl_wrap.h"
 
 #ifndef USE_SDL1
@@ -81,6 +85,47 @@ void LimitFrameRate()
 	frameDeadline = tc + v + refreshDelay;
 }
 
+/** Maps `PalSurface` palette indices to output pixels, used by `BlitPalSurfaceFast`. */
+PaletteBlitTable PalSurfaceBlitTable;
+/** The `pal_surface_palette_version` that `PalSurfaceBlitTable` was built for. */
+unsigned int PalSurfaceBlitTableVersion = 0;
+/** The output pixel format masks that `PalSurfaceBlitTable` was built for. */
+Uint32 PalSurfaceBlitTableMasks[4] = {};
+
+void UpdatePalSurfaceBlitTable(const SDL_PixelFormat &format)
+{
+	const Uint32 masks[4] = { format.Rmask, format.Gmask, format.Bmask, format.Amask };
+	if (PalSurfaceBlitTableVersion == pal_surface_palette_version
+	    && std::equal(std::begin(masks), std::end(masks), std::begin(PalSurfaceBlitTableMasks)))
+		return;
+	BuildPaletteBlitTable(*PalSurface->format->palette, format, PalSurfaceBlitTable);
+	PalSurfaceBlitTableVersion = pal_surface_palette_version;
+	std::copy(std::begin(masks), std::end(masks), std::begin(PalSurfaceBlitTableMasks));
+}
+
+/**
+ * @brief Converts `PalSurface` to the output surface with our own vectorized blitter.
+ * @return Whether the blit was handled, `false` if the generic SDL path must be used instead.
+ */
+bool BlitPalSurfaceFast(SDL_Rect *srcRect, SDL_Rect *dstRect)
+{
+	SDL_Surface *dst = GetOutputSurface();
+	if (!CanBlitPaletteSurface32(*PalSurface, *dst))
+		return false;
+
+	unsigned factor = 1;
+	if (OutputRequiresScaling()) {
+		// Only whole number scaling, anything else is left to SDL.
+		if (dst->w % gnScreenWidth != 0 || dst->w / gnScreenWidth != dst->h / gnScreenHeight || dst->h % gnScreenHeight != 0)
+			return false;
+		factor = dst->w / gnScreenWidth;
+	}
+
+	UpdatePalSurfaceBlitTable(*dst->format);
+	BlitPaletteSurfaceScaled32(*PalSurface, srcRect, *dst, dstRect, factor, PalSurfaceBlitTable);
+	return true;
+}
+
 } // namespace
 
 void dx_init()
@@ -155,6 +200,8 @@ void BltFast(SDL_Rect *srcRect, SDL_Rect *dstRect)
 {
 	if (RenderDirectlyToOutputSurface)
 		return;
+	if (*sgOptions.Graphics.fastBlitter && !HeadlessMode && BlitPalSurfaceFast(srcRect, dstRect))
+		return;
 	Blit(PalSurface, srcRect, dstRect);
 }
 
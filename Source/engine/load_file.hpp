@@ -12,6 +12,7 @@
 #include "diablo.h"
 #include "engine/assets.hpp"
 #include "mpq/mpq_common.hpp"
+#include "utils/profiler.hpp"
 #include "utils/static_vector.hpp"
 #include "utils/stdcompat/cstddef.hpp"
 #include "utils/str_cat.hpp"
@@ -21,6 +22,7 @@ namespace devilution {
 template <typename T>
 void LoadFileInMem(const char *path, T *data)
 {
+	DVL_PROFILE_ZONE("LoadFileInMem");
 	size_t size;
 	AssetHandle handle = OpenAsset(path, size);
 	if (!ValidateHandle(path, handle))
@@ -33,6 +35,7 @@ void LoadFileInMem(const char *path, T *data)
 template <typename T>
 void LoadFileInMem(const char *path, T *data, std::size_t count)
 {
+	DVL_PROFILE_ZONE("LoadFileInMem");
 	AssetHandle handle = OpenAsset(path);
 	if (!ValidateHandle(path, handle))
 		return;
@@ -61,6 +64,7 @@ void LoadFileInMem(const char *path, std::array<T, N> &data)
 template <typename T = byte>
 std::unique_ptr<T[]> LoadFileInMem(const char *path, std::size_t *numRead = nullptr)
 {
+	DVL_PROFILE_ZONE("LoadFileInMem");
 	size_t size;
 	AssetHandle handle = OpenAsset(path, size);
 	if (!ValidateHandle(path, handle))
@@ -101,6 +105,7 @@ struct MultiFileLoader {
 	[[nodiscard]] std::unique_ptr<byte[]> operator()(size_t numFiles, PathFn &&pathFn, uint32_t *outOffsets,
 	    FilterFn filterFn = DefaultFilterFn {})
 	{
+		DVL_PROFILE_ZONE("MultiFileLoader");
 		StaticVector<std::array<char, MaxMpqPathSize>, MaxFiles> paths;
 		StaticVector<AssetRef, MaxFiles> files;
 		StaticVector<uint32_t, MaxFiles> sizes;
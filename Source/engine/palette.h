@@ -8,6 +8,7 @@
 #include <cstdint>
 
 #include "levels/gendung.h"
+#include "utils/attributes.h"
 
 namespace devilution {
 
@@ -35,7 +36,7 @@ extern SDL_Color logical_palette[256];
 extern SDL_Color system_palette[256];
 extern SDL_Color orig_palette[256];
 /** Lookup table for transparency */
-extern Uint8 paletteTransparencyLookup[256][256];
+extern DVL_API_FOR_TEST Uint8 paletteTransparencyLookup[256][256];
 
 #if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
 /**
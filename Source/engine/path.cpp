@@ -12,6 +12,7 @@
 #include "levels/gendung.h"
 #include "lighting.h"
 #include "objects.h"
+#include "utils/profiler.hpp"
 
 namespace devilution {
 namespace {
@@ -366,6 +367,7 @@ bool IsTileOccupied(Point position)
 
 int FindPath(tl::function_ref<bool(Point)> posOk, Point startPosition, Point destinationPosition, int8_t path[MaxPathLength])
 {
+	DVL_PROFILE_ZONE("FindPath");
 	/**
 	 * for reconstructing the path after the A* search is done. The longest
 	 * possible path is actually 24 steps, even though we can fit 25
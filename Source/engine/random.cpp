@@ -6,8 +6,8 @@
 
 namespace devilution {
 
-/** Current game seed */
-uint32_t sglGameSeed;
+/** Current game seed, per thread so that worker threads can roll without disturbing the game's stream */
+thread_local uint32_t sglGameSeed;
 
 /**
  * Specifies the increment used in the Borland C/C++ pseudo-random number generator algorithm.
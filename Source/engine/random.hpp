@@ -15,6 +15,8 @@ namespace devilution {
 
 /**
  * @brief Set the state of the RandomNumberEngine used by the base game to the specific seed
+ *
+ * Each thread has its own engine state.
  * @param seed New engine state
  */
 void SetRndSeed(uint32_t seed);
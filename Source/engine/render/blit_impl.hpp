@@ -4,8 +4,17 @@
 #include <cstring>
 
 #include "engine/palette.h"
+#include "engine/render/blit_simd.hpp"
 #include "utils/attributes.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DVL_BLIT_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DVL_BLIT_NEON
+#include <arm_neon.h>
+#endif
+
 namespace devilution {
 
 enum class BlitType : uint8_t {
@@ -23,12 +32,111 @@ struct BlitCommand {
 
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitFillDirect(uint8_t *dst, unsigned length, uint8_t color)
 {
-	std::memset(dst, color, length);
+	// Most runs are short, write them with (overlapping) vector stores instead of calling memset.
+#if defined(DVL_BLIT_SSE2)
+	if (length >= 16 && length <= 32) {
+		const __m128i pattern = _mm_set1_epi8(static_cast<char>(color));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), pattern);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + length - 16), pattern);
+		return;
+	}
+	if (length >= 8 && length < 16) {
+		const __m128i pattern = _mm_set1_epi8(static_cast<char>(color));
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(dst), pattern);
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(dst + length - 8), pattern);
+		return;
+	}
+#elif defined(DVL_BLIT_NEON)
+	if (length >= 16 && length <= 32) {
+		const uint8x16_t pattern = vdupq_n_u8(color);
+		vst1q_u8(dst, pattern);
+		vst1q_u8(dst + length - 16, pattern);
+		return;
+	}
+	if (length >= 8 && length < 16) {
+		const uint8x8_t pattern = vdup_n_u8(color);
+		vst1_u8(dst, pattern);
+		vst1_u8(dst + length - 8, pattern);
+		return;
+	}
+#else
+	if (length >= 8 && length <= 16) {
+		const uint64_t pattern = color * UINT64_C(0x0101010101010101);
+		std::memcpy(dst, &pattern, 8);
+		std::memcpy(dst + length - 8, &pattern, 8);
+		return;
+	}
+#endif
+	if (length >= 4 && length < 8) {
+		const uint32_t pattern = color * UINT32_C(0x01010101);
+		std::memcpy(dst, &pattern, 4);
+		std::memcpy(dst + length - 4, &pattern, 4);
+	} else if (length < 4) {
+		for (unsigned i = 0; i < length; ++i)
+			dst[i] = color;
+	} else {
+		std::memset(dst, color, length);
+	}
 }
 
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsDirect(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length)
 {
-	std::memcpy(dst, src, length);
+	// Most runs are short, copy them with (overlapping) vector loads and stores instead of calling memcpy.
+	// Both halves are loaded before storing, so this never reads past the end of `src`.
+#if defined(DVL_BLIT_SSE2)
+	if (length >= 16 && length <= 32) {
+		const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+		const __m128i last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + length - 16));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), first);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + length - 16), last);
+		return;
+	}
+	if (length >= 8 && length < 16) {
+		const __m128i first = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src));
+		const __m128i last = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + length - 8));
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(dst), first);
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(dst + length - 8), last);
+		return;
+	}
+#elif defined(DVL_BLIT_NEON)
+	if (length >= 16 && length <= 32) {
+		const uint8x16_t first = vld1q_u8(src);
+		const uint8x16_t last = vld1q_u8(src + length - 16);
+		vst1q_u8(dst, first);
+		vst1q_u8(dst + length - 16, last);
+		return;
+	}
+	if (length >= 8 && length < 16) {
+		const uint8x8_t first = vld1_u8(src);
+		const uint8x8_t last = vld1_u8(src + length - 8);
+		vst1_u8(dst, first);
+		vst1_u8(dst + length - 8, last);
+		return;
+	}
+#else
+	if (length >= 8 && length <= 16) {
+		uint64_t first;
+		uint64_t last;
+		std::memcpy(&first, src, 8);
+		std::memcpy(&last, src + length - 8, 8);
+		std::memcpy(dst, &first, 8);
+		std::memcpy(dst + length - 8, &last, 8);
+		return;
+	}
+#endif
+	if (length >= 4 && length < 8) {
+		uint32_t first;
+		uint32_t last;
+		std::memcpy(&first, src, 4);
+		std::memcpy(&last, src + length - 4, 4);
+		std::memcpy(dst, &first, 4);
+		std::memcpy(dst + length - 4, &last, 4);
+	} else if (length < 4) {
+		for (unsigned i = 0; i < length; ++i)
+			dst[i] = src[i];
+	} else {
+		std::memcpy(dst, src, length);
+	}
 }
 
 struct BlitDirect {
@@ -50,12 +158,11 @@ struct BlitDirect {
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitFillWithMap(uint8_t *dst, unsigned length, uint8_t color, const uint8_t *DVL_RESTRICT colorMap)
 {
 	assert(length != 0);
-	std::memset(dst, colorMap[color], length);
+	BlitFillDirect(dst, length, colorMap[color]);
 }
 
-DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithMap(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap)
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithMapScalar(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap)
 {
-	assert(length != 0);
 	const uint8_t *end = src + length;
 	while (src + 3 < end) {
 		*dst++ = colorMap[*src++];
@@ -68,9 +175,18 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithMap(uint8_t *DVL_RESTRICT
 	}
 }
 
-DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitFillBlended(uint8_t *dst, unsigned length, uint8_t color)
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithMap(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap)
 {
 	assert(length != 0);
+	if (length >= MinVectorBlitRunLength) {
+		VectorBlitRunKernels.pixelsWithMap(dst, src, length, colorMap);
+		return;
+	}
+	BlitPixelsWithMapScalar(dst, src, length, colorMap);
+}
+
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitFillBlendedScalar(uint8_t *dst, unsigned length, uint8_t color)
+{
 	const uint8_t *end = dst + length;
 	const uint8_t *tbl = paletteTransparencyLookup[color];
 	while (dst + 3 < end) {
@@ -89,6 +205,16 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitFillBlended(uint8_t *dst, unsigned
 	}
 }
 
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitFillBlended(uint8_t *dst, unsigned length, uint8_t color)
+{
+	assert(length != 0);
+	if (length >= MinVectorBlitRunLength) {
+		VectorBlitRunKernels.fillBlended(dst, length, color);
+		return;
+	}
+	BlitFillBlendedScalar(dst, length, color);
+}
+
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlended(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length)
 {
 	assert(length != 0);
@@ -127,9 +253,8 @@ struct BlitWithMap {
 	}
 };
 
-DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlendedWithMap(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap)
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlendedWithMapScalar(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap)
 {
-	assert(length != 0);
 	const uint8_t *end = src + length;
 	while (src + 3 < end) {
 		*dst = paletteTransparencyLookup[*dst][colorMap[*src++]];
@@ -147,6 +272,16 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlendedWithMap(uint8_t *DVL_R
 	}
 }
 
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlendedWithMap(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const uint8_t *DVL_RESTRICT colorMap)
+{
+	assert(length != 0);
+	if (length >= MinVectorBlitRunLength) {
+		VectorBlitRunKernels.pixelsBlendedWithMap(dst, src, length, colorMap);
+		return;
+	}
+	BlitPixelsBlendedWithMapScalar(dst, src, length, colorMap);
+}
+
 struct BlitBlendedWithMap {
 	const uint8_t *colorMap;
 
@@ -0,0 +1,234 @@
+#include "engine/render/blit_simd.hpp"
+
+#include <initializer_list>
+
+#include <SDL_cpuinfo.h>
+#include <SDL_version.h>
+
+#include "engine/render/blit_impl.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 4) && ((defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || defined(_M_X64))
+#define DVL_BLIT_RUN_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define DVL_BLIT_RUN_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DVL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DVL_TARGET_AVX2
+#endif
+
+namespace devilution {
+
+namespace {
+
+void PixelsWithMapScalar(uint8_t *dst, const uint8_t *src, unsigned length, const uint8_t *colorMap)
+{
+	BlitPixelsWithMapScalar(dst, src, length, colorMap);
+}
+
+void PixelsBlendedWithMapScalar(uint8_t *dst, const uint8_t *src, unsigned length, const uint8_t *colorMap)
+{
+	BlitPixelsBlendedWithMapScalar(dst, src, length, colorMap);
+}
+
+void FillBlendedScalar(uint8_t *dst, unsigned length, uint8_t color)
+{
+	BlitFillBlendedScalar(dst, length, color);
+}
+
+constexpr BlitRunKernels ScalarKernels { PixelsWithMapScalar, PixelsBlendedWithMapScalar, FillBlendedScalar };
+
+#ifdef DVL_BLIT_RUN_AVX2
+/**
+ * @brief Looks up `table[indices[i]]` for the 8 indices, each in a 32-bit lane.
+ *
+ * Gathers read 4 bytes, so indices of the last 3 entries are moved back and the wanted byte is shifted down instead.
+ * This keeps the reads inside the table.
+ */
+DVL_TARGET_AVX2 __m256i GatherBytesAVX2(const uint8_t *table, __m256i indices, int tableSize)
+{
+	const __m256i clamped = _mm256_min_epi32(indices, _mm256_set1_epi32(tableSize - 4));
+	const __m256i shift = _mm256_slli_epi32(_mm256_sub_epi32(indices, clamped), 3);
+	const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int *>(table), clamped, 1);
+	return _mm256_and_si256(_mm256_srlv_epi32(words, shift), _mm256_set1_epi32(0xFF));
+}
+
+/**
+ * @brief Narrows two vectors of bytes held in 32-bit lanes to 16 bytes.
+ */
+DVL_TARGET_AVX2 __m128i PackBytesAVX2(__m256i lo, __m256i hi)
+{
+	// `_mm256_packus_epi32` packs within each 128-bit half, the permute restores the order.
+	const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+	return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+DVL_TARGET_AVX2 void PixelsWithMapAVX2(uint8_t *dst, const uint8_t *src, unsigned length, const uint8_t *colorMap)
+{
+	for (; length >= 16; length -= 16, src += 16, dst += 16) {
+		const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+		const __m256i lo = GatherBytesAVX2(colorMap, _mm256_cvtepu8_epi32(indices), 256);
+		const __m256i hi = GatherBytesAVX2(colorMap, _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8)), 256);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), PackBytesAVX2(lo, hi));
+	}
+	if (length != 0)
+		BlitPixelsWithMapScalar(dst, src, length, colorMap);
+}
+
+DVL_TARGET_AVX2 void PixelsBlendedWithMapAVX2(uint8_t *dst, const uint8_t *src, unsigned length, const uint8_t *colorMap)
+{
+	const uint8_t *blend = &paletteTransparencyLookup[0][0];
+	for (; length >= 16; length -= 16, src += 16, dst += 16) {
+		const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+		const __m128i background = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst));
+		const __m256i colorsLo = GatherBytesAVX2(colorMap, _mm256_cvtepu8_epi32(indices), 256);
+		const __m256i colorsHi = GatherBytesAVX2(colorMap, _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8)), 256);
+		// `paletteTransparencyLookup[background][color]` is entry `background * 256 + color` of the whole table.
+		const __m256i blendLo = _mm256_or_si256(_mm256_slli_epi32(_mm256_cvtepu8_epi32(background), 8), colorsLo);
+		const __m256i blendHi = _mm256_or_si256(_mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(background, 8)), 8), colorsHi);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), PackBytesAVX2(GatherBytesAVX2(blend, blendLo, 256 * 256), GatherBytesAVX2(blend, blendHi, 256 * 256)));
+	}
+	if (length != 0)
+		BlitPixelsBlendedWithMapScalar(dst, src, length, colorMap);
+}
+
+DVL_TARGET_AVX2 void FillBlendedAVX2(uint8_t *dst, unsigned length, uint8_t color)
+{
+	const uint8_t *table = paletteTransparencyLookup[color];
+	for (; length >= 16; length -= 16, dst += 16) {
+		const __m128i background = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst));
+		const __m256i lo = GatherBytesAVX2(table, _mm256_cvtepu8_epi32(background), 256);
+		const __m256i hi = GatherBytesAVX2(table, _mm256_cvtepu8_epi32(_mm_srli_si128(background, 8)), 256);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), PackBytesAVX2(lo, hi));
+	}
+	if (length != 0)
+		BlitFillBlendedScalar(dst, length, color);
+}
+
+constexpr BlitRunKernels AVX2Kernels { PixelsWithMapAVX2, PixelsBlendedWithMapAVX2, FillBlendedAVX2 };
+#endif
+
+#ifdef DVL_BLIT_RUN_NEON
+/**
+ * @brief A 256-entry byte table held in registers.
+ */
+struct TableNEON {
+	uint8x16x4_t quarters[4];
+
+	explicit TableNEON(const uint8_t *table)
+	{
+		for (unsigned i = 0; i < 4; ++i) {
+			const uint8_t *quarter = table + 64 * i;
+			quarters[i] = { { vld1q_u8(quarter), vld1q_u8(quarter + 16), vld1q_u8(quarter + 32), vld1q_u8(quarter + 48) } };
+		}
+	}
+
+	uint8x16_t lookup(uint8x16_t indices) const
+	{
+		// `vqtbl4q_u8` covers 64 entries and yields 0 for larger indices.
+		// `vqtbx4q_u8` leaves the lanes with out-of-range indices untouched,
+		// so each subsequent quarter of the table only fills in its own lanes.
+		const uint8x16_t quarter = vdupq_n_u8(64);
+		uint8x16_t result = vqtbl4q_u8(quarters[0], indices);
+		for (unsigned i = 1; i < 4; ++i) {
+			indices = vsubq_u8(indices, quarter);
+			result = vqtbx4q_u8(result, quarters[i], indices);
+		}
+		return result;
+	}
+};
+
+void PixelsWithMapNEON(uint8_t *dst, const uint8_t *src, unsigned length, const uint8_t *colorMap)
+{
+	const TableNEON table { colorMap };
+	for (; length >= 16; length -= 16, src += 16, dst += 16)
+		vst1q_u8(dst, table.lookup(vld1q_u8(src)));
+	if (length != 0)
+		BlitPixelsWithMapScalar(dst, src, length, colorMap);
+}
+
+void PixelsBlendedWithMapNEON(uint8_t *dst, const uint8_t *src, unsigned length, const uint8_t *colorMap)
+{
+	// Only the color map fits into registers. NEON has no gather for the 64 KiB blending table,
+	// so the blend itself is looked up one pixel at a time.
+	const TableNEON table { colorMap };
+	uint8_t colors[16];
+	for (; length >= 16; length -= 16, src += 16) {
+		vst1q_u8(colors, table.lookup(vld1q_u8(src)));
+		for (const uint8_t color : colors) {
+			*dst = paletteTransparencyLookup[*dst][color];
+			++dst;
+		}
+	}
+	if (length != 0)
+		BlitPixelsBlendedWithMapScalar(dst, src, length, colorMap);
+}
+
+void FillBlendedNEON(uint8_t *dst, unsigned length, uint8_t color)
+{
+	const TableNEON table { paletteTransparencyLookup[color] };
+	for (; length >= 16; length -= 16, dst += 16)
+		vst1q_u8(dst, table.lookup(vld1q_u8(dst)));
+	if (length != 0)
+		BlitFillBlendedScalar(dst, length, color);
+}
+
+constexpr BlitRunKernels NEONKernels { PixelsWithMapNEON, PixelsBlendedWithMapNEON, FillBlendedNEON };
+#endif
+
+/**
+ * @return `nullptr` if this build or CPU doesn't support the kernel set
+ */
+const BlitRunKernels *GetBlitRunKernels(BlitRunKernelSet set)
+{
+	switch (set) {
+	case BlitRunKernelSet::Scalar:
+		return &ScalarKernels;
+	case BlitRunKernelSet::AVX2:
+#ifdef DVL_BLIT_RUN_AVX2
+		if (SDL_HasAVX2() == SDL_TRUE)
+			return &AVX2Kernels;
+#endif
+		return nullptr;
+	case BlitRunKernelSet::NEON:
+#ifdef DVL_BLIT_RUN_NEON
+		// NEON is a mandatory part of AArch64.
+		return &NEONKernels;
+#else
+		return nullptr;
+#endif
+	}
+	return nullptr;
+}
+
+} // namespace
+
+BlitRunKernelSet GetBestBlitRunKernelSet()
+{
+	// SSE2 has no gather, and emulating a 256-entry table with SSSE3 byte shuffles is slower than the scalar loops,
+	// so x86 without AVX2 keeps those.
+	for (const BlitRunKernelSet set : { BlitRunKernelSet::AVX2, BlitRunKernelSet::NEON }) {
+		if (GetBlitRunKernels(set) != nullptr)
+			return set;
+	}
+	return BlitRunKernelSet::Scalar;
+}
+
+BlitRunKernels VectorBlitRunKernels = *GetBlitRunKernels(GetBestBlitRunKernelSet());
+
+bool UseBlitRunKernelSet(BlitRunKernelSet set)
+{
+	const BlitRunKernels *kernels = GetBlitRunKernels(set);
+	if (kernels == nullptr)
+		return false;
+	VectorBlitRunKernels = *kernels;
+	return true;
+}
+
+} // namespace devilution
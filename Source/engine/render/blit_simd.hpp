@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+#include "utils/attributes.h"
+
+namespace devilution {
+
+/**
+ * @brief Runs shorter than this are blitted inline, the vector kernels only pay off for longer runs.
+ */
+constexpr unsigned MinVectorBlitRunLength = 32;
+
+/**
+ * @brief Out-of-line kernels for the blit runs that benefit from vectorization, see `blit_impl.hpp`.
+ */
+struct BlitRunKernels {
+	/** @brief `dst[i] = colorMap[src[i]]` */
+	void (*pixelsWithMap)(uint8_t *dst, const uint8_t *src, unsigned length, const uint8_t *colorMap);
+
+	/** @brief `dst[i] = paletteTransparencyLookup[dst[i]][colorMap[src[i]]]` */
+	void (*pixelsBlendedWithMap)(uint8_t *dst, const uint8_t *src, unsigned length, const uint8_t *colorMap);
+
+	/** @brief `dst[i] = paletteTransparencyLookup[color][dst[i]]` */
+	void (*fillBlended)(uint8_t *dst, unsigned length, uint8_t color);
+};
+
+enum class BlitRunKernelSet : uint8_t {
+	Scalar,
+	AVX2,
+	NEON,
+};
+
+/**
+ * @brief The kernels used for long runs.
+ *
+ * AVX2 when the CPU supports it, NEON on AArch64 and scalar elsewhere, picked at startup.
+ */
+extern DVL_API_FOR_TEST BlitRunKernels VectorBlitRunKernels;
+
+/**
+ * @brief The fastest kernel set supported by the CPU, the one `VectorBlitRunKernels` starts out with.
+ */
+BlitRunKernelSet GetBestBlitRunKernelSet();
+
+/**
+ * @brief Replaces `VectorBlitRunKernels` with the kernels of `set`, for tests and benchmarks.
+ * @return `false` if this build or CPU doesn't support the kernel set
+ */
+bool UseBlitRunKernelSet(BlitRunKernelSet set);
+
+} // namespace devilution
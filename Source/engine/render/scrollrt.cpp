@@ -5,6 +5,14 @@
  */
 #include "engine/render/scrollrt.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include "DiabloUI/ui_flags.hpp"
 #include "automap.h"
 #include "controls/plrctrls.h"
@@ -42,6 +50,7 @@
 #include "utils/display.h"
 #include "utils/endian.hpp"
 #include "utils/log.hpp"
+#include "utils/profiler.hpp"
 #include "utils/str_cat.hpp"
 
 #ifndef USE_SDL1
@@ -278,14 +287,93 @@ void DrawCursor(const Surface &out)
 	DrawSoftwareCursor(out, MousePosition + Displacement { 0, cursSize.height - 1 }, pcurs);
 }
 
+/**
+ * @brief How a queued draw command is rendered.
+ */
+enum class DrawCommandType : uint8_t {
+	/** @brief The static tile graphics of a cell, see `DrawCell`. */
+	Cell,
+	Sprite,
+	SpriteTRN,
+	SpriteBlendedTRN,
+	Outline,
+};
+
+/**
+ * @brief A draw command collected while walking the tiles in view.
+ */
+struct DrawCommand {
+	DrawCommandType type;
+	/** @brief Outline color, or the light table index of a cell. */
+	uint8_t color;
+	Point position;
+	Point tilePosition;
+	std::optional<ClxSprite> sprite;
+	/** @brief TRN or light table, resolved when the command was queued. */
+	const uint8_t *trn;
+};
+
+/**
+ * @brief Draw commands for the tile contents (walls, corpses, objects, items, actors and missiles) of the whole view.
+ *
+ * Commands are rendered in the order they were queued, which is the order the cells were visited in,
+ * so everything queued after a cell is drawn on top of it.
+ */
+struct DrawQueue {
+	std::vector<DrawCommand> commands;
+};
+
+DrawQueue SpriteQueue;
+
+void QueueCell(Point tilePosition, Point targetBufferPosition)
+{
+	SpriteQueue.commands.push_back({ DrawCommandType::Cell, static_cast<uint8_t>(LightTableIndex), targetBufferPosition, tilePosition, std::nullopt, nullptr });
+}
+
+void QueueSprite(Point position, ClxSprite sprite)
+{
+	SpriteQueue.commands.push_back({ DrawCommandType::Sprite, 0, position, {}, sprite, nullptr });
+}
+
+void QueueSpriteTRN(Point position, ClxSprite sprite, const uint8_t *trn)
+{
+	SpriteQueue.commands.push_back({ DrawCommandType::SpriteTRN, 0, position, {}, sprite, trn });
+}
+
+/**
+ * @brief Same as `ClxDrawLight`, using the current `LightTableIndex`
+ */
+void QueueSpriteLight(Point position, ClxSprite sprite)
+{
+	if (LightTableIndex != 0)
+		QueueSpriteTRN(position, sprite, &LightTables[LightTableIndex * 256]);
+	else
+		QueueSprite(position, sprite);
+}
+
+/**
+ * @brief Same as `ClxDrawLightBlended`, using the current `LightTableIndex`
+ */
+void QueueSpriteLightBlended(Point position, ClxSprite sprite)
+{
+	SpriteQueue.commands.push_back({ DrawCommandType::SpriteBlendedTRN, 0, position, {}, sprite, &LightTables[LightTableIndex * 256] });
+}
+
+/**
+ * @brief Same as `ClxDrawOutlineSkipColorZero`
+ */
+void QueueOutline(uint8_t col, Point position, ClxSprite sprite)
+{
+	SpriteQueue.commands.push_back({ DrawCommandType::Outline, col, position, {}, sprite, nullptr });
+}
+
 /**
  * @brief Render a missile sprite
- * @param out Output buffer
  * @param missile Pointer to Missile struct
  * @param targetBufferPosition Output buffer coordinate
  * @param pre Is the sprite in the background
  */
-void DrawMissilePrivate(const Surface &out, const Missile &missile, Point targetBufferPosition, bool pre)
+void DrawMissilePrivate(const Missile &missile, Point targetBufferPosition, bool pre)
 {
 	if (missile._miPreFlag != pre || !missile._miDrawFlag)
 		return;
@@ -293,46 +381,51 @@ void DrawMissilePrivate(const Surface &out, const Missile &missile, Point target
 	const Point missileRenderPosition { targetBufferPosition + missile.position.offsetForRendering - Displacement { missile._miAnimWidth2, 0 } };
 	const ClxSprite sprite = (*missile._miAnimData)[missile._miAnimFrame - 1];
 	if (missile._miUniqTrans != 0)
-		ClxDrawTRN(out, missileRenderPosition, sprite, Monsters[missile._misource].uniqueMonsterTRN.get());
+		QueueSpriteTRN(missileRenderPosition, sprite, Monsters[missile._misource].uniqueMonsterTRN.get());
 	else if (missile._miLightFlag)
-		ClxDrawLight(out, missileRenderPosition, sprite);
+		QueueSpriteLight(missileRenderPosition, sprite);
 	else
-		ClxDraw(out, missileRenderPosition, sprite);
+		QueueSprite(missileRenderPosition, sprite);
 }
 
 /**
  * @brief Render a missile sprites for a given tile
- * @param out Output buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
  */
-void DrawMissile(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
+void DrawMissile(Point tilePosition, Point targetBufferPosition, bool pre)
 {
 	const auto range = MissilesAtRenderingTile.equal_range(tilePosition);
 	for (auto it = range.first; it != range.second; it++) {
-		DrawMissilePrivate(out, *it->second, targetBufferPosition, pre);
+		DrawMissilePrivate(*it->second, targetBufferPosition, pre);
 	}
 }
 
+/**
+ * @brief The current frame of a monster, or its first standing frame while the animation it plays is still being loaded.
+ */
+OptionalClxSprite GetMonsterSprite(const Monster &monster)
+{
+	if (monster.animInfo.sprites)
+		return monster.animInfo.currentSprite();
+	const OptionalClxSpriteList standing = monster.type().getAnimData(MonsterGraphic::Stand).spritesForDirection(monster.direction);
+	if (!standing)
+		return std::nullopt;
+	return (*standing)[0];
+}
+
 /**
  * @brief Render a monster sprite
- * @param out Output buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param monster Monster reference
+ * @param sprite The frame to draw, see `GetMonsterSprite`
  */
-void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosition, const Monster &monster)
+void DrawMonster(Point tilePosition, Point targetBufferPosition, const Monster &monster, ClxSprite sprite)
 {
-	if (!monster.animInfo.sprites) {
-		Log("Draw Monster \"{}\": NULL Cel Buffer", monster.name());
-		return;
-	}
-
-	const ClxSprite sprite = monster.animInfo.currentSprite();
-
 	if (!IsTileLit(tilePosition)) {
-		ClxDrawTRN(out, targetBufferPosition, sprite, GetInfravisionTRN());
+		QueueSpriteTRN(targetBufferPosition, sprite, GetInfravisionTRN());
 		return;
 	}
 	uint8_t *trn = nullptr;
@@ -343,56 +436,54 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
 	if (MyPlayer->_pInfraFlag && LightTableIndex > 8)
 		trn = GetInfravisionTRN();
 	if (trn != nullptr)
-		ClxDrawTRN(out, targetBufferPosition, sprite, trn);
+		QueueSpriteTRN(targetBufferPosition, sprite, trn);
 	else
-		ClxDrawLight(out, targetBufferPosition, sprite);
+		QueueSpriteLight(targetBufferPosition, sprite);
 }
 
 /**
  * @brief Helper for rendering a specific player icon (Mana Shield or Reflect)
  */
-void DrawPlayerIconHelper(const Surface &out, MissileGraphicID missileGraphicId, Point position, bool lighting, bool infraVision)
+void DrawPlayerIconHelper(MissileGraphicID missileGraphicId, Point position, bool lighting, bool infraVision)
 {
 	position.x -= GetMissileSpriteData(missileGraphicId).animWidth2;
 
 	const ClxSprite sprite = (*GetMissileSpriteData(missileGraphicId).sprites).list()[0];
 
 	if (!lighting) {
-		ClxDraw(out, position, sprite);
+		QueueSprite(position, sprite);
 		return;
 	}
 
 	if (infraVision) {
-		ClxDrawTRN(out, position, sprite, GetInfravisionTRN());
+		QueueSpriteTRN(position, sprite, GetInfravisionTRN());
 		return;
 	}
 
-	ClxDrawLight(out, position, sprite);
+	QueueSpriteLight(position, sprite);
 }
 
 /**
  * @brief Helper for rendering player icons (Mana Shield and Reflect)
- * @param out Output buffer
  * @param player Player reference
  * @param position Output buffer coordinates
  * @param infraVision Should infravision be applied
  */
-void DrawPlayerIcons(const Surface &out, const Player &player, Point position, bool infraVision)
+void DrawPlayerIcons(const Player &player, Point position, bool infraVision)
 {
 	if (player.pManaShield)
-		DrawPlayerIconHelper(out, MissileGraphicID::ManaShield, position, &player != MyPlayer, infraVision);
+		DrawPlayerIconHelper(MissileGraphicID::ManaShield, position, &player != MyPlayer, infraVision);
 	if (player.wReflections > 0)
-		DrawPlayerIconHelper(out, MissileGraphicID::Reflect, position + Displacement { 0, 16 }, &player != MyPlayer, infraVision);
+		DrawPlayerIconHelper(MissileGraphicID::Reflect, position + Displacement { 0, 16 }, &player != MyPlayer, infraVision);
 }
 
 /**
  * @brief Render a player sprite
- * @param out Output buffer
  * @param player Player reference
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Point targetBufferPosition)
+void DrawPlayer(const Player &player, Point tilePosition, Point targetBufferPosition)
 {
 	if (!IsTileLit(tilePosition) && !MyPlayer->_pInfraFlag && !MyPlayer->isOnArenaLevel() && leveltype != DTYPE_TOWN) {
 		return;
@@ -403,17 +494,17 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
 	Point spriteBufferPosition = targetBufferPosition - Displacement { CalculateWidth2(sprite.width()), 0 };
 
 	if (static_cast<size_t>(pcursplr) < Players.size() && &player == &Players[pcursplr])
-		ClxDrawOutlineSkipColorZero(out, 165, spriteBufferPosition, sprite);
+		QueueOutline(165, spriteBufferPosition, sprite);
 
 	if (&player == MyPlayer) {
-		ClxDraw(out, spriteBufferPosition, sprite);
-		DrawPlayerIcons(out, player, targetBufferPosition, false);
+		QueueSprite(spriteBufferPosition, sprite);
+		DrawPlayerIcons(player, targetBufferPosition, false);
 		return;
 	}
 
 	if (!IsTileLit(tilePosition) || ((MyPlayer->_pInfraFlag || MyPlayer->isOnArenaLevel()) && LightTableIndex > 8)) {
-		ClxDrawTRN(out, spriteBufferPosition, sprite, GetInfravisionTRN());
-		DrawPlayerIcons(out, player, targetBufferPosition, true);
+		QueueSpriteTRN(spriteBufferPosition, sprite, GetInfravisionTRN());
+		DrawPlayerIcons(player, targetBufferPosition, true);
 		return;
 	}
 
@@ -423,19 +514,18 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
 	else
 		LightTableIndex -= 5;
 
-	ClxDrawLight(out, spriteBufferPosition, sprite);
-	DrawPlayerIcons(out, player, targetBufferPosition, false);
+	QueueSpriteLight(spriteBufferPosition, sprite);
+	DrawPlayerIcons(player, targetBufferPosition, false);
 
 	LightTableIndex = l;
 }
 
 /**
  * @brief Render a player sprite
- * @param out Output buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPosition)
+void DrawDeadPlayer(Point tilePosition, Point targetBufferPosition)
 {
 	dFlags[tilePosition.x][tilePosition.y] &= ~DungeonFlag::DeadPlayer;
 
@@ -443,19 +533,18 @@ void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPo
 		if (player.plractive && player._pHitPoints == 0 && player.isOnActiveLevel() && player.position.tile == tilePosition) {
 			dFlags[tilePosition.x][tilePosition.y] |= DungeonFlag::DeadPlayer;
 			const Point playerRenderPosition { targetBufferPosition };
-			DrawPlayer(out, player, tilePosition, playerRenderPosition);
+			DrawPlayer(player, tilePosition, playerRenderPosition);
 		}
 	}
 }
 
 /**
  * @brief Render an object sprite
- * @param out Output buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
  */
-void DrawObject(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
+void DrawObject(Point tilePosition, Point targetBufferPosition, bool pre)
 {
 	if (LightTableIndex >= LightsMax) {
 		return;
@@ -481,16 +570,146 @@ void DrawObject(const Surface &out, Point tilePosition, Point targetBufferPositi
 	}
 
 	if (&objectToDraw == ObjectUnderCursor) {
-		ClxDrawOutlineSkipColorZero(out, 194, screenPosition, sprite);
+		QueueOutline(194, screenPosition, sprite);
 	}
 	if (objectToDraw._oLight) {
-		ClxDrawLight(out, screenPosition, sprite);
+		QueueSpriteLight(screenPosition, sprite);
 	} else {
-		ClxDraw(out, screenPosition, sprite);
+		QueueSprite(screenPosition, sprite);
+	}
+}
+
+static void DrawDungeon(Point /*tilePosition*/, Point /*targetBufferPosition*/);
+
+/**
+ * @brief How the micros of a dungeon piece are masked, for one transparency state of its room.
+ */
+struct PieceMasks {
+	/** @brief Masks of the bottom left and right micros. */
+	MaskType first[2];
+	/** @brief Whether the bottom left and right micros are drawn. Only `TransparentSquare` micros are drawn as foliage. */
+	bool drawFirst[2];
+	/** @brief Mask of the micros above the bottom ones. */
+	MaskType upper;
+};
+
+/**
+ * @brief Transparency masks of the current level.
+ *
+ * The masks of each piece only depend on the level layout and the transparent rooms only change
+ * when `TransList` does, so neither has to be worked out again for every tile in every frame.
+ */
+struct TransparencyMasks {
+	/** @brief Masks of each dungeon piece when its room is opaque ([0]) and when it is transparent ([1]). */
+	PieceMasks pieces[MAXTILES][2];
+	/** @brief Tiles that belong to a room that is currently transparent. */
+	Bitset2d<MAXDUNX, MAXDUNY> transparentRooms;
+	std::optional<uint32_t> layoutVersion;
+	std::optional<uint32_t> transListVersion;
+};
+
+TransparencyMasks LevelMasks;
+
+MaskType GetFirstTileMaskLeft(uint16_t levelPieceId, TileType tile, bool transparency, bool foliage)
+{
+	if (transparency) {
+		switch (tile) {
+		case TileType::LeftTrapezoid:
+		case TileType::TransparentSquare:
+			return TileHasAny(levelPieceId, TileProperties::TransparentLeft)
+			    ? MaskType::Left
+			    : MaskType::Solid;
+		case TileType::LeftTriangle:
+			return MaskType::Solid;
+		default:
+			return MaskType::Transparent;
+		}
+	}
+	if (foliage)
+		return MaskType::LeftFoliage;
+	return MaskType::Solid;
+}
+
+MaskType GetFirstTileMaskRight(uint16_t levelPieceId, TileType tile, bool transparency, bool foliage)
+{
+	if (transparency) {
+		switch (tile) {
+		case TileType::RightTrapezoid:
+		case TileType::TransparentSquare:
+			return TileHasAny(levelPieceId, TileProperties::TransparentRight)
+			    ? MaskType::Right
+			    : MaskType::Solid;
+		case TileType::RightTriangle:
+			return MaskType::Solid;
+		default:
+			return MaskType::Transparent;
+		}
+	}
+	if (foliage)
+		return MaskType::RightFoliage;
+	return MaskType::Solid;
+}
+
+PieceMasks BuildPieceMasks(uint16_t levelPieceId, bool transparentRoom)
+{
+	const MICROS &micros = DPieceMicros[levelPieceId];
+	const bool transparency = transparentRoom && TileHasAny(levelPieceId, TileProperties::Transparent);
+	const bool foliage = !TileHasAny(levelPieceId, TileProperties::Solid);
+
+	PieceMasks masks;
+	{
+		const LevelCelBlock levelCelBlock { micros.mt[0] };
+		const TileType tileType = levelCelBlock.type();
+		masks.first[0] = GetFirstTileMaskLeft(levelPieceId, tileType, transparency, foliage);
+		masks.drawFirst[0] = masks.first[0] != MaskType::LeftFoliage || tileType == TileType::TransparentSquare;
+	}
+	{
+		const LevelCelBlock levelCelBlock { micros.mt[1] };
+		const TileType tileType = levelCelBlock.type();
+		masks.first[1] = GetFirstTileMaskRight(levelPieceId, tileType, transparency, foliage);
+		masks.drawFirst[1] = (transparency || !foliage || tileType == TileType::TransparentSquare)
+		    && (masks.first[1] != MaskType::RightFoliage || tileType == TileType::TransparentSquare);
+	}
+	masks.upper = transparency ? MaskType::Transparent : MaskType::Solid;
+	return masks;
+}
+
+/**
+ * @brief Rebuilds the transparency masks that are out of date.
+ */
+void UpdateTransparencyMasks()
+{
+	TransparencyMasks &masks = LevelMasks;
+	const bool layoutChanged = masks.layoutVersion != DungeonLayoutVersion;
+	if (layoutChanged) {
+		for (uint16_t levelPieceId = 0; levelPieceId < MAXTILES; levelPieceId++) {
+			masks.pieces[levelPieceId][0] = BuildPieceMasks(levelPieceId, false);
+			masks.pieces[levelPieceId][1] = BuildPieceMasks(levelPieceId, true);
+		}
+		masks.layoutVersion = DungeonLayoutVersion;
+	}
+
+	if (layoutChanged || masks.transListVersion != TransListVersion) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			for (int y = 0; y < MAXDUNY; y++)
+				masks.transparentRooms.set(x, y, TransList[static_cast<uint8_t>(dTransVal[x][y])]);
+		}
+		masks.transListVersion = TransListVersion;
 	}
 }
 
-static void DrawDungeon(const Surface & /*out*/, Point /*tilePosition*/, Point /*targetBufferPosition*/);
+/**
+ * @brief Whether the room of a tile is drawn transparent.
+ */
+bool IsRoomTransparent(Point tilePosition)
+{
+#ifdef _DEBUG
+	// Turn transparency off here for debugging
+	if ((SDL_GetModState() & KMOD_ALT) != 0)
+		return false;
+#endif
+	return LevelMasks.transparentRooms.test(tilePosition.x, tilePosition.y);
+}
 
 /**
  * @brief Render a cell
@@ -502,77 +721,22 @@ void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition
 {
 	const uint16_t levelPieceId = dPiece[tilePosition.x][tilePosition.y];
 	const MICROS *pMap = &DPieceMicros[levelPieceId];
-
-	bool transparency = TileHasAny(levelPieceId, TileProperties::Transparent) && TransList[dTransVal[tilePosition.x][tilePosition.y]];
-#ifdef _DEBUG
-	if ((SDL_GetModState() & KMOD_ALT) != 0)
-		transparency = false;
-#endif
-	const bool foliage = !TileHasAny(levelPieceId, TileProperties::Solid);
-
-	const auto getFirstTileMaskLeft = [=](TileType tile) -> MaskType {
-		if (transparency) {
-			switch (tile) {
-			case TileType::LeftTrapezoid:
-			case TileType::TransparentSquare:
-				return TileHasAny(levelPieceId, TileProperties::TransparentLeft)
-				    ? MaskType::Left
-				    : MaskType::Solid;
-			case TileType::LeftTriangle:
-				return MaskType::Solid;
-			default:
-				return MaskType::Transparent;
-			}
-		}
-		if (foliage)
-			return MaskType::LeftFoliage;
-		return MaskType::Solid;
-	};
-
-	const auto getFirstTileMaskRight = [=](TileType tile) -> MaskType {
-		if (transparency) {
-			switch (tile) {
-			case TileType::RightTrapezoid:
-			case TileType::TransparentSquare:
-				return TileHasAny(levelPieceId, TileProperties::TransparentRight)
-				    ? MaskType::Right
-				    : MaskType::Solid;
-			case TileType::RightTriangle:
-				return MaskType::Solid;
-			default:
-				return MaskType::Transparent;
-			}
-		}
-		if (foliage)
-			return MaskType::RightFoliage;
-		return MaskType::Solid;
-	};
+	const PieceMasks &masks = LevelMasks.pieces[levelPieceId][IsRoomTransparent(tilePosition) ? 1 : 0];
 
 	// The first micro tile may be rendered with a foliage mask.
-	// Only `TransparentSquare` tiles are rendered when `foliage` is true.
 	{
 		{
 			const LevelCelBlock levelCelBlock { pMap->mt[0] };
-			const TileType tileType = levelCelBlock.type();
-			const MaskType maskType = getFirstTileMaskLeft(tileType);
-			if (levelCelBlock.hasValue()) {
-				if (maskType != MaskType::LeftFoliage || tileType == TileType::TransparentSquare) {
-					RenderTile(out, targetBufferPosition,
-					    levelCelBlock, maskType, LightTableIndex);
-				}
+			if (levelCelBlock.hasValue() && masks.drawFirst[0]) {
+				RenderTile(out, targetBufferPosition,
+				    levelCelBlock, masks.first[0], LightTableIndex);
 			}
 		}
 		{
 			const LevelCelBlock levelCelBlock { pMap->mt[1] };
-			const TileType tileType = levelCelBlock.type();
-			const MaskType maskType = getFirstTileMaskRight(tileType);
-			if (levelCelBlock.hasValue()) {
-				if (transparency || !foliage || levelCelBlock.type() == TileType::TransparentSquare) {
-					if (maskType != MaskType::RightFoliage || tileType == TileType::TransparentSquare) {
-						RenderTile(out, targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
-						    levelCelBlock, maskType, LightTableIndex);
-					}
-				}
+			if (levelCelBlock.hasValue() && masks.drawFirst[1]) {
+				RenderTile(out, targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
+				    levelCelBlock, masks.first[1], LightTableIndex);
 			}
 		}
 		targetBufferPosition.y -= TILE_HEIGHT;
@@ -583,57 +747,27 @@ void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition
 			const LevelCelBlock levelCelBlock { pMap->mt[i] };
 			if (levelCelBlock.hasValue()) {
 				RenderTile(out, targetBufferPosition,
-				    levelCelBlock,
-				    transparency ? MaskType::Transparent : MaskType::Solid, LightTableIndex);
+				    levelCelBlock, masks.upper, LightTableIndex);
 			}
 		}
 		{
 			const LevelCelBlock levelCelBlock { pMap->mt[i + 1] };
 			if (levelCelBlock.hasValue()) {
 				RenderTile(out, targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
-				    levelCelBlock,
-				    transparency ? MaskType::Transparent : MaskType::Solid, LightTableIndex);
+				    levelCelBlock, masks.upper, LightTableIndex);
 			}
 		}
 		targetBufferPosition.y -= TILE_HEIGHT;
 	}
 }
 
-/**
- * @brief Render a floor tile.
- * @param out Target buffer
- * @param tilePosition dPiece coordinates
- * @param targetBufferPosition Target buffer coordinate
- */
-void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPosition)
-{
-	LightTableIndex = dLight[tilePosition.x][tilePosition.y];
-
-	const uint16_t levelPieceId = dPiece[tilePosition.x][tilePosition.y];
-	{
-		const LevelCelBlock levelCelBlock { DPieceMicros[levelPieceId].mt[0] };
-		if (levelCelBlock.hasValue()) {
-			RenderTile(out, targetBufferPosition,
-			    levelCelBlock, MaskType::Solid, LightTableIndex);
-		}
-	}
-	{
-		const LevelCelBlock levelCelBlock { DPieceMicros[levelPieceId].mt[1] };
-		if (levelCelBlock.hasValue()) {
-			RenderTile(out, targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
-			    levelCelBlock, MaskType::Solid, LightTableIndex);
-		}
-	}
-}
-
 /**
  * @brief Draw item for a given tile
- * @param out Output buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
  */
-void DrawItem(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
+void DrawItem(Point tilePosition, Point targetBufferPosition, bool pre)
 {
 	int8_t bItem = dItem[tilePosition.x][tilePosition.y];
 
@@ -648,20 +782,19 @@ void DrawItem(const Surface &out, Point tilePosition, Point targetBufferPosition
 	int px = targetBufferPosition.x - CalculateWidth2(sprite.width());
 	const Point position { px, targetBufferPosition.y };
 	if (stextflag == TalkID::None && (bItem - 1 == pcursitem || AutoMapShowItems)) {
-		ClxDrawOutlineSkipColorZero(out, GetOutlineColor(item, false), position, sprite);
+		QueueOutline(GetOutlineColor(item, false), position, sprite);
 	}
-	ClxDrawLight(out, position, sprite);
+	QueueSpriteLight(position, sprite);
 	if (item.AnimInfo.isLastFrame() || item._iCurs == ICURS_MAGIC_ROCK)
 		AddItemToLabelQueue(bItem - 1, position);
 }
 
 /**
  * @brief Check if and how a monster should be rendered
- * @param out Output buffer
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBufferPosition)
+void DrawMonsterHelper(Point tilePosition, Point targetBufferPosition)
 {
 	int mi = dMonster[tilePosition.x][tilePosition.y];
 	bool isNegativeMonster = mi < 0;
@@ -675,9 +808,9 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 		const Point position { px, targetBufferPosition.y };
 		const ClxSprite sprite = towner.currentSprite();
 		if (mi == pcursmonst) {
-			ClxDrawOutlineSkipColorZero(out, 166, position, sprite);
+			QueueOutline(166, position, sprite);
 		}
-		ClxDraw(out, position, sprite);
+		QueueSprite(position, sprite);
 		return;
 	}
 
@@ -694,7 +827,12 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 		return;
 	}
 
-	const ClxSprite sprite = monster.animInfo.currentSprite();
+	const OptionalClxSprite monsterSprite = GetMonsterSprite(monster);
+	if (!monsterSprite) {
+		Log("Draw Monster \"{}\": NULL Cel Buffer", monster.name());
+		return;
+	}
+	const ClxSprite sprite = *monsterSprite;
 
 	Displacement offset = {};
 	if (monster.isWalking()) {
@@ -712,19 +850,18 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 
 	const Point monsterRenderPosition { targetBufferPosition + offset - Displacement { CalculateWidth2(sprite.width()), 0 } };
 	if (mi == pcursmonst) {
-		ClxDrawOutlineSkipColorZero(out, 233, monsterRenderPosition, sprite);
+		QueueOutline(233, monsterRenderPosition, sprite);
 	}
-	DrawMonster(out, tilePosition, monsterRenderPosition, monster);
+	DrawMonster(tilePosition, monsterRenderPosition, monster, sprite);
 }
 
 /**
  * @brief Check if and how a player should be rendered
- * @param out Output buffer
  * @param player Player reference
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawPlayerHelper(const Surface &out, const Player &player, Point tilePosition, Point targetBufferPosition)
+void DrawPlayerHelper(const Player &player, Point tilePosition, Point targetBufferPosition)
 {
 	Displacement offset = {};
 	if (player.isWalking()) {
@@ -733,16 +870,15 @@ void DrawPlayerHelper(const Surface &out, const Player &player, Point tilePositi
 
 	const Point playerRenderPosition { targetBufferPosition + offset };
 
-	DrawPlayer(out, player, tilePosition, playerRenderPosition);
+	DrawPlayer(player, tilePosition, playerRenderPosition);
 }
 
 /**
- * @brief Render object sprites
- * @param out Target buffer
+ * @brief Queue the cell and the sprites of a tile for rendering
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
  */
-void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosition)
+void DrawDungeon(Point tilePosition, Point targetBufferPosition)
 {
 	assert(InDungeonBounds(tilePosition));
 
@@ -752,19 +888,18 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 
 	LightTableIndex = dLight[tilePosition.x][tilePosition.y];
 
-	DrawCell(out, tilePosition, targetBufferPosition);
+	QueueCell(tilePosition, targetBufferPosition);
 
 	int8_t bDead = dCorpse[tilePosition.x][tilePosition.y];
-	int8_t bMap = dTransVal[tilePosition.x][tilePosition.y];
 
 #ifdef _DEBUG
 	if (DebugVision && IsTileLit(tilePosition)) {
-		ClxDraw(out, targetBufferPosition, (*pSquareCel)[0]);
+		QueueSprite(targetBufferPosition, (*pSquareCel)[0]);
 	}
 #endif
 
 	if (MissilePreFlag) {
-		DrawMissile(out, tilePosition, targetBufferPosition, true);
+		DrawMissile(tilePosition, targetBufferPosition, true);
 	}
 
 	if (LightTableIndex < LightsMax && bDead != 0) {
@@ -774,41 +909,36 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 			const ClxSprite sprite = corpse.spritesForDirection(static_cast<Direction>((bDead >> 5) & 7))[corpse.frame];
 			if (corpse.translationPaletteIndex != 0) {
 				const uint8_t *trn = Monsters[corpse.translationPaletteIndex - 1].uniqueMonsterTRN.get();
-				ClxDrawTRN(out, position, sprite, trn);
+				QueueSpriteTRN(position, sprite, trn);
 			} else {
-				ClxDrawLight(out, position, sprite);
+				QueueSpriteLight(position, sprite);
 			}
 		} while (false);
 	}
-	DrawObject(out, tilePosition, targetBufferPosition, true);
-	DrawItem(out, tilePosition, targetBufferPosition, true);
+	DrawObject(tilePosition, targetBufferPosition, true);
+	DrawItem(tilePosition, targetBufferPosition, true);
 
 	if (TileContainsDeadPlayer(tilePosition)) {
-		DrawDeadPlayer(out, tilePosition, targetBufferPosition);
+		DrawDeadPlayer(tilePosition, targetBufferPosition);
 	}
 	int8_t playerId = dPlayer[tilePosition.x][tilePosition.y];
 	if (static_cast<size_t>(playerId - 1) < Players.size()) {
-		DrawPlayerHelper(out, Players[playerId - 1], tilePosition, targetBufferPosition);
+		DrawPlayerHelper(Players[playerId - 1], tilePosition, targetBufferPosition);
 	}
 	if (dMonster[tilePosition.x][tilePosition.y] != 0) {
-		DrawMonsterHelper(out, tilePosition, targetBufferPosition);
+		DrawMonsterHelper(tilePosition, targetBufferPosition);
 	}
-	DrawMissile(out, tilePosition, targetBufferPosition, false);
-	DrawObject(out, tilePosition, targetBufferPosition, false);
-	DrawItem(out, tilePosition, targetBufferPosition, false);
+	DrawMissile(tilePosition, targetBufferPosition, false);
+	DrawObject(tilePosition, targetBufferPosition, false);
+	DrawItem(tilePosition, targetBufferPosition, false);
 
 	if (leveltype != DTYPE_TOWN) {
 		char bArch = dSpecial[tilePosition.x][tilePosition.y];
 		if (bArch != 0) {
-			bool transparency = TransList[bMap];
-#ifdef _DEBUG
-			// Turn transparency off here for debugging
-			transparency = transparency && (SDL_GetModState() & KMOD_ALT) == 0;
-#endif
-			if (transparency) {
-				ClxDrawLightBlended(out, targetBufferPosition, (*pSpecialCels)[bArch - 1]);
+			if (IsRoomTransparent(tilePosition)) {
+				QueueSpriteLightBlended(targetBufferPosition, (*pSpecialCels)[bArch - 1]);
 			} else {
-				ClxDrawLight(out, targetBufferPosition, (*pSpecialCels)[bArch - 1]);
+				QueueSpriteLight(targetBufferPosition, (*pSpecialCels)[bArch - 1]);
 			}
 		}
 	} else {
@@ -818,49 +948,361 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 		if (tilePosition.x > 0 && tilePosition.y > 0 && targetBufferPosition.y > TILE_HEIGHT) {
 			char bArch = dSpecial[tilePosition.x - 1][tilePosition.y - 1];
 			if (bArch != 0) {
-				ClxDraw(out, targetBufferPosition + Displacement { 0, -TILE_HEIGHT }, (*pSpecialCels)[bArch - 1]);
+				QueueSprite(targetBufferPosition + Displacement { 0, -TILE_HEIGHT }, (*pSpecialCels)[bArch - 1]);
 			}
 		}
 	}
 }
 
 /**
- * @brief Render a row of tiles
- * @param out Buffer to render to
- * @param tilePosition dPiece coordinates
- * @param targetBufferPosition Target buffer coordinates
+ * @brief Render the queued draw commands
+ * @param out Target buffer
+ */
+void FlushDrawQueue(const Surface &out)
+{
+	for (const DrawCommand &command : SpriteQueue.commands) {
+		switch (command.type) {
+		case DrawCommandType::Cell:
+			LightTableIndex = command.color;
+			DrawCell(out, command.tilePosition, command.position);
+			break;
+		case DrawCommandType::Sprite:
+			ClxDraw(out, command.position, *command.sprite);
+			break;
+		case DrawCommandType::SpriteTRN:
+			ClxDrawTRN(out, command.position, *command.sprite, command.trn);
+			break;
+		case DrawCommandType::SpriteBlendedTRN:
+			ClxDrawBlendedTRN(out, command.position, *command.sprite, command.trn);
+			break;
+		case DrawCommandType::Outline:
+			ClxDrawOutlineSkipColorZero(out, command.color, command.position, *command.sprite);
+			break;
+		}
+	}
+
+	SpriteQueue.commands.clear();
+}
+
+/**
+ * @brief A floor micro tile to render, relative to the first tile of the view.
+ */
+struct FloorDrawCommand {
+	Point tilePosition;
+	Displacement offset;
+	LevelCelBlock levelCelBlock;
+	uint8_t lightTableIndex;
+	/** @brief The tile is outside of the dungeon and is drawn black instead. */
+	bool blackTile;
+};
+
+/**
+ * @brief A tile to visit while rendering the tile contents, relative to the first tile of the view.
+ */
+struct CellVisit {
+	Point tilePosition;
+	Displacement offset;
+	/** @brief The tile is part of a wall with walkable area behind it, so the tile east of it must be drawn first. */
+	bool drawEastFirst;
+};
+
+/**
+ * @brief Identifies the part of the dungeon covered by a cached draw list.
+ */
+struct DrawListKey {
+	Point firstTile;
+	int rows;
+	int columns;
+	uint32_t layoutVersion;
+	uint32_t lightingVersion;
+
+	bool operator==(const DrawListKey &other) const
+	{
+		return firstTile == other.firstTile && rows == other.rows && columns == other.columns
+		    && layoutVersion == other.layoutVersion && lightingVersion == other.lightingVersion;
+	}
+
+	bool operator!=(const DrawListKey &other) const
+	{
+		return !(*this == other);
+	}
+};
+
+/**
+ * @brief Draw commands for the static dungeon geometry in view.
+ *
+ * The lists only depend on the first tile of the view, so they are reused while the
+ * camera moves within a tile and are only rebuilt when it crosses into another tile
+ * or when the level layout or lighting changes.
+ */
+struct StaticDrawLists {
+	std::optional<DrawListKey> floorKey;
+	std::vector<FloorDrawCommand> floor;
+	std::optional<DrawListKey> cellsKey;
+	std::vector<CellVisit> cells;
+};
+
+StaticDrawLists DrawLists;
+
+/**
+ * @brief Walks the diamond shaped rows of tiles in view, as they are laid out on screen.
+ * @param tilePosition dPiece coordinates of the first tile
  * @param rows Number of rows
  * @param columns Tile in a row
+ * @param visit Called with the tile position and its offset from the first tile
  */
-void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+template <typename F>
+void ForEachTileInView(Point tilePosition, int rows, int columns, F &&visit)
 {
+	Displacement offset {};
 	for (int i = 0; i < rows; i++) {
 		for (int j = 0; j < columns; j++) {
-			if (InDungeonBounds(tilePosition)) {
-				if (!TileHasAny(dPiece[tilePosition.x][tilePosition.y], TileProperties::Solid))
-					DrawFloor(out, tilePosition, targetBufferPosition);
-			} else {
-				world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
-			}
+			visit(tilePosition, offset);
 			tilePosition += Direction::East;
-			targetBufferPosition.x += TILE_WIDTH;
+			offset.deltaX += TILE_WIDTH;
 		}
 		// Return to start of row
 		tilePosition += Displacement(Direction::West) * columns;
-		targetBufferPosition.x -= columns * TILE_WIDTH;
+		offset.deltaX -= columns * TILE_WIDTH;
 
 		// Jump to next row
-		targetBufferPosition.y += TILE_HEIGHT / 2;
+		offset.deltaY += TILE_HEIGHT / 2;
 		if ((i & 1) != 0) {
 			tilePosition.x++;
 			columns--;
-			targetBufferPosition.x += TILE_WIDTH / 2;
+			offset.deltaX += TILE_WIDTH / 2;
 		} else {
 			tilePosition.y++;
 			columns++;
-			targetBufferPosition.x -= TILE_WIDTH / 2;
+			offset.deltaX -= TILE_WIDTH / 2;
+		}
+	}
+}
+
+void BuildFloorDrawList(Point tilePosition, int rows, int columns)
+{
+	std::vector<FloorDrawCommand> &commands = DrawLists.floor;
+	commands.clear();
+	ForEachTileInView(tilePosition, rows, columns, [&commands](Point position, Displacement offset) {
+		if (!InDungeonBounds(position)) {
+			commands.push_back({ position, offset, LevelCelBlock { 0 }, 0, true });
+			return;
 		}
+		const uint16_t levelPieceId = dPiece[position.x][position.y];
+		if (TileHasAny(levelPieceId, TileProperties::Solid))
+			return;
+		const uint8_t lightTableIndex = dLight[position.x][position.y];
+		const LevelCelBlock left { DPieceMicros[levelPieceId].mt[0] };
+		if (left.hasValue())
+			commands.push_back({ position, offset, left, lightTableIndex, false });
+		const LevelCelBlock right { DPieceMicros[levelPieceId].mt[1] };
+		if (right.hasValue())
+			commands.push_back({ position, offset + Displacement { TILE_WIDTH / 2, 0 }, right, lightTableIndex, false });
+	});
+}
+
+/**
+ * @brief Render the floor tiles in view
+ * @param out Buffer to render to
+ * @param tilePosition dPiece coordinates
+ * @param targetBufferPosition Target buffer coordinates
+ * @param rows Number of rows
+ * @param columns Tile in a row
+ */
+void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+{
+	const DrawListKey key { tilePosition, rows, columns, DungeonLayoutVersion, LightingVersion };
+	if (DrawLists.floorKey != key) {
+		BuildFloorDrawList(tilePosition, rows, columns);
+		DrawLists.floorKey = key;
+	}
+
+	for (const FloorDrawCommand &command : DrawLists.floor) {
+		const Point position = targetBufferPosition + command.offset;
+		if (command.blackTile) {
+			world_draw_black_tile(out, position.x, position.y);
+			continue;
+		}
+		LightTableIndex = command.lightTableIndex;
+		RenderTile(out, position, command.levelCelBlock, MaskType::Solid, LightTableIndex);
+	}
+}
+
+/**
+ * @brief Offscreen copy of the floor layer that scrolls along with the view, so that only the
+ * newly exposed areas and the tiles whose lighting changed have to be rendered again.
+ */
+struct FloorCache {
+	std::optional<OwnedSurface> surface;
+	/** @brief Position of the top left corner of the cache in dungeon pixel coordinates. */
+	Point origin;
+	uint32_t layoutVersion;
+	uint32_t lightTablesVersion;
+	/** @brief Light table index each tile in view was last rendered with. */
+	uint8_t tileLight[MAXDUNX][MAXDUNY];
+};
+
+FloorCache CachedFloor;
+
+/**
+ * @brief An area of the floor cache that needs to be rendered again, in pixels.
+ */
+struct FloorCacheArea {
+	int left;
+	int top;
+	int right;
+	int bottom;
+
+	[[nodiscard]] bool empty() const
+	{
+		return left >= right || top >= bottom;
+	}
+
+	void merge(const FloorCacheArea &other)
+	{
+		if (empty()) {
+			*this = other;
+			return;
+		}
+		left = std::min(left, other.left);
+		top = std::min(top, other.top);
+		right = std::max(right, other.right);
+		bottom = std::max(bottom, other.bottom);
 	}
+};
+
+/**
+ * @brief Position of a tile in dungeon pixel coordinates, using the same layout as `ForEachTileInView`.
+ */
+Point TileToDungeonPixels(Point tilePosition)
+{
+	return { (tilePosition.x - tilePosition.y) * TILE_WIDTH / 2, (tilePosition.x + tilePosition.y) * TILE_HEIGHT / 2 };
+}
+
+FloorCacheArea GetFloorCommandArea(const FloorDrawCommand &command, Point targetBufferPosition)
+{
+	const Point position = targetBufferPosition + command.offset;
+	const int width = command.blackTile ? TILE_WIDTH : TILE_WIDTH / 2;
+	return { position.x, position.y - TILE_HEIGHT + 1, position.x + width, position.y + 1 };
+}
+
+/**
+ * @brief Moves the contents of a buffer, leaving the uncovered pixels as they were.
+ */
+void ShiftSurface(const Surface &surface, Displacement shift)
+{
+	const int width = surface.w() - std::abs(shift.deltaX);
+	const int height = surface.h() - std::abs(shift.deltaY);
+	const int srcX = std::max(-shift.deltaX, 0);
+	const int dstX = std::max(shift.deltaX, 0);
+	for (int i = 0; i < height; i++) {
+		// Walk against the direction of the shift so that source rows are read before they are overwritten
+		const int dstY = shift.deltaY > 0 ? surface.h() - 1 - i : i;
+		std::memmove(surface.at(dstX, dstY), surface.at(srcX, dstY - shift.deltaY), width);
+	}
+}
+
+/**
+ * @brief Renders the floor commands overlapping the given area of the floor cache.
+ */
+void RenderFloorCacheArea(const Surface &cache, Point targetBufferPosition, FloorCacheArea area)
+{
+	area.left = std::max(area.left, 0);
+	area.top = std::max(area.top, 0);
+	area.right = std::min(area.right, cache.w());
+	area.bottom = std::min(area.bottom, cache.h());
+	if (area.empty())
+		return;
+
+	const Surface region = cache.subregion(area.left, area.top, area.right - area.left, area.bottom - area.top);
+	for (int y = 0; y < region.h(); y++)
+		std::memset(region.at(0, y), 0, region.w());
+
+	const Displacement toRegion { -area.left, -area.top };
+	for (const FloorDrawCommand &command : DrawLists.floor) {
+		const FloorCacheArea commandArea = GetFloorCommandArea(command, targetBufferPosition);
+		if (commandArea.right <= area.left || commandArea.left >= area.right || commandArea.bottom <= area.top || commandArea.top >= area.bottom)
+			continue;
+		const Point position = targetBufferPosition + command.offset + toRegion;
+		if (command.blackTile) {
+			world_draw_black_tile(region, position.x, position.y);
+			continue;
+		}
+		RenderTile(region, position, command.levelCelBlock, MaskType::Solid, command.lightTableIndex);
+	}
+}
+
+/**
+ * @brief Render the floor tiles in view through the floor cache
+ * @param out Buffer to render to
+ * @param tilePosition dPiece coordinates
+ * @param offset Offset of the first tile in the target buffer
+ * @param rows Number of rows
+ * @param columns Tile in a row
+ */
+void DrawCachedFloor(const Surface &out, Point tilePosition, Displacement offset, int rows, int columns)
+{
+	const DrawListKey key { tilePosition, rows, columns, DungeonLayoutVersion, LightingVersion };
+	if (DrawLists.floorKey != key) {
+		BuildFloorDrawList(tilePosition, rows, columns);
+		DrawLists.floorKey = key;
+	}
+
+	FloorCache &cache = CachedFloor;
+	const Point targetBufferPosition = Point {} + offset;
+	const Point origin = TileToDungeonPixels(tilePosition) - offset;
+	const FloorCacheArea viewArea { 0, 0, out.w(), out.h() };
+
+	bool redrawAll = false;
+	if (!cache.surface || cache.surface->w() != out.w() || cache.surface->h() != out.h()) {
+		cache.surface.emplace(out.w(), out.h());
+		redrawAll = true;
+	}
+	if (cache.layoutVersion != DungeonLayoutVersion || cache.lightTablesVersion != LightTablesVersion) {
+		cache.layoutVersion = DungeonLayoutVersion;
+		cache.lightTablesVersion = LightTablesVersion;
+		redrawAll = true;
+	}
+
+	const Displacement shift = cache.origin - origin;
+	if (std::abs(shift.deltaX) >= out.w() || std::abs(shift.deltaY) >= out.h())
+		redrawAll = true;
+	cache.origin = origin;
+
+	if (redrawAll) {
+		RenderFloorCacheArea(*cache.surface, targetBufferPosition, viewArea);
+		for (const FloorDrawCommand &command : DrawLists.floor)
+			cache.tileLight[command.tilePosition.x][command.tilePosition.y] = command.lightTableIndex;
+	} else {
+		if (shift != Displacement {}) {
+			ShiftSurface(*cache.surface, shift);
+			if (shift.deltaX > 0)
+				RenderFloorCacheArea(*cache.surface, targetBufferPosition, { 0, 0, shift.deltaX, out.h() });
+			else if (shift.deltaX < 0)
+				RenderFloorCacheArea(*cache.surface, targetBufferPosition, { out.w() + shift.deltaX, 0, out.w(), out.h() });
+			if (shift.deltaY > 0)
+				RenderFloorCacheArea(*cache.surface, targetBufferPosition, { 0, 0, out.w(), shift.deltaY });
+			else if (shift.deltaY < 0)
+				RenderFloorCacheArea(*cache.surface, targetBufferPosition, { 0, out.h() + shift.deltaY, out.w(), out.h() });
+		}
+
+		// Tiles are compared every frame, as tiles scrolling into view may only have been partially rendered
+		FloorCacheArea lightChanges { 0, 0, 0, 0 };
+		for (const FloorDrawCommand &command : DrawLists.floor) {
+			if (command.blackTile)
+				continue;
+			if (cache.tileLight[command.tilePosition.x][command.tilePosition.y] != command.lightTableIndex)
+				lightChanges.merge(GetFloorCommandArea(command, targetBufferPosition));
+		}
+		if (!lightChanges.empty())
+			RenderFloorCacheArea(*cache.surface, targetBufferPosition, lightChanges);
+		for (const FloorDrawCommand &command : DrawLists.floor) {
+			if (!command.blackTile)
+				cache.tileLight[command.tilePosition.x][command.tilePosition.y] = command.lightTableIndex;
+		}
+	}
+
+	out.BlitFrom(*cache.surface, MakeSdlRect(0, 0, out.w(), out.h()), {});
 }
 
 bool IsWall(Point position)
@@ -868,6 +1310,27 @@ bool IsWall(Point position)
 	return TileHasAny(dPiece[position.x][position.y], TileProperties::Solid) || dSpecial[position.x][position.y] != 0;
 }
 
+void BuildCellVisitList(Point tilePosition, int rows, int columns)
+{
+	std::vector<CellVisit> &cells = DrawLists.cells;
+	cells.clear();
+	ForEachTileInView(tilePosition, rows, columns, [&cells](Point position, Displacement offset) {
+		if (!InDungeonBounds(position))
+			return;
+		bool drawEastFirst = false;
+		if (position.x + 1 < MAXDUNX && position.y - 1 >= 0) {
+			// Render objects behind walls first to prevent sprites, that are moving
+			// between tiles, from poking through the walls as they exceed the tile bounds.
+			// A proper fix for this would probably be to layout the sceen and render by
+			// sprite screen position rather than tile position.
+			if (IsWall(position) && (IsWall(position + Displacement { 1, 0 }) || (position.x > 0 && IsWall(position + Displacement { -1, 0 })))) { // Part of a wall aligned on the x-axis
+				drawEastFirst = IsTileNotSolid(position + Displacement { 1, -1 }) && IsTileNotSolid(position + Displacement { 0, -1 });         // Has walkable area behind it
+			}
+		}
+		cells.push_back({ position, offset, drawEastFirst });
+	});
+}
+
 /**
  * @brief Render a row of tile
  * @param out Output buffer
@@ -881,45 +1344,27 @@ void DrawTileContent(const Surface &out, Point tilePosition, Point targetBufferP
 	// Keep evaluating until MicroTiles can't affect screen
 	rows += MicroTileLen;
 	dRendered.reset();
+	UpdateTransparencyMasks();
 
-	for (int i = 0; i < rows; i++) {
-		for (int j = 0; j < columns; j++) {
-			if (InDungeonBounds(tilePosition)) {
+	// The visit order only depends on the layout, not on the lighting.
+	const DrawListKey key { tilePosition, rows, columns, DungeonLayoutVersion, 0 };
+	if (DrawLists.cellsKey != key) {
+		BuildCellVisitList(tilePosition, rows, columns);
+		DrawLists.cellsKey = key;
+	}
+
+	for (const CellVisit &cell : DrawLists.cells) {
+		const Point cellBufferPosition = targetBufferPosition + cell.offset;
 #ifdef _DEBUG
-				DebugCoordsMap[tilePosition.x + tilePosition.y * MAXDUNX] = targetBufferPosition;
+		DebugCoordsMap[cell.tilePosition.x + cell.tilePosition.y * MAXDUNX] = cellBufferPosition;
 #endif
-				if (tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + TILE_WIDTH <= gnScreenWidth) {
-					// Render objects behind walls first to prevent sprites, that are moving
-					// between tiles, from poking through the walls as they exceed the tile bounds.
-					// A proper fix for this would probably be to layout the sceen and render by
-					// sprite screen position rather than tile position.
-					if (IsWall(tilePosition) && (IsWall(tilePosition + Displacement { 1, 0 }) || (tilePosition.x > 0 && IsWall(tilePosition + Displacement { -1, 0 })))) { // Part of a wall aligned on the x-axis
-						if (IsTileNotSolid(tilePosition + Displacement { 1, -1 }) && IsTileNotSolid(tilePosition + Displacement { 0, -1 })) {                              // Has walkable area behind it
-							DrawDungeon(out, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y });
-						}
-					}
-				}
-				DrawDungeon(out, tilePosition, targetBufferPosition);
-			}
-			tilePosition += Direction::East;
-			targetBufferPosition.x += TILE_WIDTH;
-		}
-		// Return to start of row
-		tilePosition += Displacement(Direction::West) * columns;
-		targetBufferPosition.x -= columns * TILE_WIDTH;
-
-		// Jump to next row
-		targetBufferPosition.y += TILE_HEIGHT / 2;
-		if ((i & 1) != 0) {
-			tilePosition.x++;
-			columns--;
-			targetBufferPosition.x += TILE_WIDTH / 2;
-		} else {
-			tilePosition.y++;
-			columns++;
-			targetBufferPosition.x -= TILE_WIDTH / 2;
+		if (cell.drawEastFirst && cellBufferPosition.x + TILE_WIDTH <= gnScreenWidth) {
+			DrawDungeon(cell.tilePosition + Direction::East, { cellBufferPosition.x + TILE_WIDTH, cellBufferPosition.y });
 		}
+		DrawDungeon(cell.tilePosition, cellBufferPosition);
 	}
+
+	FlushDrawQueue(out);
 }
 
 /**
@@ -1080,7 +1525,14 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 	DunRenderStats.clear();
 #endif
 
-	DrawFloor(out, position, Point {} + offset, rows, columns);
+	// Color cycling changes the light tables every frame, which would redraw the whole cache every frame.
+	if (*sgOptions.Graphics.floorCache && !IsLightTableColorCycling()) {
+		// Cache the largest area the view can cover, so that it stays valid while walking
+		DrawCachedFloor(out, position, offset, tileRows + 2, tileColums + 1);
+	} else {
+		FreeFloorCache();
+		DrawFloor(out, position, Point {} + offset, rows, columns);
+	}
 	DrawTileContent(out, position, Point {} + offset, rows, columns);
 
 	if (*sgOptions.Graphics.zoom) {
@@ -1276,6 +1728,25 @@ void DrawFPS(const Surface &out)
 	DrawString(out, formatted, Point { 8, 68 }, UiFlags::ColorRed);
 }
 
+#ifdef DEVILUTIONX_PROFILER
+/**
+ * @brief Shows the time spent in the top-level profiler zones during the previous frame, below the FPS.
+ */
+void DrawProfilerOverlay(const Surface &out)
+{
+	if (!IsProfilerOverlayEnabled())
+		return;
+
+	using Milliseconds = std::chrono::duration<double, std::milli>;
+	Point position { 8, 88 };
+	DrawString(out, fmt::format("Frame: {:.2f} ms", Milliseconds(GetProfilerFrameDuration()).count()), position, UiFlags::ColorRed);
+	for (const ProfilerOverlayLine &line : GetProfilerOverlayLines()) {
+		position.y += 14;
+		DrawString(out, fmt::format("{}: {:.2f} ms ({}x)", line.name, Milliseconds(line.duration).count(), line.count), position, UiFlags::ColorWhite);
+	}
+}
+#endif
+
 /**
  * @brief Update part of the screen from the back buffer
  * @param x Back buffer coordinate
@@ -1509,6 +1980,11 @@ void CalcViewportGeometry()
 	tileColums = (screenWidth - renderStart.x + TILE_WIDTH - 1) / TILE_WIDTH;
 }
 
+void FreeFloorCache()
+{
+	CachedFloor.surface = std::nullopt;
+}
+
 extern SDL_Surface *PalSurface;
 
 void ClearScreenBuffer()
@@ -1613,6 +2089,8 @@ void DrawAndBlit()
 		return;
 	}
 
+	DVL_PROFILE_ZONE("DrawAndBlit");
+	DVL_PROFILE_STEPS(steps);
 	int hgt = 0;
 	bool drawHealth = IsRedrawComponent(PanelDrawComponent::Health);
 	bool drawMana = IsRedrawComponent(PanelDrawComponent::Mana);
@@ -1643,7 +2121,9 @@ void DrawAndBlit()
 
 	nthread_UpdateProgressToNextGameTick();
 
+	DVL_PROFILE_STEP(steps, "DrawView");
 	DrawView(out, ViewPosition);
+	DVL_PROFILE_STEP(steps, "DrawPanels");
 	if (drawCtrlPan) {
 		DrawCtrlPan(out);
 	}
@@ -1673,7 +2153,11 @@ void DrawAndBlit()
 	DrawCursor(out);
 
 	DrawFPS(out);
+#ifdef DEVILUTIONX_PROFILER
+	DrawProfilerOverlay(out);
+#endif
 
+	DVL_PROFILE_STEP(steps, "DrawMain");
 	DrawMain(out, hgt, drawInfoBox, drawHealth, drawMana, drawBelt, drawControlButtons);
 
 	RedrawComplete();
@@ -1683,6 +2167,7 @@ void DrawAndBlit()
 		}
 	}
 
+	DVL_PROFILE_STEP(steps, "RenderPresent");
 	RenderPresent();
 }
 
@@ -60,6 +60,11 @@ void CalcTileOffset(int *offsetX, int *offsetY);
 void TilesInView(int *columns, int *rows);
 void CalcViewportGeometry();
 
+/**
+ * @brief Release the offscreen copy of the floor layer
+ */
+void FreeFloorCache();
+
 /**
  * @brief Render the whole screen black
  */
@@ -0,0 +1,245 @@
+/**
+ * @file resource_cache.hpp
+ *
+ * Resources that are loaded on a background thread when first requested and cached within a memory budget.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+#include "utils/stdcompat/optional.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Memory counters of a `ResourceCache`.
+ */
+struct ResourceCacheStats {
+	/** Number of resources that are loaded or being loaded. */
+	size_t resources;
+	/** Number of resources that are only kept in case they are needed again. */
+	size_t unusedResources;
+	/** Bytes held by all loaded resources. */
+	size_t memoryUsed;
+	/** Bytes held by the unused resources, these are freed first when over budget. */
+	size_t unusedMemory;
+	size_t memoryBudget;
+	/** Number of resources loaded since the start of the game. */
+	size_t loads;
+	/** Number of resources freed to stay within the budget. */
+	size_t evictions;
+};
+
+/**
+ * @brief Resources of type `T`, loaded one after the other on a background thread and kept until the budget is exceeded.
+ *
+ * `T` provides `key()`, `isLoaded()`, `memorySize()`, a `load()` that is called on the loader thread
+ * and a `lastRequest` counter. A resource is in use for as long as a pointer to it is held outside the cache.
+ * Only the main thread calls into the cache.
+ */
+template <typename T>
+class ResourceCache {
+public:
+	explicit ResourceCache(size_t memoryBudget)
+	    : memoryBudget_(memoryBudget)
+	{
+	}
+
+	/**
+	 * @brief Returns the resource identified by `key` and marks it as the most recently requested, `nullptr` if it isn't cached.
+	 */
+	std::shared_ptr<T> find(const std::string &key)
+	{
+		const auto it = std::find_if(resources_.begin(), resources_.end(), [&key](const std::shared_ptr<T> &resource) {
+			return resource->key() == key;
+		});
+		if (it == resources_.end())
+			return nullptr;
+		(*it)->lastRequest = ++requestCounter_;
+		return *it;
+	}
+
+	/**
+	 * @brief Adds a new resource to the cache and queues it for the loader thread.
+	 */
+	void queue(const std::shared_ptr<T> &resource)
+	{
+		resource->lastRequest = ++requestCounter_;
+		resources_.push_back(resource);
+		loads_++;
+
+		if (!queueMutex_) {
+			queueMutex_.emplace();
+			loadedCond_.emplace();
+		}
+		bool startLoader = false;
+		{
+			const std::lock_guard<SdlMutex> lock(*queueMutex_);
+			queue_.push_back(resource);
+			if (!loaderRunning_) {
+				loaderRunning_ = true;
+				startLoader = true;
+			}
+		}
+		if (startLoader) {
+			// The previous loader ran out of work and is exiting, if it hasn't already.
+			loader_.join();
+			loader_ = SdlThread { LoadQueued, this };
+		}
+	}
+
+	/**
+	 * @brief Blocks until `resource` is loaded, loading it on the calling thread if the loader hasn't started on it yet.
+	 */
+	void wait(T &resource)
+	{
+		if (resource.isLoaded())
+			return;
+
+		{
+			const std::lock_guard<SdlMutex> lock(*queueMutex_);
+			const auto it = std::find_if(queue_.begin(), queue_.end(), [&resource](const std::shared_ptr<T> &queued) {
+				return queued.get() == &resource;
+			});
+			if (it == queue_.end()) {
+				// The loader is working on it.
+				while (!resource.isLoaded())
+					loadedCond_->wait(*queueMutex_);
+				return;
+			}
+			queue_.erase(it);
+		}
+		resource.load();
+	}
+
+	/**
+	 * @brief Blocks until all queued resources are loaded.
+	 */
+	void waitAll()
+	{
+		// The loader only exits once the queue is empty.
+		loader_.join();
+	}
+
+	/**
+	 * @brief Frees unused resources, the least recently requested first, until the cache fits within the memory budget.
+	 *
+	 * Resources that are in use are never freed, even when they alone exceed the budget.
+	 * @return The counters after trimming
+	 */
+	ResourceCacheStats trim()
+	{
+		ResourceCacheStats stats = this->stats();
+		if (stats.memoryUsed <= memoryBudget_)
+			return stats;
+
+		std::vector<std::shared_ptr<T>> unused;
+		for (const std::shared_ptr<T> &resource : resources_) {
+			if (!IsInUse(resource) && resource->isLoaded())
+				unused.push_back(resource);
+		}
+		std::sort(unused.begin(), unused.end(), [](const std::shared_ptr<T> &a, const std::shared_ptr<T> &b) {
+			return a->lastRequest < b->lastRequest;
+		});
+
+		size_t memoryUsed = stats.memoryUsed;
+		for (const std::shared_ptr<T> &resource : unused) {
+			if (memoryUsed <= memoryBudget_)
+				break;
+			memoryUsed -= resource->memorySize();
+			resources_.erase(std::find(resources_.begin(), resources_.end(), resource));
+			evictions_++;
+		}
+		return this->stats();
+	}
+
+	[[nodiscard]] ResourceCacheStats stats() const
+	{
+		ResourceCacheStats stats {};
+		stats.resources = resources_.size();
+		stats.memoryBudget = memoryBudget_;
+		stats.loads = loads_;
+		stats.evictions = evictions_;
+		for (const std::shared_ptr<T> &resource : resources_) {
+			const size_t memorySize = resource->memorySize();
+			stats.memoryUsed += memorySize;
+			if (!IsInUse(resource)) {
+				stats.unusedResources++;
+				stats.unusedMemory += memorySize;
+			}
+		}
+		return stats;
+	}
+
+	[[nodiscard]] const std::vector<std::shared_ptr<T>> &resources() const
+	{
+		return resources_;
+	}
+
+	void setMemoryBudget(size_t bytes)
+	{
+		memoryBudget_ = bytes;
+	}
+
+	/**
+	 * @brief Waits for the loader and forgets all resources, those in use are freed once they are released.
+	 */
+	void clear()
+	{
+		waitAll();
+		resources_.clear();
+	}
+
+	static bool IsInUse(const std::shared_ptr<T> &resource)
+	{
+		return resource.use_count() > 1;
+	}
+
+private:
+	static int SDLCALL LoadQueued(void *data)
+	{
+		ResourceCache &cache = *static_cast<ResourceCache *>(data);
+		while (true) {
+			std::shared_ptr<T> resource;
+			{
+				const std::lock_guard<SdlMutex> lock(*cache.queueMutex_);
+				if (cache.queue_.empty()) {
+					cache.loaderRunning_ = false;
+					return 0;
+				}
+				resource = std::move(cache.queue_.front());
+				cache.queue_.pop_front();
+			}
+			resource->load();
+			const std::lock_guard<SdlMutex> lock(*cache.queueMutex_);
+			cache.loadedCond_->signal();
+		}
+	}
+
+	std::vector<std::shared_ptr<T>> resources_;
+	uint32_t requestCounter_ = 0;
+	size_t memoryBudget_;
+	size_t loads_ = 0;
+	size_t evictions_ = 0;
+
+	std::optional<SdlMutex> queueMutex_;
+	/** Signalled by the loader thread whenever it finishes a resource. */
+	std::optional<SdlCond> loadedCond_;
+	/** Resources waiting for the loader thread, guarded by `queueMutex_`. */
+	std::deque<std::shared_ptr<T>> queue_;
+	/** Whether the loader thread is still taking resources from the queue, guarded by `queueMutex_`. */
+	bool loaderRunning_ = false;
+	SdlThread loader_;
+};
+
+} // namespace devilution
@@ -5,10 +5,9 @@
  */
 #include "engine/sound.h"
 
+#include <array>
 #include <cstdint>
-#include <list>
 #include <memory>
-#include <mutex>
 
 #include <SDL.h>
 
@@ -17,10 +16,8 @@
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/math.h"
-#include "utils/sdl_mutex.h"
+#include "utils/pcm_aulib_decoder.h"
 #include "utils/stdcompat/algorithm.hpp"
-#include "utils/stdcompat/optional.hpp"
-#include "utils/stdcompat/shared_ptr_array.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/stubs.h"
 
@@ -46,7 +43,7 @@ std::string GetMp3Path(const char *path)
 	return mp3Path;
 }
 
-bool LoadAudioFile(const char *path, bool stream, bool errorDialog, SoundSample &result)
+bool LoadAudioFile(const char *path, bool stream, bool errorDialog, SoundSample &result, bool threadsafe = false)
 {
 	bool isMp3 = true;
 	std::string foundPath = GetMp3Path(path);
@@ -56,8 +53,12 @@ bool LoadAudioFile(const char *path, bool stream, bool errorDialog, SoundSample
 		foundPath = path;
 		isMp3 = false;
 	}
-	if (!ref.ok())
-		ErrDlg("Audio file not found", StrCat(path, "\n", SDL_GetError(), "\n"), __FILE__, __LINE__);
+	if (!ref.ok()) {
+		if (errorDialog)
+			ErrDlg("Audio file not found", StrCat(path, "\n", SDL_GetError(), "\n"), __FILE__, __LINE__);
+		LogError(LogCategory::Audio, "Audio file not found: {}", path);
+		return false;
+	}
 
 #ifdef STREAM_ALL_AUDIO_MIN_FILE_SIZE
 #if STREAM_ALL_AUDIO_MIN_FILE_SIZE == 0
@@ -82,49 +83,84 @@ bool LoadAudioFile(const char *path, bool stream, bool errorDialog, SoundSample
 #if !defined(STREAM_ALL_AUDIO_MIN_FILE_SIZE) || STREAM_ALL_AUDIO_MIN_FILE_SIZE == 0
 		const size_t size = ref.size();
 #endif
-		AssetHandle handle = OpenAsset(std::move(ref));
+		AssetHandle handle = OpenAsset(std::move(ref), threadsafe);
 		if (!handle.ok()) {
 			if (errorDialog)
 				ErrDlg("Failed to load audio file", StrCat(foundPath, "\n", SDL_GetError(), "\n"), __FILE__, __LINE__);
+			LogError(LogCategory::Audio, "Failed to load audio file {}: {}", foundPath, SDL_GetError());
 			return false;
 		}
-		auto waveFile = MakeArraySharedPtr<std::uint8_t>(size);
+		std::unique_ptr<std::uint8_t[]> waveFile { new std::uint8_t[size] };
 		if (!handle.read(waveFile.get(), size)) {
 			if (errorDialog)
 				ErrDlg("Failed to read file", StrCat(foundPath, ": ", SDL_GetError()), __FILE__, __LINE__);
+			LogError(LogCategory::Audio, "Failed to read file {}: {}", foundPath, SDL_GetError());
 			return false;
 		}
-		const int error = result.SetChunk(waveFile, size, isMp3);
+		const int error = result.SetChunk(waveFile.get(), size, isMp3);
 		if (error != 0) {
 			if (errorDialog)
 				ErrSdl();
+			LogError(LogCategory::Audio, "Failed to decode audio file {}: {}", foundPath, SDL_GetError());
 			return false;
 		}
 	}
 	return true;
 }
 
-std::list<std::unique_ptr<SoundSample>> duplicateSounds;
-std::optional<SdlMutex> duplicateSoundsMutex;
+/** A sample for playing a sound effect that its own sample is still busy with, see `snd_play_snd`. */
+struct SoundVoice {
+	SoundSample sample;
+	SoundPriority priority;
+	int volume;
+};
+
+/** Beyond this many overlapping sound effects, the least important ones are cut off. */
+constexpr size_t NumSoundVoices = 32;
+
+/** Created in `snd_init` and reused from then on, so that playing a sound doesn't allocate. */
+std::array<SoundVoice, NumSoundVoices> SoundVoices;
+
+/** Plays nothing, in the format of the game's sound effects (22050 Hz mono) that the voices are opened with. */
+std::shared_ptr<const PcmSamples> SilentSamples;
+
+/**
+ * @brief Which voices are cut off first, sounds of a less important kind and then quieter (further away) ones.
+ */
+int GetVoiceImportance(SoundPriority priority, int volume)
+{
+	return static_cast<int>(priority) * (ATTENUATION_MAX - ATTENUATION_MIN + 1) + clamp(volume, ATTENUATION_MIN, ATTENUATION_MAX);
+}
 
-SoundSample *DuplicateSound(const SoundSample &sound)
+/**
+ * @brief Finds a voice that isn't playing, or stops the least important one if that is less important than the new sound.
+ */
+SoundVoice *AcquireVoice(SoundPriority priority, int volume)
 {
-	auto duplicate = std::make_unique<SoundSample>();
-	if (duplicate->DuplicateFrom(sound) != 0)
-		return nullptr;
-	auto *result = duplicate.get();
-	decltype(duplicateSounds.begin()) it;
-	{
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		duplicateSounds.push_back(std::move(duplicate));
-		it = duplicateSounds.end();
-		--it;
+	SoundVoice *weakest = nullptr;
+	for (SoundVoice &voice : SoundVoices) {
+		if (!voice.sample.IsPlaying())
+			return &voice;
+		if (weakest == nullptr || GetVoiceImportance(voice.priority, voice.volume) < GetVoiceImportance(weakest->priority, weakest->volume))
+			weakest = &voice;
 	}
-	result->SetFinishCallback([it]([[maybe_unused]] Aulib::Stream &stream) {
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		duplicateSounds.erase(it);
-	});
-	return result;
+	if (GetVoiceImportance(priority, volume) <= GetVoiceImportance(weakest->priority, weakest->volume))
+		return nullptr;
+	weakest->sample.Stop();
+	return weakest;
+}
+
+SoundSample *DuplicateSound(const SoundSample &sound, SoundPriority priority, int volume)
+{
+	// Streamed sounds can't share their data, those are rare enough to not need a voice.
+	if (sound.IsStreaming())
+		return nullptr;
+	SoundVoice *voice = AcquireVoice(priority, volume);
+	if (voice == nullptr || voice->sample.SetPcm(sound.GetPcm()) != 0)
+		return nullptr;
+	voice->priority = priority;
+	voice->volume = volume;
+	return &voice->sample;
 }
 
 /** Maps from track ID to track name in spawn. */
@@ -160,11 +196,16 @@ int CapVolume(int volume)
 
 void ClearDuplicateSounds()
 {
-	const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-	duplicateSounds.clear();
+	for (SoundVoice &voice : SoundVoices) {
+		if (!voice.sample.IsLoaded())
+			continue;
+		voice.sample.Stop();
+		// Let go of the sound, without reallocating the stream.
+		voice.sample.SetPcm(SilentSamples);
+	}
 }
 
-void snd_play_snd(TSnd *pSnd, int lVolume, int lPan)
+void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, SoundPriority priority)
 {
 	if (pSnd == nullptr || !gbSoundOn) {
 		return;
@@ -177,7 +218,7 @@ void snd_play_snd(TSnd *pSnd, int lVolume, int lPan)
 
 	SoundSample *sound = &pSnd->DSB;
 	if (sound->IsPlaying()) {
-		sound = DuplicateSound(*sound);
+		sound = DuplicateSound(*sound, priority, lVolume);
 		if (sound == nullptr)
 			return;
 	}
@@ -196,6 +237,14 @@ std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream)
 	return snd;
 }
 
+std::unique_ptr<TSnd> sound_file_load_threadsafe(const char *path)
+{
+	auto snd = std::make_unique<TSnd>();
+	snd->start_tc = SDL_GetTicks() - 80 - 1;
+	LoadAudioFile(path, /*stream=*/false, /*errorDialog=*/false, snd->DSB, /*threadsafe=*/true);
+	return snd;
+}
+
 TSnd::~TSnd()
 {
 	if (DSB.IsLoaded())
@@ -222,15 +271,25 @@ void snd_init()
 	LogVerbose(LogCategory::Audio, "Aulib sampleRate={} channels={} frameSize={} format={:#x}",
 	    Aulib::sampleRate(), Aulib::channelCount(), Aulib::frameSize(), Aulib::sampleFormat());
 
-	duplicateSoundsMutex.emplace();
+	auto silence = std::make_shared<PcmSamples>();
+	silence->data.reset(new std::int16_t[0]);
+	silence->size = 0;
+	silence->channels = 1;
+	silence->rate = 22050;
+	SilentSamples = std::move(silence);
+	for (SoundVoice &voice : SoundVoices)
+		voice.sample.SetPcm(SilentSamples);
+
 	gbSndInited = true;
 }
 
 void snd_deinit()
 {
 	if (gbSndInited) {
+		for (SoundVoice &voice : SoundVoices)
+			voice.sample.Release();
+		SilentSamples = nullptr;
 		Aulib::quit();
-		duplicateSoundsMutex = std::nullopt;
 	}
 
 	gbSndInited = false;
@@ -41,22 +41,51 @@ struct TSnd {
 	{
 		return DSB.IsPlaying();
 	}
+
+	size_t memorySize() const
+	{
+		return DSB.GetMemorySize();
+	}
 #else
 	bool isPlaying()
 	{
 		return false;
 	}
+
+	size_t memorySize() const
+	{
+		return 0;
+	}
 #endif
 
 	~TSnd();
 };
 
+/**
+ * @brief Which sound effects keep playing when more of them overlap than there are voices for.
+ */
+enum class SoundPriority : uint8_t {
+	Monster,
+	/** Missiles, items, objects and the like. */
+	World,
+	/** The heroes speaking. */
+	Hero,
+	Interface,
+};
+
 extern bool gbSndInited;
 extern _music_id sgnMusicTrack;
 
+/**
+ * @brief Stops the sound effects that are played over themselves.
+ */
 void ClearDuplicateSounds();
-void snd_play_snd(TSnd *pSnd, int lVolume, int lPan);
+void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, SoundPriority priority);
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream = false);
+/**
+ * @brief Loads a sound effect on a thread other than the main one, errors are logged instead of shown.
+ */
+std::unique_ptr<TSnd> sound_file_load_threadsafe(const char *path);
 void snd_init();
 void snd_deinit();
 _music_id GetLevelMusic(dungeon_type dungeonType);
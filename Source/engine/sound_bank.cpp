@@ -0,0 +1,82 @@
+/**
+ * @file sound_bank.cpp
+ *
+ * Implementation of sets of sound effects that are loaded in the background and cached between levels.
+ */
+#include "engine/sound_bank.hpp"
+
+#include "utils/log.hpp"
+
+namespace devilution {
+
+namespace {
+
+#ifdef __3DS__
+constexpr size_t DefaultMemoryBudget = 4 * 1024 * 1024;
+#else
+constexpr size_t DefaultMemoryBudget = 32 * 1024 * 1024;
+#endif
+
+ResourceCache<SoundBank> Banks { DefaultMemoryBudget };
+
+} // namespace
+
+SoundBank::SoundBank(std::string name, std::vector<std::string> paths)
+    : name_(std::move(name))
+    , paths_(std::move(paths))
+{
+}
+
+void SoundBank::load()
+{
+	sounds_.reserve(paths_.size());
+	for (const std::string &path : paths_) {
+		std::unique_ptr<TSnd> snd;
+		if (!path.empty())
+			snd = sound_file_load_threadsafe(path.c_str());
+		if (snd != nullptr)
+			memorySize_ += snd->memorySize();
+		sounds_.push_back(std::move(snd));
+	}
+	loaded_.store(true, std::memory_order_release);
+}
+
+std::shared_ptr<SoundBank> RequestSoundBank(const std::string &name, std::vector<std::string> paths)
+{
+	std::shared_ptr<SoundBank> bank = Banks.find(name);
+	if (bank != nullptr)
+		return bank;
+
+	bank = std::make_shared<SoundBank>(name, std::move(paths));
+	Banks.queue(bank);
+	return bank;
+}
+
+void WaitForSoundBanks()
+{
+	Banks.waitAll();
+}
+
+void TrimSoundBanks()
+{
+	const SoundBankStats stats = Banks.trim();
+	LogVerbose(LogCategory::Audio, "Sound banks: {} loaded ({} unused), {} of {} KiB used ({} KiB unused), {} loads, {} evictions",
+	    stats.resources, stats.unusedResources, stats.memoryUsed / 1024, stats.memoryBudget / 1024, stats.unusedMemory / 1024, stats.loads, stats.evictions);
+}
+
+void SetSoundBankMemoryBudget(size_t bytes)
+{
+	Banks.setMemoryBudget(bytes);
+}
+
+SoundBankStats GetSoundBankStats()
+{
+	return Banks.stats();
+}
+
+void FreeSoundBanks()
+{
+	Banks.clear();
+}
+
+} // namespace devilution
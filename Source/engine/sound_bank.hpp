@@ -0,0 +1,113 @@
+/**
+ * @file sound_bank.hpp
+ *
+ * Sets of sound effects that are loaded in the background and cached between levels.
+ *
+ * Music is not banked: `music_start` streams the track from the archive while it plays, so there is nothing
+ * to load ahead of time, and keeping decoded tracks around would cost far more than the sound effects.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/resource_cache.hpp"
+#include "engine/sound.h"
+
+namespace devilution {
+
+/**
+ * @brief Sounds that are loaded and freed together, such as those of a monster type.
+ *
+ * Banks are loaded on a background thread and kept after the level that needed them is left,
+ * until `TrimSoundBanks` frees them to stay within the memory budget.
+ */
+class SoundBank {
+public:
+	/**
+	 * @param name Identifies the bank, requesting the same name again returns the same bank
+	 * @param paths The sound files, an empty path leaves its sound empty
+	 */
+	SoundBank(std::string name, std::vector<std::string> paths);
+
+	/**
+	 * @brief The name of the bank, requesting the same name again returns the same bank.
+	 */
+	[[nodiscard]] const std::string &key() const
+	{
+		return name_;
+	}
+
+	[[nodiscard]] bool isLoaded() const
+	{
+		return loaded_.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief The sound for `paths[index]`, `nullptr` if there is none or the bank is still being loaded.
+	 */
+	[[nodiscard]] TSnd *sound(size_t index) const
+	{
+		if (!isLoaded() || index >= sounds_.size())
+			return nullptr;
+		return sounds_[index].get();
+	}
+
+	/**
+	 * @brief Bytes of decoded samples held by the bank, 0 until it is loaded.
+	 */
+	[[nodiscard]] size_t memorySize() const
+	{
+		return isLoaded() ? memorySize_ : 0;
+	}
+
+	/**
+	 * @brief Loads the sounds, called on the loader thread.
+	 */
+	void load();
+
+	/** @brief When the bank was last requested, used to free the least recently used banks first. */
+	uint32_t lastRequest = 0;
+
+private:
+	std::string name_;
+	std::vector<std::string> paths_;
+	std::vector<std::unique_ptr<TSnd>> sounds_;
+	size_t memorySize_ = 0;
+	std::atomic<bool> loaded_ { false };
+};
+
+using SoundBankStats = ResourceCacheStats;
+
+/**
+ * @brief Returns the bank called `name`, which is queued to be loaded in the background if it isn't cached.
+ *
+ * A bank is in use for as long as the returned pointer (or a copy) is held.
+ */
+std::shared_ptr<SoundBank> RequestSoundBank(const std::string &name, std::vector<std::string> paths);
+
+/**
+ * @brief Blocks until all requested banks are loaded.
+ */
+void WaitForSoundBanks();
+
+/**
+ * @brief Frees unused banks, the least recently requested first, until the banks fit within the memory budget.
+ *
+ * Banks that are in use are never freed, even when they alone exceed the budget.
+ */
+void TrimSoundBanks();
+
+void SetSoundBankMemoryBudget(size_t bytes);
+SoundBankStats GetSoundBankStats();
+
+/**
+ * @brief Waits for the loader and forgets all banks, those in use are freed once they are released.
+ */
+void FreeSoundBanks();
+
+} // namespace devilution
@@ -12,8 +12,9 @@ _music_id sgnMusicTrack = NUM_MUSIC;
 // AllowShortFunctionsOnASingleLine: None
 // clang-format off
 void ClearDuplicateSounds() { }
-void snd_play_snd(TSnd *pSnd, int lVolume, int lPan) { }
+void snd_play_snd(TSnd *pSnd, int lVolume, int lPan, SoundPriority priority) { }
 std::unique_ptr<TSnd> sound_file_load(const char *path, bool stream) { return nullptr; }
+std::unique_ptr<TSnd> sound_file_load_threadsafe(const char *path) { return nullptr; }
 TSnd::~TSnd()
 {
 }
@@ -25,9 +25,8 @@ uint8_t *GetPauseTRN()
 	return &LightTables[18 * 256];
 }
 
-std::optional<std::array<uint8_t, 256>> GetClassTRN(Player &player)
+const char *GetClassTRNPath(const Player &player)
 {
-	std::array<uint8_t, 256> trn;
 	const char *path;
 
 	switch (player._pClass) {
@@ -56,10 +55,7 @@ std::optional<std::array<uint8_t, 256>> GetClassTRN(Player &player)
 		path = debugTRN.c_str();
 	}
 #endif
-	if (LoadOptionalFileInMem(path, &trn[0], 256)) {
-		return trn;
-	}
-	return std::nullopt;
+	return path;
 }
 
 } // namespace devilution
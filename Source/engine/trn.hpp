@@ -13,6 +13,9 @@ namespace devilution {
 uint8_t *GetInfravisionTRN();
 uint8_t *GetStoneTRN();
 uint8_t *GetPauseTRN();
-std::optional<std::array<uint8_t, 256>> GetClassTRN(Player &player);
+/**
+ * @brief The file of the colour translation of the player's class, which may not exist.
+ */
+const char *GetClassTRNPath(const Player &player);
 
 } // namespace devilution
@@ -165,6 +165,8 @@ void init_cleanup()
 		pfile_write_hero(/*writeGameData=*/false);
 		sfile_write_stash();
 	}
+	pfile_flush_saves();
+	pfile_write_hero_summaries();
 
 #ifdef UNPACKED_MPQS
 	lang_data_path = std::nullopt;
@@ -6,7 +6,10 @@
 #include "items.h"
 
 #include <algorithm>
+#include <array>
 #include <bitset>
+#include <memory>
+#include <vector>
 #ifdef _DEBUG
 #include <random>
 #endif
@@ -52,7 +55,9 @@ namespace devilution {
 Item Items[MAXITEMS + 1];
 uint8_t ActiveItems[MAXITEMS];
 uint8_t ActiveItemCount;
+#ifndef DEVILUTIONX_PACKED_DUNGEON_TILES
 int8_t dItem[MAXDUNX][MAXDUNY];
+#endif
 bool ShowUniqueItemInfoBox;
 CornerStoneStruct CornerStone;
 bool UniqueItemFlags[128];
@@ -386,6 +391,93 @@ bool IsSuffixValidForItemType(int i, AffixItemType flgs)
 	return HasAnyOf(flgs, itemTypes);
 }
 
+/**
+ * @brief The fields of an affix that decide whether it can be rolled, copied out of the affix table.
+ */
+struct AffixCandidate {
+	int16_t index;
+	int8_t minLevel;
+	goodorevil goe;
+	bool isOk;
+	bool isDouble;
+	bool isCharges;
+};
+
+/**
+ * @brief The affixes that are valid for each combination of `AffixItemType` flags.
+ *
+ * The candidates are kept in table order, so rolling from them gives the same affix as scanning the whole table.
+ */
+struct AffixCandidateTable {
+	std::array<std::vector<AffixCandidate>, 1 << 6> byItemType;
+
+	AffixCandidateTable(const PLStruct *affixes, bool (*isValidForItemType)(int, AffixItemType))
+	{
+		for (size_t flags = 0; flags < byItemType.size(); flags++) {
+			for (int j = 0; affixes[j].power.type != IPL_INVALID; j++) {
+				if (!isValidForItemType(j, static_cast<AffixItemType>(flags)))
+					continue;
+				const PLStruct &affix = affixes[j];
+				byItemType[flags].push_back({ static_cast<int16_t>(j), affix.PLMinLvl, affix.PLGOE, affix.PLOk, affix.PLDouble, affix.power.type == IPL_CHARGES });
+			}
+		}
+	}
+};
+
+const std::vector<AffixCandidate> &GetPrefixCandidates(AffixItemType flgs)
+{
+	static const AffixCandidateTable Candidates { ItemPrefixes, IsPrefixValidForItemType };
+	return Candidates.byItemType[static_cast<uint8_t>(flgs)];
+}
+
+const std::vector<AffixCandidate> &GetSuffixCandidates(AffixItemType flgs)
+{
+	static const AffixCandidateTable Candidates { ItemSuffixes, IsSuffixValidForItemType };
+	return Candidates.byItemType[static_cast<uint8_t>(flgs)];
+}
+
+/**
+ * @brief The items that can be dropped at all, in table order.
+ *
+ * `IsItemAvailable` doesn't depend on the game settings, so this is only built once.
+ */
+const std::vector<_item_indexes> &GetDroppableItemCandidates()
+{
+	static const std::vector<_item_indexes> Candidates = [] {
+		std::vector<_item_indexes> candidates;
+		for (std::underlying_type_t<_item_indexes> i = IDI_GOLD; i <= IDI_LAST; i++) {
+			if (IsItemAvailable(i) && AllItemsList[i].iRnd != IDROP_NEVER)
+				candidates.push_back(static_cast<_item_indexes>(i));
+		}
+		return candidates;
+	}();
+	return Candidates;
+}
+
+/**
+ * @brief The unique items based on `baseItem`, in table order.
+ */
+const std::vector<uint8_t> &GetUniqueCandidates(unique_base_item baseItem)
+{
+	static const std::vector<std::vector<uint8_t>> Candidates = [] {
+		std::vector<std::vector<uint8_t>> candidates;
+		for (int j = 0; UniqueItems[j].UIItemId != UITYPE_INVALID; j++) {
+			if (!IsUniqueAvailable(j))
+				break;
+			const auto base = static_cast<size_t>(UniqueItems[j].UIItemId);
+			if (candidates.size() <= base)
+				candidates.resize(base + 1);
+			candidates[base].push_back(static_cast<uint8_t>(j));
+		}
+		return candidates;
+	}();
+	static const std::vector<uint8_t> None;
+
+	if (baseItem == UITYPE_INVALID || static_cast<size_t>(baseItem) >= Candidates.size())
+		return None;
+	return Candidates[baseItem];
+}
+
 int ItemsGetCurrlevel()
 {
 	if (setlevel) {
@@ -1081,15 +1173,15 @@ void GetStaffPower(const Player &player, Item &item, int lvl, SpellID bs, bool o
 	if (FlipCoin(10) || onlygood) {
 		int nl = 0;
 		int l[256];
-		for (int j = 0; ItemPrefixes[j].power.type != IPL_INVALID; j++) {
-			if (!IsPrefixValidForItemType(j, AffixItemType::Staff) || ItemPrefixes[j].PLMinLvl > lvl)
+		for (const AffixCandidate &prefix : GetPrefixCandidates(AffixItemType::Staff)) {
+			if (prefix.minLevel > lvl)
 				continue;
-			if (onlygood && !ItemPrefixes[j].PLOk)
+			if (onlygood && !prefix.isOk)
 				continue;
-			l[nl] = j;
+			l[nl] = prefix.index;
 			nl++;
-			if (ItemPrefixes[j].PLDouble) {
-				l[nl] = j;
+			if (prefix.isDouble) {
+				l[nl] = prefix.index;
 				nl++;
 			}
 		}
@@ -1162,19 +1254,17 @@ void GetItemPower(const Player &player, Item &item, int minlvl, int maxlvl, Affi
 		onlygood = true;
 	if (allocatePrefix) {
 		int nt = 0;
-		for (int j = 0; ItemPrefixes[j].power.type != IPL_INVALID; j++) {
-			if (!IsPrefixValidForItemType(j, flgs))
+		for (const AffixCandidate &prefix : GetPrefixCandidates(flgs)) {
+			if (prefix.minLevel < minlvl || prefix.minLevel > maxlvl)
 				continue;
-			if (ItemPrefixes[j].PLMinLvl < minlvl || ItemPrefixes[j].PLMinLvl > maxlvl)
+			if (onlygood && !prefix.isOk)
 				continue;
-			if (onlygood && !ItemPrefixes[j].PLOk)
+			if (HasAnyOf(flgs, AffixItemType::Staff) && prefix.isCharges)
 				continue;
-			if (HasAnyOf(flgs, AffixItemType::Staff) && ItemPrefixes[j].power.type == IPL_CHARGES)
-				continue;
-			l[nt] = j;
+			l[nt] = prefix.index;
 			nt++;
-			if (ItemPrefixes[j].PLDouble) {
-				l[nt] = j;
+			if (prefix.isDouble) {
+				l[nt] = prefix.index;
 				nt++;
 			}
 		}
@@ -1188,12 +1278,11 @@ void GetItemPower(const Player &player, Item &item, int minlvl, int maxlvl, Affi
 	}
 	if (allocateSuffix) {
 		int nl = 0;
-		for (int j = 0; ItemSuffixes[j].power.type != IPL_INVALID; j++) {
-			if (IsSuffixValidForItemType(j, flgs)
-			    && ItemSuffixes[j].PLMinLvl >= minlvl && ItemSuffixes[j].PLMinLvl <= maxlvl
-			    && !((goe == GOE_GOOD && ItemSuffixes[j].PLGOE == GOE_EVIL) || (goe == GOE_EVIL && ItemSuffixes[j].PLGOE == GOE_GOOD))
-			    && (!onlygood || ItemSuffixes[j].PLOk)) {
-				l[nl] = j;
+		for (const AffixCandidate &suffix : GetSuffixCandidates(flgs)) {
+			if (suffix.minLevel >= minlvl && suffix.minLevel <= maxlvl
+			    && !((goe == GOE_GOOD && suffix.goe == GOE_EVIL) || (goe == GOE_EVIL && suffix.goe == GOE_GOOD))
+			    && (!onlygood || suffix.isOk)) {
+				l[nl] = suffix.index;
 				nl++;
 			}
 		}
@@ -1325,23 +1414,19 @@ void GetItemBonus(const Player &player, Item &item, int minlvl, int maxlvl, bool
 
 _item_indexes GetItemIndexForDroppableItem(bool considerDropRate, tl::function_ref<bool(const ItemData &item)> isItemOkay)
 {
-	static std::array<_item_indexes, IDI_LAST * 2> ril;
+	thread_local std::array<_item_indexes, IDI_LAST * 2> ril;
 
 	size_t ri = 0;
-	for (std::underlying_type_t<_item_indexes> i = IDI_GOLD; i <= IDI_LAST; i++) {
-		if (!IsItemAvailable(i))
-			continue;
+	for (const _item_indexes i : GetDroppableItemCandidates()) {
 		const ItemData &item = AllItemsList[i];
-		if (item.iRnd == IDROP_NEVER)
-			continue;
 		if (IsAnyOf(item.iSpell, SpellID::Resurrect, SpellID::HealOther) && !gbIsMultiplayer)
 			continue;
 		if (!isItemOkay(item))
 			continue;
-		ril[ri] = static_cast<_item_indexes>(i);
+		ril[ri] = i;
 		ri++;
 		if (item.iRnd == IDROP_DOUBLE && considerDropRate) {
-			ril[ri] = static_cast<_item_indexes>(i);
+			ril[ri] = i;
 			ri++;
 		}
 	}
@@ -1400,11 +1485,8 @@ _unique_items CheckUnique(Item &item, int lvl, int uper, bool recreate)
 		return UITEM_INVALID;
 
 	int numu = 0;
-	for (int j = 0; UniqueItems[j].UIItemId != UITYPE_INVALID; j++) {
-		if (!IsUniqueAvailable(j))
-			break;
-		if (UniqueItems[j].UIItemId == AllItemsList[item.IDidx].iItemId
-		    && lvl >= UniqueItems[j].UIMinLvl
+	for (const uint8_t j : GetUniqueCandidates(AllItemsList[item.IDidx].iItemId)) {
+		if (lvl >= UniqueItems[j].UIMinLvl
 		    && (recreate || !UniqueItemFlags[j] || gbIsMultiplayer)) {
 			uok[j] = true;
 			numu++;
@@ -2209,8 +2291,289 @@ _item_indexes RndItemForMonsterLevel(int8_t monsterLevel)
 	});
 }
 
+ItemStatContribution GetItemStatContribution(const Item &item)
+{
+	ItemStatContribution stats {};
+	if (item.isEmpty() || !item._iStatFlag)
+		return stats;
+
+	stats.minDamage = item._iMinDam;
+	stats.maxDamage = item._iMaxDam;
+	stats.armorClass = item._iAC;
+
+	if (IsValidSpell(item._iSpell)) {
+		stats.spells = GetSpellBitmask(item._iSpell);
+	}
+
+	if (item._iMagical == ITEM_QUALITY_NORMAL || item._iIdentified) {
+		stats.bonusDamage = item._iPLDam;
+		stats.bonusToHit = item._iPLToHit;
+		if (item._iPLAC != 0) {
+			int tmpac = item._iAC;
+			tmpac *= item._iPLAC;
+			tmpac /= 100;
+			if (tmpac == 0)
+				tmpac = math::Sign(item._iPLAC);
+			stats.bonusArmorClass = tmpac;
+		}
+		stats.flags = item._iFlags;
+		stats.damAcFlags = item._iDamAcFlags;
+		stats.strength = item._iPLStr;
+		stats.magic = item._iPLMag;
+		stats.dexterity = item._iPLDex;
+		stats.vitality = item._iPLVit;
+		stats.fireResist = item._iPLFR;
+		stats.lightningResist = item._iPLLR;
+		stats.magicResist = item._iPLMR;
+		stats.damageMod = item._iPLDamMod;
+		stats.getHit = item._iPLGetHit;
+		stats.lightRadius = item._iPLLight;
+		stats.hitPoints = item._iPLHP;
+		stats.mana = item._iPLMana;
+		stats.spellLevels = item._iSplLvlAdd;
+		stats.enhancedAccuracy = item._iPLEnAc;
+		stats.fireMinDamage = item._iFMinDam;
+		stats.fireMaxDamage = item._iFMaxDam;
+		stats.lightningMinDamage = item._iLMinDam;
+		stats.lightningMaxDamage = item._iLMaxDam;
+	}
+
+	return stats;
+}
+
+/**
+ * @brief Adds (or with `sign` -1 takes back) the summable part of `stats` to `totals`.
+ */
+void AddItemStatContribution(ItemStatContribution &totals, const ItemStatContribution &stats, int sign)
+{
+	totals.minDamage += sign * stats.minDamage;
+	totals.maxDamage += sign * stats.maxDamage;
+	totals.armorClass += sign * stats.armorClass;
+	totals.bonusDamage += sign * stats.bonusDamage;
+	totals.bonusToHit += sign * stats.bonusToHit;
+	totals.bonusArmorClass += sign * stats.bonusArmorClass;
+	totals.strength += sign * stats.strength;
+	totals.magic += sign * stats.magic;
+	totals.dexterity += sign * stats.dexterity;
+	totals.vitality += sign * stats.vitality;
+	totals.fireResist += sign * stats.fireResist;
+	totals.lightningResist += sign * stats.lightningResist;
+	totals.magicResist += sign * stats.magicResist;
+	totals.damageMod += sign * stats.damageMod;
+	totals.getHit += sign * stats.getHit;
+	totals.lightRadius += sign * stats.lightRadius;
+	totals.hitPoints += sign * stats.hitPoints;
+	totals.mana += sign * stats.mana;
+	totals.spellLevels += sign * stats.spellLevels;
+	totals.enhancedAccuracy += sign * stats.enhancedAccuracy;
+	totals.fireMinDamage += sign * stats.fireMinDamage;
+	totals.fireMaxDamage += sign * stats.fireMaxDamage;
+	totals.lightningMinDamage += sign * stats.lightningMinDamage;
+	totals.lightningMaxDamage += sign * stats.lightningMaxDamage;
+}
+
+void CombineItemStatFlags(ItemStatContribution &totals, const ItemStatContribution *slots)
+{
+	totals.flags = ItemSpecialEffect::None;
+	totals.damAcFlags = ItemSpecialEffectHf::None;
+	totals.spells = 0;
+	for (int i = 0; i < NUM_INVLOC; i++) {
+		totals.flags |= slots[i].flags;
+		totals.damAcFlags |= slots[i].damAcFlags;
+		totals.spells |= slots[i].spells;
+	}
+}
+
+ItemStatKey GetItemStatKey(const Item &item)
+{
+	return {
+		item._itype,
+		item.IDidx,
+		item._iSeed,
+		item._iCreateInfo,
+		item._iIdentified,
+		item._iStatFlag,
+		item._iDurability,
+		item._iMinDam,
+		item._iMaxDam,
+		item._iAC,
+		item._iPLDam,
+		item._iPLToHit,
+	};
+}
+
+/**
+ * @brief Brings `Player::equippedItemStats` up to date with the equipped items.
+ *
+ * Only the slots whose item changed since the last call are taken out of and added back into the sum.
+ * Items are changed in place in a few places (shrines, oils, decay), so each slot keeps a key of the item
+ * rather than relying on the callers to say which slots changed.
+ */
+void UpdateEquippedItemStats(Player &player)
+{
+	bool changed = false;
+	for (int i = 0; i < NUM_INVLOC; i++) {
+		const ItemStatKey key = GetItemStatKey(player.InvBody[i]);
+		if (key == player.equippedItemSlotKeys[i])
+			continue;
+		player.equippedItemSlotKeys[i] = key;
+		const ItemStatContribution stats = GetItemStatContribution(player.InvBody[i]);
+		ItemStatContribution &slotStats = player.equippedItemSlotStats[i];
+		if (stats == slotStats)
+			continue;
+		AddItemStatContribution(player.equippedItemStats, slotStats, -1);
+		AddItemStatContribution(player.equippedItemStats, stats, 1);
+		slotStats = stats;
+		changed = true;
+	}
+	if (changed)
+		CombineItemStatFlags(player.equippedItemStats, player.equippedItemSlotStats);
+
+#ifdef _DEBUG
+	ItemStatContribution slotStats[NUM_INVLOC];
+	ItemStatContribution recomputed {};
+	for (int i = 0; i < NUM_INVLOC; i++) {
+		slotStats[i] = GetItemStatContribution(player.InvBody[i]);
+		AddItemStatContribution(recomputed, slotStats[i], 1);
+	}
+	CombineItemStatFlags(recomputed, slotStats);
+	if (recomputed != player.equippedItemStats)
+		app_fatal("Equipped item stats are out of sync with the items");
+#endif
+}
+
+/**
+ * @brief Everything that `RecreateItem` reads to generate an item, besides the constant item tables.
+ */
+struct ItemRecreationKey {
+	int32_t seed;
+	uint16_t createInfo;
+	_item_indexes idx;
+	/** Affix values and store item choices depend on the player. */
+	HeroClass playerClass;
+	int baseStrength;
+	int baseMagic;
+	int baseDexterity;
+	int baseVitality;
+	int maxHPBase;
+	int maxManaBase;
+	bool multiplayer;
+	bool showAnimation;
+	/** Which uniques can still be rolled, only set when `CheckUnique` reads `UniqueItemFlags`. */
+	std::bitset<128> uniqueItemFlags;
+
+	bool operator==(const ItemRecreationKey &other) const
+	{
+		return seed == other.seed && createInfo == other.createInfo && idx == other.idx
+		    && playerClass == other.playerClass
+		    && baseStrength == other.baseStrength && baseMagic == other.baseMagic
+		    && baseDexterity == other.baseDexterity && baseVitality == other.baseVitality
+		    && maxHPBase == other.maxHPBase && maxManaBase == other.maxManaBase
+		    && multiplayer == other.multiplayer && showAnimation == other.showAnimation
+		    && uniqueItemFlags == other.uniqueItemFlags;
+	}
+};
+
+struct ItemRecreationCacheEntry {
+	bool used = false;
+	ItemRecreationKey key;
+	Item item;
+	/** The state generating the item left the random number generator in. */
+	uint32_t rngState;
+	bool setsRngState;
+};
+
+#ifdef __3DS__
+constexpr size_t ItemRecreationCacheSize = 128;
+#else
+constexpr size_t ItemRecreationCacheSize = 1024;
+#endif
+
+/** Recreated items, indexed by a hash of their key (an entry is replaced when another key maps to it). */
+std::unique_ptr<ItemRecreationCacheEntry[]> ItemRecreationCache;
+ItemRecreationCacheStats ItemRecreationStats;
+
+ItemRecreationKey MakeItemRecreationKey(const Player &player, _item_indexes idx, uint16_t icreateinfo, int iseed)
+{
+	ItemRecreationKey key {};
+	key.seed = iseed;
+	key.createInfo = icreateinfo;
+	key.idx = idx;
+	key.playerClass = player._pClass;
+	key.baseStrength = player._pBaseStr;
+	key.baseMagic = player._pBaseMag;
+	key.baseDexterity = player._pBaseDex;
+	key.baseVitality = player._pBaseVit;
+	key.maxHPBase = player._pMaxHPBase;
+	key.maxManaBase = player._pMaxManaBase;
+	key.multiplayer = gbIsMultiplayer;
+	key.showAnimation = MyPlayer != nullptr && MyPlayer->pLvlLoad == 0;
+
+	const bool isTownOrUseful = (icreateinfo & CF_UNIQUE) == 0 && ((icreateinfo & CF_TOWN) != 0 || (icreateinfo & CF_USEFUL) == CF_USEFUL);
+	if (!gbIsMultiplayer && (icreateinfo & CF_UNIQUE) == 0 && !isTownOrUseful) {
+		for (size_t i = 0; i < key.uniqueItemFlags.size(); i++)
+			key.uniqueItemFlags[i] = UniqueItemFlags[i];
+	}
+	return key;
+}
+
+ItemRecreationCacheEntry &GetItemRecreationCacheEntry(const ItemRecreationKey &key)
+{
+	if (ItemRecreationCache == nullptr)
+		ItemRecreationCache = std::make_unique<ItemRecreationCacheEntry[]>(ItemRecreationCacheSize);
+	const uint32_t hash = static_cast<uint32_t>(key.seed) * 2654435761U ^ (key.createInfo * 40503U) ^ (static_cast<uint32_t>(key.idx) << 16);
+	return ItemRecreationCache[(hash ^ (hash >> 16)) % ItemRecreationCacheSize];
+}
+
 } // namespace
 
+bool ItemStatKey::operator==(const ItemStatKey &other) const
+{
+	return type == other.type
+	    && IDidx == other.IDidx
+	    && seed == other.seed
+	    && createInfo == other.createInfo
+	    && identified == other.identified
+	    && statFlag == other.statFlag
+	    && durability == other.durability
+	    && minDamage == other.minDamage
+	    && maxDamage == other.maxDamage
+	    && armorClass == other.armorClass
+	    && bonusDamage == other.bonusDamage
+	    && bonusToHit == other.bonusToHit;
+}
+
+bool ItemStatContribution::operator==(const ItemStatContribution &other) const
+{
+	return minDamage == other.minDamage
+	    && maxDamage == other.maxDamage
+	    && armorClass == other.armorClass
+	    && bonusDamage == other.bonusDamage
+	    && bonusToHit == other.bonusToHit
+	    && bonusArmorClass == other.bonusArmorClass
+	    && strength == other.strength
+	    && magic == other.magic
+	    && dexterity == other.dexterity
+	    && vitality == other.vitality
+	    && fireResist == other.fireResist
+	    && lightningResist == other.lightningResist
+	    && magicResist == other.magicResist
+	    && damageMod == other.damageMod
+	    && getHit == other.getHit
+	    && lightRadius == other.lightRadius
+	    && hitPoints == other.hitPoints
+	    && mana == other.mana
+	    && spellLevels == other.spellLevels
+	    && enhancedAccuracy == other.enhancedAccuracy
+	    && fireMinDamage == other.fireMinDamage
+	    && fireMaxDamage == other.fireMaxDamage
+	    && lightningMinDamage == other.lightningMinDamage
+	    && lightningMaxDamage == other.lightningMaxDamage
+	    && flags == other.flags
+	    && damAcFlags == other.damAcFlags
+	    && spells == other.spells;
+}
+
 bool IsItemAvailable(int i)
 {
 	if (i < 0 || i > IDI_LAST)
@@ -2254,13 +2617,15 @@ void InitItemGFX()
 		*BufCopy(arglist, "items\\", ItemDropNames[i]) = '\0';
 		itemanims[i] = LoadCel(arglist, ItemAnimWidth);
 	}
+	// Cached items refer to the previous sprites.
+	ClearItemRecreationCache();
 	memset(UniqueItemFlags, 0, sizeof(UniqueItemFlags));
 }
 
 void InitItems()
 {
 	ActiveItemCount = 0;
-	memset(dItem, 0, sizeof(dItem));
+	FillTileLayer(dItem, 0);
 
 	for (auto &item : Items) {
 		item.clear();
@@ -2305,90 +2670,47 @@ void InitItems()
 
 void CalcPlrItemVals(Player &player, bool loadgfx)
 {
-	int mind = 0; // min damage
-	int maxd = 0; // max damage
-	int tac = 0;  // accuracy
-
-	int bdam = 0;   // bonus damage
-	int btohit = 0; // bonus chance to hit
-	int bac = 0;    // bonus accuracy
-
-	ItemSpecialEffect iflgs = ItemSpecialEffect::None; // item_special_effect flags
+	UpdateEquippedItemStats(player);
+	const ItemStatContribution &itemStats = player.equippedItemStats;
 
-	ItemSpecialEffectHf pDamAcFlags = ItemSpecialEffectHf::None;
+	int mind = itemStats.minDamage; // min damage
+	int maxd = itemStats.maxDamage; // max damage
+	int tac = itemStats.armorClass; // accuracy
 
-	int sadd = 0; // added strength
-	int madd = 0; // added magic
-	int dadd = 0; // added dexterity
-	int vadd = 0; // added vitality
+	int bdam = itemStats.bonusDamage;    // bonus damage
+	int btohit = itemStats.bonusToHit;   // bonus chance to hit
+	int bac = itemStats.bonusArmorClass; // bonus accuracy
 
-	uint64_t spl = 0; // bitarray for all enabled/active spells
+	ItemSpecialEffect iflgs = itemStats.flags; // item_special_effect flags
 
-	int fr = 0; // fire resistance
-	int lr = 0; // lightning resistance
-	int mr = 0; // magic resistance
+	ItemSpecialEffectHf pDamAcFlags = itemStats.damAcFlags;
 
-	int dmod = 0; // bonus damage mod?
-	int ghit = 0; // increased damage from enemies
+	int sadd = itemStats.strength;  // added strength
+	int madd = itemStats.magic;     // added magic
+	int dadd = itemStats.dexterity; // added dexterity
+	int vadd = itemStats.vitality;  // added vitality
 
-	int lrad = 10; // light radius
+	uint64_t spl = itemStats.spells; // bitarray for all enabled/active spells
 
-	int ihp = 0;   // increased HP
-	int imana = 0; // increased mana
+	int fr = itemStats.fireResist;      // fire resistance
+	int lr = itemStats.lightningResist; // lightning resistance
+	int mr = itemStats.magicResist;     // magic resistance
 
-	int spllvladd = 0; // increased spell level
-	int enac = 0;      // enhanced accuracy
+	int dmod = itemStats.damageMod; // bonus damage mod?
+	int ghit = itemStats.getHit;    // increased damage from enemies
 
-	int fmin = 0; // minimum fire damage
-	int fmax = 0; // maximum fire damage
-	int lmin = 0; // minimum lightning damage
-	int lmax = 0; // maximum lightning damage
+	int lrad = 10 + itemStats.lightRadius; // light radius
 
-	for (auto &item : player.InvBody) {
-		if (!item.isEmpty() && item._iStatFlag) {
+	int ihp = itemStats.hitPoints; // increased HP
+	int imana = itemStats.mana;    // increased mana
 
-			mind += item._iMinDam;
-			maxd += item._iMaxDam;
-			tac += item._iAC;
+	int spllvladd = itemStats.spellLevels; // increased spell level
+	int enac = itemStats.enhancedAccuracy; // enhanced accuracy
 
-			if (IsValidSpell(item._iSpell)) {
-				spl |= GetSpellBitmask(item._iSpell);
-			}
-
-			if (item._iMagical == ITEM_QUALITY_NORMAL || item._iIdentified) {
-				bdam += item._iPLDam;
-				btohit += item._iPLToHit;
-				if (item._iPLAC != 0) {
-					int tmpac = item._iAC;
-					tmpac *= item._iPLAC;
-					tmpac /= 100;
-					if (tmpac == 0)
-						tmpac = math::Sign(item._iPLAC);
-					bac += tmpac;
-				}
-				iflgs |= item._iFlags;
-				pDamAcFlags |= item._iDamAcFlags;
-				sadd += item._iPLStr;
-				madd += item._iPLMag;
-				dadd += item._iPLDex;
-				vadd += item._iPLVit;
-				fr += item._iPLFR;
-				lr += item._iPLLR;
-				mr += item._iPLMR;
-				dmod += item._iPLDamMod;
-				ghit += item._iPLGetHit;
-				lrad += item._iPLLight;
-				ihp += item._iPLHP;
-				imana += item._iPLMana;
-				spllvladd += item._iSplLvlAdd;
-				enac += item._iPLEnAc;
-				fmin += item._iFMinDam;
-				fmax += item._iFMaxDam;
-				lmin += item._iLMinDam;
-				lmax += item._iLMaxDam;
-			}
-		}
-	}
+	int fmin = itemStats.fireMinDamage;      // minimum fire damage
+	int fmax = itemStats.fireMaxDamage;      // maximum fire damage
+	int lmin = itemStats.lightningMinDamage; // minimum lightning damage
+	int lmax = itemStats.lightningMaxDamage; // maximum lightning damage
 
 	if (mind == 0 && maxd == 0) {
 		mind = 1;
@@ -3068,23 +3390,8 @@ void CreateTypeItem(Point position, bool onlygood, ItemType itemType, int imisc,
 	SetupBaseItem(position, idx, onlygood, sendmsg, delta);
 }
 
-void RecreateItem(const Player &player, Item &item, _item_indexes idx, uint16_t icreateinfo, int iseed, int ivalue)
+void RecreateItemUncached(const Player &player, Item &item, _item_indexes idx, uint16_t icreateinfo, int iseed)
 {
-	if (idx == IDI_GOLD) {
-		InitializeItem(item, IDI_GOLD);
-		item._iSeed = iseed;
-		item._iCreateInfo = icreateinfo;
-		item._ivalue = ivalue;
-		SetPlrHandGoldCurs(item);
-		return;
-	}
-
-	if (icreateinfo == 0) {
-		InitializeItem(item, idx);
-		item._iSeed = iseed;
-		return;
-	}
-
 	if ((icreateinfo & CF_UNIQUE) == 0) {
 		if ((icreateinfo & CF_TOWN) != 0) {
 			RecreateTownItem(player, item, idx, icreateinfo, iseed);
@@ -3112,6 +3419,67 @@ void RecreateItem(const Player &player, Item &item, _item_indexes idx, uint16_t
 	SetupAllItems(player, item, idx, iseed, level, uper, onlygood, recreate, pregen);
 }
 
+void RecreateItem(const Player &player, Item &item, _item_indexes idx, uint16_t icreateinfo, int iseed, int ivalue)
+{
+	if (idx == IDI_GOLD) {
+		InitializeItem(item, IDI_GOLD);
+		item._iSeed = iseed;
+		item._iCreateInfo = icreateinfo;
+		item._ivalue = ivalue;
+		SetPlrHandGoldCurs(item);
+		return;
+	}
+
+	if (icreateinfo == 0) {
+		InitializeItem(item, idx);
+		item._iSeed = iseed;
+		return;
+	}
+
+	const ItemRecreationKey key = MakeItemRecreationKey(player, idx, icreateinfo, iseed);
+	ItemRecreationCacheEntry &entry = GetItemRecreationCacheEntry(key);
+	if (entry.used && entry.key == key) {
+		ItemRecreationStats.hits++;
+		item = entry.item;
+		// Replay the side effects of generating the item.
+		if (entry.setsRngState)
+			SetRndSeed(entry.rngState);
+		if (item._iMagical == ITEM_QUALITY_UNIQUE)
+			UniqueItemFlags[item._iUid] = true;
+		return;
+	}
+
+	ItemRecreationStats.misses++;
+	if (entry.used)
+		ItemRecreationStats.evictions++;
+	const uint32_t rngStateBefore = GetLCGEngineState();
+	RecreateItemUncached(player, item, idx, icreateinfo, iseed);
+	entry.used = true;
+	entry.key = key;
+	entry.item = item;
+	entry.rngState = GetLCGEngineState();
+	entry.setsRngState = entry.rngState != rngStateBefore;
+}
+
+ItemRecreationCacheStats GetItemRecreationCacheStats()
+{
+	ItemRecreationCacheStats stats = ItemRecreationStats;
+	stats.capacity = ItemRecreationCacheSize;
+	stats.entries = 0;
+	if (ItemRecreationCache != nullptr) {
+		for (size_t i = 0; i < ItemRecreationCacheSize; i++) {
+			if (ItemRecreationCache[i].used)
+				stats.entries++;
+		}
+	}
+	return stats;
+}
+
+void ClearItemRecreationCache()
+{
+	ItemRecreationCache = nullptr;
+}
+
 void RecreateEar(Item &item, uint16_t ic, int iseed, uint8_t bCursval, string_view heroName)
 {
 	InitializeItem(item, IDI_EAR);
@@ -3337,6 +3705,7 @@ void FreeItemGFX()
 	for (auto &itemanim : itemanims) {
 		itemanim = std::nullopt;
 	}
+	ClearItemRecreationCache();
 }
 
 void GetItemFrm(Item &item)
@@ -12,6 +12,7 @@
 #include "engine/animationinfo.h"
 #include "engine/point.hpp"
 #include "itemdat.h"
+#include "levels/gendung.h"
 #include "monster.h"
 #include "utils/stdcompat/optional.hpp"
 #include "utils/string_or_view.hpp"
@@ -453,6 +454,72 @@ struct Item {
 	void updateRequiredStatsCacheForPlayer(const Player &player);
 };
 
+/**
+ * @brief What an equipped item adds to the stats of the player, see `CalcPlrItemVals`.
+ */
+struct ItemStatContribution {
+	int minDamage;
+	int maxDamage;
+	int armorClass;
+	int bonusDamage;
+	int bonusToHit;
+	int bonusArmorClass;
+	int strength;
+	int magic;
+	int dexterity;
+	int vitality;
+	int fireResist;
+	int lightningResist;
+	int magicResist;
+	int damageMod;
+	int getHit;
+	int lightRadius;
+	int hitPoints;
+	int mana;
+	int spellLevels;
+	int enhancedAccuracy;
+	int fireMinDamage;
+	int fireMaxDamage;
+	int lightningMinDamage;
+	int lightningMaxDamage;
+	/** @brief The flags and spells are combined with a bitwise or, they can't be taken back out of a sum. */
+	ItemSpecialEffect flags;
+	ItemSpecialEffectHf damAcFlags;
+	uint64_t spells;
+
+	bool operator==(const ItemStatContribution &other) const;
+	bool operator!=(const ItemStatContribution &other) const
+	{
+		return !(*this == other);
+	}
+};
+
+/**
+ * @brief Identifies an equipped item, along with the fields that shrines, oils and decay change in place.
+ *
+ * `UpdateEquippedItemStats` only recomputes the contribution of a slot whose key changed.
+ */
+struct ItemStatKey {
+	ItemType type;
+	_item_indexes IDidx;
+	int32_t seed;
+	uint16_t createInfo;
+	bool identified;
+	bool statFlag;
+	int durability;
+	uint8_t minDamage;
+	uint8_t maxDamage;
+	int16_t armorClass;
+	int16_t bonusDamage;
+	int16_t bonusToHit;
+
+	bool operator==(const ItemStatKey &other) const;
+	bool operator!=(const ItemStatKey &other) const
+	{
+		return !(*this == other);
+	}
+};
+
 struct ItemGetRecordStruct {
 	int32_t nSeed;
 	uint16_t wCI;
@@ -472,7 +539,7 @@ extern Item Items[MAXITEMS + 1];
 extern uint8_t ActiveItems[MAXITEMS];
 extern uint8_t ActiveItemCount;
 /** Contains the location of dropped items. */
-extern int8_t dItem[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(int8_t, dItem, item);
 extern bool ShowUniqueItemInfoBox;
 extern CornerStoneStruct CornerStone;
 extern bool UniqueItemFlags[128];
@@ -504,7 +571,34 @@ void SpawnItem(Monster &monster, Point position, bool sendmsg);
 void CreateRndItem(Point position, bool onlygood, bool sendmsg, bool delta);
 void CreateRndUseful(Point position, bool sendmsg);
 void CreateTypeItem(Point position, bool onlygood, ItemType itemType, int imisc, bool sendmsg, bool delta);
+
+/**
+ * @brief Counters of the cache used by `RecreateItem`.
+ */
+struct ItemRecreationCacheStats {
+	size_t hits;
+	size_t misses;
+	/** Number of misses that replaced another cached item. */
+	size_t evictions;
+	size_t entries;
+	size_t capacity;
+};
+
+/**
+ * @brief Generates the item identified by its seed and creation info again, as it is sent over the network and saved.
+ *
+ * Recently recreated items are cached, so recreating the same item again is a copy.
+ * @param item A cleared item (`item = {}`), it is overwritten as a whole when the item is cached
+ */
 void RecreateItem(const Player &player, Item &item, _item_indexes idx, uint16_t icreateinfo, int iseed, int ivalue);
+/**
+ * @brief Generates the item like `RecreateItem` without looking it up in or adding it to the cache.
+ *
+ * For callers that generate each item once, such as searches over many seeds. Doesn't handle gold or items without creation info.
+ */
+void RecreateItemUncached(const Player &player, Item &item, _item_indexes idx, uint16_t icreateinfo, int iseed);
+ItemRecreationCacheStats GetItemRecreationCacheStats();
+void ClearItemRecreationCache();
 void RecreateEar(Item &item, uint16_t ic, int iseed, uint8_t bCursval, string_view heroName);
 void CornerstoneSave();
 void CornerstoneLoad(Point position);
@@ -729,8 +729,9 @@ bool PlaceCryptStairs(lvl_entry entry)
 	position = PlaceMiniSet(currlevel != 21 ? L5STAIRSUPHF : L5STAIRSTOWN, DMAXX * DMAXY, true);
 	if (!position) {
 		success = false;
-	} else if (entry == ENTRY_MAIN || entry == ENTRY_TWARPDN) {
-		ViewPosition = position->megaToWorld() + Displacement { 3, 5 };
+	} else {
+		SetEntryViewPosition(entry, ENTRY_MAIN, position->megaToWorld() + Displacement { 3, 5 });
+		SetEntryViewPosition(entry, ENTRY_TWARPDN, position->megaToWorld() + Displacement { 3, 5 });
 	}
 
 	// Place stairs down
@@ -738,8 +739,8 @@ bool PlaceCryptStairs(lvl_entry entry)
 		position = PlaceMiniSet(L5STAIRSDOWN, DMAXX * DMAXY, true);
 		if (!position)
 			success = false;
-		else if (entry == ENTRY_PREV)
-			ViewPosition = position->megaToWorld() + Displacement { 3, 7 };
+		else
+			SetEntryViewPosition(entry, ENTRY_PREV, position->megaToWorld() + Displacement { 3, 7 });
 	}
 
 	return success;
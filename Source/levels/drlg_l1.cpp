@@ -1114,8 +1114,7 @@ bool PlaceCathedralStairs(lvl_entry entry)
 			DRLG_MRectTrans({ miniPosition + Displacement { 0, 2 }, { 5, 2 } });
 			TransVal = t;
 			Quests[Q_PWATER].position = miniPosition.megaToWorld() + Displacement { 5, 6 };
-			if (entry == ENTRY_RTNLVL)
-				ViewPosition = Quests[Q_PWATER].position;
+			SetEntryViewPosition(entry, ENTRY_RTNLVL, Quests[Q_PWATER].position);
 		}
 	}
 
@@ -1123,20 +1122,18 @@ bool PlaceCathedralStairs(lvl_entry entry)
 	position = PlaceMiniSet(L5STAIRSUP, DMAXX * DMAXY, true);
 	if (!position) {
 		return false;
-	} else if (entry == ENTRY_MAIN) {
-		ViewPosition = position->megaToWorld() + Displacement { 3, 4 };
 	}
+	SetEntryViewPosition(entry, ENTRY_MAIN, position->megaToWorld() + Displacement { 3, 4 });
 
 	// Place stairs down
 	if (Quests[Q_LTBANNER].IsAvailable()) {
-		if (entry == ENTRY_PREV)
-			ViewPosition = SetPiece.position.megaToWorld() + Displacement { 3, 11 };
+		SetEntryViewPosition(entry, ENTRY_PREV, SetPiece.position.megaToWorld() + Displacement { 3, 11 });
 	} else {
 		position = PlaceMiniSet(STAIRSDOWN, DMAXX * DMAXY, true);
 		if (!position) {
 			success = false;
-		} else if (entry == ENTRY_PREV) {
-			ViewPosition = position->megaToWorld() + Displacement { 3, 3 };
+		} else {
+			SetEntryViewPosition(entry, ENTRY_PREV, position->megaToWorld() + Displacement { 3, 3 });
 		}
 	}
 
@@ -1172,6 +1169,7 @@ void GenerateLevel(lvl_entry entry)
 		DRLG_InitTrans();
 
 		do {
+			DungeonGenerationAttempts++;
 			FirstRoom();
 		} while (FindArea() < minarea);
 
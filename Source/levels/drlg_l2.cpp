@@ -2635,23 +2635,20 @@ bool PlaceStairs(lvl_entry entry)
 	position = PlaceMiniSet(USTAIRS);
 	if (!position)
 		return false;
-	if (entry == ENTRY_MAIN)
-		ViewPosition = position->megaToWorld() + Displacement { 5, 4 };
+	SetEntryViewPosition(entry, ENTRY_MAIN, position->megaToWorld() + Displacement { 5, 4 });
 
 	// Place stairs down
 	position = PlaceMiniSet(DSTAIRS);
 	if (!position)
 		return false;
-	if (entry == ENTRY_PREV)
-		ViewPosition = position->megaToWorld() + Displacement { 4, 6 };
+	SetEntryViewPosition(entry, ENTRY_PREV, position->megaToWorld() + Displacement { 4, 6 });
 
 	// Place town warp stairs
 	if (currlevel == 5) {
 		position = PlaceMiniSet(WARPSTAIRS);
 		if (!position)
 			return false;
-		if (entry == ENTRY_TWARPDN)
-			ViewPosition = position->megaToWorld() + Displacement { 5, 4 };
+		SetEntryViewPosition(entry, ENTRY_TWARPDN, position->megaToWorld() + Displacement { 5, 4 });
 	}
 
 	return true;
@@ -2662,6 +2659,7 @@ void GenerateLevel(lvl_entry entry)
 	LoadQuestSetPieces();
 
 	while (true) {
+		DungeonGenerationAttempts++;
 		nRoomCnt = 0;
 		InitDungeonFlags();
 		DRLG_InitTrans();
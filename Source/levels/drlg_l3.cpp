@@ -1932,23 +1932,20 @@ bool PlaceCaveStairs(lvl_entry entry)
 	position = PlaceMiniSet(L3UP);
 	if (!position)
 		return false;
-	if (entry == ENTRY_MAIN)
-		ViewPosition = position->megaToWorld() + Displacement { 1, 3 };
+	SetEntryViewPosition(entry, ENTRY_MAIN, position->megaToWorld() + Displacement { 1, 3 });
 
 	// Place stairs down
 	position = PlaceMiniSet(L3DOWN);
 	if (!position)
 		return false;
-	if (entry == ENTRY_PREV)
-		ViewPosition = position->megaToWorld() + Displacement { 3, 1 };
+	SetEntryViewPosition(entry, ENTRY_PREV, position->megaToWorld() + Displacement { 3, 1 });
 
 	// Place town warp stairs
 	if (currlevel == 9) {
 		position = PlaceMiniSet(L3HOLDWARP);
 		if (!position)
 			return false;
-		if (entry == ENTRY_TWARPDN)
-			ViewPosition = position->megaToWorld() + Displacement { 1, 3 };
+		SetEntryViewPosition(entry, ENTRY_TWARPDN, position->megaToWorld() + Displacement { 1, 3 });
 	}
 
 	return true;
@@ -1962,16 +1959,15 @@ bool PlaceNestStairs(lvl_entry entry)
 	position = PlaceMiniSet(currlevel != 17 ? L6UP : L6HOLDWARP);
 	if (!position)
 		return false;
-	if (entry == ENTRY_MAIN || entry == ENTRY_TWARPDN)
-		ViewPosition = position->megaToWorld() + Displacement { 1, 3 };
+	SetEntryViewPosition(entry, ENTRY_MAIN, position->megaToWorld() + Displacement { 1, 3 });
+	SetEntryViewPosition(entry, ENTRY_TWARPDN, position->megaToWorld() + Displacement { 1, 3 });
 
 	// Place stairs down
 	if (currlevel != 20) {
 		position = PlaceMiniSet(L6DOWN);
 		if (!position)
 			return false;
-		if (entry == ENTRY_PREV)
-			ViewPosition = position->megaToWorld() + Displacement { 3, 1 };
+		SetEntryViewPosition(entry, ENTRY_PREV, position->megaToWorld() + Displacement { 3, 1 });
 	}
 
 	return true;
@@ -1991,6 +1987,7 @@ void GenerateLevel(lvl_entry entry)
 	LoadQuestSetPieces();
 
 	while (true) {
+		DungeonGenerationAttempts++;
 		InitDungeonFlags();
 		int x1 = GenerateRnd(20) + 10;
 		int y1 = GenerateRnd(20) + 10;
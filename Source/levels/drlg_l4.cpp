@@ -1083,21 +1083,18 @@ bool PlaceStairs(lvl_entry entry)
 	position = PlaceMiniSet(L4USTAIRS);
 	if (!position)
 		return false;
-	if (entry == ENTRY_MAIN)
-		ViewPosition = position->megaToWorld() + Displacement { 6, 6 };
+	SetEntryViewPosition(entry, ENTRY_MAIN, position->megaToWorld() + Displacement { 6, 6 });
 
 	if (currlevel != 15) {
 		// Place stairs down
 		if (currlevel != 16) {
 			if (Quests[Q_WARLORD].IsAvailable()) {
-				if (entry == ENTRY_PREV)
-					ViewPosition = SetPiece.position.megaToWorld() + Displacement { 7, 7 };
+				SetEntryViewPosition(entry, ENTRY_PREV, SetPiece.position.megaToWorld() + Displacement { 7, 7 });
 			} else {
 				position = PlaceMiniSet(L4DSTAIRS);
 				if (!position)
 					return false;
-				if (entry == ENTRY_PREV)
-					ViewPosition = position->megaToWorld() + Displacement { 7, 5 };
+				SetEntryViewPosition(entry, ENTRY_PREV, position->megaToWorld() + Displacement { 7, 5 });
 			}
 		}
 
@@ -1106,8 +1103,7 @@ bool PlaceStairs(lvl_entry entry)
 			position = PlaceMiniSet(L4TWARP);
 			if (!position)
 				return false;
-			if (entry == ENTRY_TWARPDN)
-				ViewPosition = position->megaToWorld() + Displacement { 6, 6 };
+			SetEntryViewPosition(entry, ENTRY_TWARPDN, position->megaToWorld() + Displacement { 6, 6 });
 		}
 	} else {
 		// Place hell gate
@@ -1115,8 +1111,7 @@ bool PlaceStairs(lvl_entry entry)
 		if (!position)
 			return false;
 		Quests[Q_DIABLO].position = *position;
-		if (entry == ENTRY_PREV)
-			ViewPosition = position->megaToWorld() + Displacement { 6, 5 };
+		SetEntryViewPosition(entry, ENTRY_PREV, position->megaToWorld() + Displacement { 6, 5 });
 	}
 
 	return true;
@@ -1131,6 +1126,7 @@ void GenerateLevel(lvl_entry entry)
 
 		constexpr size_t Minarea = 692;
 		do {
+			DungeonGenerationAttempts++;
 			InitDungeonFlags();
 			FirstRoom();
 			CloseOuterBorders();
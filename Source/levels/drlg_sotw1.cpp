@@ -549,9 +549,9 @@ bool PlaceStairs(lvl_entry entry)
 	std::optional<Point> stairsUp = PlaceMiniSet(STAIRSUP, DMAXX * DMAXY, false);
 	if (!stairsUp) {
 		return false;
-	} else if (entry == ENTRY_MAIN || entry == ENTRY_TWARPDN) {
-		ViewPosition = stairsUp->megaToWorld() + Displacement { 3, 3 };
 	}
+	SetEntryViewPosition(entry, ENTRY_MAIN, stairsUp->megaToWorld() + Displacement { 3, 3 });
+	SetEntryViewPosition(entry, ENTRY_TWARPDN, stairsUp->megaToWorld() + Displacement { 3, 3 });
 
 	// Prevent sairs from being within 30 tiles radious of each other
 	SetPieceRoom = WorldTileRectangle { stairsUp->megaToWorld() + Displacement { 2, 3 }, 30 };
@@ -560,9 +560,8 @@ bool PlaceStairs(lvl_entry entry)
 	std::optional<Point> stairsDown = PlaceMiniSet(STAIRSDOWN, DMAXX * DMAXY, false);
 	if (!stairsDown) {
 		return false;
-	} else if (entry == ENTRY_PREV) {
-		ViewPosition = stairsDown->megaToWorld() + Displacement { 2, 2 };
 	}
+	SetEntryViewPosition(entry, ENTRY_PREV, stairsDown->megaToWorld() + Displacement { 2, 2 });
 
 	SetPieceRoom = { { 0, 0 }, { 0, 0 } };
 
@@ -577,6 +576,7 @@ void GenerateLevel(lvl_entry entry)
 		DRLG_InitTrans();
 
 		do {
+			DungeonGenerationAttempts++;
 			FirstRoom();
 
 		} while (FindArea() < minarea);
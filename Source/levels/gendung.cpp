@@ -10,6 +10,7 @@
 #include "levels/drlg_l3.h"
 #include "levels/drlg_l4.h"
 #include "levels/drlg_sotw1.h"
+#include "levels/layout_cache.h"
 #include "levels/town.h"
 #include "lighting.h"
 #include "options.h"
@@ -35,20 +36,28 @@ bool setlevel;
 _setlevels setlvlnum;
 dungeon_type setlvltype;
 Point ViewPosition;
+std::array<std::optional<Point>, ENTRY_TWARPUP + 1> EntryViewPositions;
 uint_fast8_t MicroTileLen;
 int8_t TransVal;
 bool TransList[256];
+uint32_t TransListVersion;
+#ifdef DEVILUTIONX_PACKED_DUNGEON_TILES
+DungeonTile dTiles[MAXDUNX][MAXDUNY];
+#else
 uint16_t dPiece[MAXDUNX][MAXDUNY];
-MICROS DPieceMicros[MAXTILES];
 int8_t dTransVal[MAXDUNX][MAXDUNY];
 char dLight[MAXDUNX][MAXDUNY];
-char dPreLight[MAXDUNX][MAXDUNY];
 DungeonFlag dFlags[MAXDUNX][MAXDUNY];
 int8_t dPlayer[MAXDUNX][MAXDUNY];
 int16_t dMonster[MAXDUNX][MAXDUNY];
 int8_t dCorpse[MAXDUNX][MAXDUNY];
 int8_t dObject[MAXDUNX][MAXDUNY];
 int8_t dSpecial[MAXDUNX][MAXDUNY];
+#endif
+MICROS DPieceMicros[MAXTILES];
+char dPreLight[MAXDUNX][MAXDUNY];
+uint32_t DungeonLayoutVersion;
+uint32_t DungeonGenerationAttempts;
 int themeCount;
 THEME_LOC themeLoc[MAXTHEMES];
 
@@ -334,14 +343,14 @@ void FindTransparencyValues(Point floor, uint8_t floorID)
 
 void InitGlobals()
 {
-	memset(dFlags, 0, sizeof(dFlags));
-	memset(dPlayer, 0, sizeof(dPlayer));
-	memset(dMonster, 0, sizeof(dMonster));
-	memset(dCorpse, 0, sizeof(dCorpse));
-	memset(dItem, 0, sizeof(dItem));
-	memset(dObject, 0, sizeof(dObject));
-	memset(dSpecial, 0, sizeof(dSpecial));
-	memset(dLight, DisableLighting || leveltype == DTYPE_TOWN ? 0 : 15, sizeof(dLight));
+	FillTileLayer(dFlags, DungeonFlag::None);
+	FillTileLayer(dPlayer, 0);
+	FillTileLayer(dMonster, 0);
+	FillTileLayer(dCorpse, 0);
+	FillTileLayer(dItem, 0);
+	FillTileLayer(dObject, 0);
+	FillTileLayer(dSpecial, 0);
+	FillTileLayer(dLight, DisableLighting || leveltype == DTYPE_TOWN ? 0 : 15);
 
 	DRLG_InitTrans();
 
@@ -349,6 +358,7 @@ void InitGlobals()
 	dmaxPosition = WorldTilePosition(40, 40).megaToWorld();
 	SetPieceRoom = { { 0, 0 }, { 0, 0 } };
 	SetPiece = { { 0, 0 }, { 0, 0 } };
+	EntryViewPositions.fill(std::nullopt);
 }
 
 } // namespace
@@ -385,6 +395,11 @@ dungeon_type GetLevelType(int level)
 void CreateDungeon(uint32_t rseed, lvl_entry entry)
 {
 	InitGlobals();
+	DungeonGenerationAttempts = 0;
+
+	if (RestoreCachedLayout(rseed, entry))
+		return;
+	BeginLayoutCapture();
 
 	switch (leveltype) {
 	case DTYPE_TOWN:
@@ -412,6 +427,14 @@ void CreateDungeon(uint32_t rseed, lvl_entry entry)
 	}
 
 	Make_SetPC(SetPiece);
+	CacheLayout(rseed);
+}
+
+void SetEntryViewPosition(lvl_entry entry, lvl_entry placedFor, Point position)
+{
+	EntryViewPositions[placedFor] = position;
+	if (entry == placedFor)
+		ViewPosition = position;
 }
 
 bool TileHasAny(int tileId, TileProperties property)
@@ -506,8 +529,9 @@ void SetDungeonMicros()
 
 void DRLG_InitTrans()
 {
-	memset(dTransVal, 0, sizeof(dTransVal));
+	FillTileLayer(dTransVal, 0);
 	memset(TransList, 0, sizeof(TransList));
+	TransListVersion++;
 	TransVal = 1;
 }
 
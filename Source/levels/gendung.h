@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 
@@ -138,6 +139,76 @@ struct MICROS {
 	uint16_t mt[16];
 };
 
+#ifdef DEVILUTIONX_PACKED_DUNGEON_TILES
+/**
+ * @brief The state of a single tile, for the layout where each tile's state is kept together.
+ *
+ * Only the state read together while rendering and moving is included, `dPreLight` stays a separate array.
+ */
+struct DungeonTile {
+	uint16_t piece;
+	int16_t monster;
+	DungeonFlag flags;
+	char light;
+	int8_t transVal;
+	int8_t player;
+	int8_t object;
+	int8_t item;
+	int8_t corpse;
+	int8_t special;
+};
+
+extern DVL_API_FOR_TEST DungeonTile dTiles[MAXDUNX][MAXDUNY];
+
+/**
+ * @brief One field of `dTiles`, indexed like a `[MAXDUNX][MAXDUNY]` array so that `dMonster[x][y]` works with either layout.
+ */
+template <typename T, T DungeonTile::*Field>
+struct DungeonTileLayer {
+	struct Column {
+		DungeonTile *tiles;
+
+		DVL_ALWAYS_INLINE T &operator[](int y) const
+		{
+			return tiles[y].*Field;
+		}
+	};
+
+	DVL_ALWAYS_INLINE Column operator[](int x) const
+	{
+		return { dTiles[x] };
+	}
+};
+
+#define DVL_DUNGEON_TILE_LAYER(type, name, field) constexpr DungeonTileLayer<type, &DungeonTile::field> name {}
+#else
+#define DVL_DUNGEON_TILE_LAYER(type, name, field) extern DVL_API_FOR_TEST type name[MAXDUNX][MAXDUNY]
+#endif
+
+/**
+ * @brief Sets every tile of a layer such as `dMonster` to `value`.
+ */
+template <typename Layer, typename T>
+void FillTileLayer(Layer &layer, T value)
+{
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++)
+			layer[x][y] = value;
+	}
+}
+
+/**
+ * @brief Copies every tile of the `source` layer to the `destination` layer, such as `dLight` to `dPreLight`.
+ */
+template <typename Destination, typename Source>
+void CopyTileLayer(Destination &destination, const Source &source)
+{
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++)
+			destination[x][y] = source[x][y];
+	}
+}
+
 struct ShadowStruct {
 	uint8_t strig;
 	uint8_t s1;
@@ -184,44 +255,60 @@ extern _setlevels setlvlnum;
 extern dungeon_type setlvltype;
 /** Specifies the player viewpoint X,Y-coordinates of the map. */
 extern DVL_API_FOR_TEST Point ViewPosition;
+/** The view positions the generator placed for each way of entering the level, such as the stairs up for `ENTRY_MAIN`. */
+extern std::array<std::optional<Point>, ENTRY_TWARPUP + 1> EntryViewPositions;
 extern uint_fast8_t MicroTileLen;
 extern int8_t TransVal;
 /** Specifies the active transparency indices. */
 extern bool TransList[256];
+/**
+ * Incremented whenever `TransList` changes, so that cached render data derived from it can be rebuilt.
+ */
+extern uint32_t TransListVersion;
 /** Contains the piece IDs of each tile on the map. */
-extern DVL_API_FOR_TEST uint16_t dPiece[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(uint16_t, dPiece, piece);
 /** Map of micros that comprises a full tile for any given dungeon piece. */
 extern MICROS DPieceMicros[MAXTILES];
 /** Specifies the transparency at each coordinate of the map. */
-extern DVL_API_FOR_TEST int8_t dTransVal[MAXDUNX][MAXDUNY];
-extern char dLight[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(int8_t, dTransVal, transVal);
+DVL_DUNGEON_TILE_LAYER(char, dLight, light);
 extern char dPreLight[MAXDUNX][MAXDUNY];
 /** Holds various information about dungeon tiles, @see DungeonFlag */
-extern DungeonFlag dFlags[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(DungeonFlag, dFlags, flags);
 
 /** Contains the player numbers (players array indices) of the map. */
-extern int8_t dPlayer[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(int8_t, dPlayer, player);
 /**
  * Contains the NPC numbers of the map. The NPC number represents a
  * towner number (towners array index) in Tristram and a monster number
  * (monsters array index) in the dungeon.
  */
-extern int16_t dMonster[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(int16_t, dMonster, monster);
 /**
  * Contains the dead numbers (deads array indices) and dead direction of
  * the map, encoded as specified by the pseudo-code below.
  * dDead[x][y] & 0x1F - index of dead
  * dDead[x][y] >> 0x5 - direction
  */
-extern DVL_API_FOR_TEST int8_t dCorpse[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(int8_t, dCorpse, corpse);
 /** Contains the object numbers (objects array indices) of the map. */
-extern DVL_API_FOR_TEST int8_t dObject[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(int8_t, dObject, object);
 /**
  * Contains the arch frame numbers of the map from the special tileset
  * (e.g. "levels/l1data/l1s"). Note, the special tileset of Tristram (i.e.
  * "levels/towndata/towns") contains trees rather than arches.
  */
-extern int8_t dSpecial[MAXDUNX][MAXDUNY];
+DVL_DUNGEON_TILE_LAYER(int8_t, dSpecial, special);
+/**
+ * Incremented whenever `dPiece` or `dSpecial` change after the level has been loaded,
+ * so that cached render data derived from them can be rebuilt.
+ */
+extern uint32_t DungeonLayoutVersion;
+/**
+ * Number of layouts the last `CreateDungeon` generated before one was accepted,
+ * for finding seeds that make the generators retry for a long time.
+ */
+extern DVL_API_FOR_TEST uint32_t DungeonGenerationAttempts;
 extern int themeCount;
 extern THEME_LOC themeLoc[MAXTHEMES];
 
@@ -230,8 +317,17 @@ std::optional<WorldTileSize> GetSizeForThemeRoom();
 #endif
 
 dungeon_type GetLevelType(int level);
+/**
+ * @brief Generates the layout of the current level, or restores it from the layout cache when enabled.
+ */
 void CreateDungeon(uint32_t rseed, lvl_entry entry);
 
+/**
+ * @brief Records the view position for entering the level by `placedFor`, and moves the view there when the level is entered that way.
+ * @param entry How the level is being entered
+ */
+void SetEntryViewPosition(lvl_entry entry, lvl_entry placedFor, Point position);
+
 constexpr bool InDungeonBounds(Point position)
 {
 	return position.x >= 0 && position.x < MAXDUNX && position.y >= 0 && position.y < MAXDUNY;
@@ -0,0 +1,247 @@
+/**
+ * @file levels/layout_cache.cpp
+ *
+ * Implementation of the cache of generated level layouts, which are reused when a level is entered again.
+ */
+#include "levels/layout_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "engine/random.hpp"
+#include "items.h"
+#include "levels/crypt.h"
+#include "levels/drlg_l4.h"
+#include "options.h"
+#include "quests.h"
+
+namespace devilution {
+
+namespace {
+
+/** About 1 MiB, enough for every level of a game. */
+constexpr size_t MaxCachedLayouts = 16;
+
+/**
+ * @brief State outside of the level that some generators write, such as quest positions.
+ */
+struct GeneratedGlobals {
+	std::array<Point, MAXQUESTS> questPositions;
+	int uberRow;
+	int uberCol;
+	Point cornerStone;
+	std::array<WorldTilePosition, 4> diabloQuads;
+};
+
+/** The quest state read by the generators, `_qactive`, `_qlevel`, `_qvar1` and `_qvar2` of each quest. */
+using QuestGenerationState = std::array<uint8_t, MAXQUESTS * 4>;
+
+/**
+ * @brief Everything `CreateDungeon` produces for a level.
+ */
+struct CachedLayout {
+	uint8_t level;
+	dungeon_type type;
+	uint32_t seed;
+	bool multiplayerQuests;
+	QuestGenerationState quests;
+	uint32_t lastUse;
+
+	uint8_t dungeon[DMAXX][DMAXY];
+	uint8_t pdungeon[DMAXX][DMAXY];
+	Bitset2d<DMAXX, DMAXY> dungeonMask;
+	Bitset2d<DMAXX, DMAXY> protectedTiles;
+	uint16_t piece[MAXDUNX][MAXDUNY];
+	int8_t transVal[MAXDUNX][MAXDUNY];
+	DungeonFlag flags[MAXDUNX][MAXDUNY];
+	int8_t special[MAXDUNX][MAXDUNY];
+	int8_t nextTransVal;
+	bool transList[256];
+	int themeCount;
+	THEME_LOC themeLoc[MAXTHEMES];
+	WorldTileRectangle setPiece;
+	WorldTileRectangle setPieceRoom;
+	std::array<std::optional<Point>, ENTRY_TWARPUP + 1> entryViewPositions;
+	WorldTilePosition dminPosition;
+	WorldTilePosition dmaxPosition;
+	uint32_t generationAttempts;
+	uint32_t rngState;
+	/** Only the globals the generator changed are restored, the others may have been set for another level since. */
+	GeneratedGlobals globalsBefore;
+	GeneratedGlobals globalsAfter;
+};
+
+std::vector<std::unique_ptr<CachedLayout>> Layouts;
+GeneratedGlobals GlobalsBeforeGeneration;
+uint32_t UseCounter;
+size_t Hits;
+size_t Misses;
+
+bool IsLayoutCacheEnabled()
+{
+	return *sgOptions.Gameplay.reuseLevelLayouts && leveltype != DTYPE_TOWN;
+}
+
+GeneratedGlobals GetGeneratedGlobals()
+{
+	GeneratedGlobals globals;
+	for (size_t i = 0; i < MAXQUESTS; i++)
+		globals.questPositions[i] = Quests[i].position;
+	globals.uberRow = UberRow;
+	globals.uberCol = UberCol;
+	globals.cornerStone = CornerStone.position;
+	globals.diabloQuads = { DiabloQuad1, DiabloQuad2, DiabloQuad3, DiabloQuad4 };
+	return globals;
+}
+
+template <typename T>
+void RestoreIfGenerated(T &global, const T &before, const T &after)
+{
+	if (after != before)
+		global = after;
+}
+
+void RestoreGeneratedGlobals(const GeneratedGlobals &before, const GeneratedGlobals &after)
+{
+	for (size_t i = 0; i < MAXQUESTS; i++)
+		RestoreIfGenerated(Quests[i].position, before.questPositions[i], after.questPositions[i]);
+	RestoreIfGenerated(UberRow, before.uberRow, after.uberRow);
+	RestoreIfGenerated(UberCol, before.uberCol, after.uberCol);
+	RestoreIfGenerated(CornerStone.position, before.cornerStone, after.cornerStone);
+	RestoreIfGenerated(DiabloQuad1, before.diabloQuads[0], after.diabloQuads[0]);
+	RestoreIfGenerated(DiabloQuad2, before.diabloQuads[1], after.diabloQuads[1]);
+	RestoreIfGenerated(DiabloQuad3, before.diabloQuads[2], after.diabloQuads[2]);
+	RestoreIfGenerated(DiabloQuad4, before.diabloQuads[3], after.diabloQuads[3]);
+}
+
+QuestGenerationState GetQuestGenerationState()
+{
+	QuestGenerationState state;
+	for (size_t i = 0; i < MAXQUESTS; i++) {
+		state[i * 4] = Quests[i]._qactive;
+		state[i * 4 + 1] = Quests[i]._qlevel;
+		state[i * 4 + 2] = Quests[i]._qvar1;
+		state[i * 4 + 3] = Quests[i]._qvar2;
+	}
+	return state;
+}
+
+bool IsSameLevel(const CachedLayout &layout, uint32_t seed)
+{
+	return layout.level == currlevel && layout.type == leveltype && layout.seed == seed;
+}
+
+} // namespace
+
+bool RestoreCachedLayout(uint32_t seed, lvl_entry entry)
+{
+	if (!IsLayoutCacheEnabled())
+		return false;
+
+	const QuestGenerationState quests = GetQuestGenerationState();
+	const bool multiplayerQuests = UseMultiplayerQuests();
+	const auto it = std::find_if(Layouts.begin(), Layouts.end(), [&](const std::unique_ptr<CachedLayout> &layout) {
+		return IsSameLevel(*layout, seed) && layout->multiplayerQuests == multiplayerQuests && layout->quests == quests;
+	});
+	if (it == Layouts.end()) {
+		Misses++;
+		return false;
+	}
+
+	const CachedLayout &layout = **it;
+	(*it)->lastUse = ++UseCounter;
+	Hits++;
+
+	memcpy(dungeon, layout.dungeon, sizeof(dungeon));
+	memcpy(pdungeon, layout.pdungeon, sizeof(pdungeon));
+	DungeonMask = layout.dungeonMask;
+	Protected = layout.protectedTiles;
+	CopyTileLayer(dPiece, layout.piece);
+	CopyTileLayer(dTransVal, layout.transVal);
+	CopyTileLayer(dFlags, layout.flags);
+	CopyTileLayer(dSpecial, layout.special);
+	TransVal = layout.nextTransVal;
+	memcpy(TransList, layout.transList, sizeof(TransList));
+	TransListVersion++;
+	themeCount = layout.themeCount;
+	std::copy_n(layout.themeLoc, MAXTHEMES, themeLoc);
+	SetPiece = layout.setPiece;
+	SetPieceRoom = layout.setPieceRoom;
+	EntryViewPositions = layout.entryViewPositions;
+	if (EntryViewPositions[entry])
+		ViewPosition = *EntryViewPositions[entry];
+	dminPosition = layout.dminPosition;
+	dmaxPosition = layout.dmaxPosition;
+	DungeonGenerationAttempts = layout.generationAttempts;
+	SetRndSeed(layout.rngState);
+	RestoreGeneratedGlobals(layout.globalsBefore, layout.globalsAfter);
+	return true;
+}
+
+void BeginLayoutCapture()
+{
+	GlobalsBeforeGeneration = GetGeneratedGlobals();
+}
+
+void CacheLayout(uint32_t seed)
+{
+	if (!IsLayoutCacheEnabled())
+		return;
+
+	// A layout generated from other quest states is outdated.
+	Layouts.erase(std::remove_if(Layouts.begin(), Layouts.end(), [&](const std::unique_ptr<CachedLayout> &layout) {
+		return IsSameLevel(*layout, seed);
+	}),
+	    Layouts.end());
+	if (Layouts.size() >= MaxCachedLayouts) {
+		Layouts.erase(std::min_element(Layouts.begin(), Layouts.end(), [](const std::unique_ptr<CachedLayout> &a, const std::unique_ptr<CachedLayout> &b) {
+			return a->lastUse < b->lastUse;
+		}));
+	}
+
+	auto layout = std::make_unique<CachedLayout>();
+	layout->level = currlevel;
+	layout->type = leveltype;
+	layout->seed = seed;
+	layout->multiplayerQuests = UseMultiplayerQuests();
+	layout->quests = GetQuestGenerationState();
+	layout->lastUse = ++UseCounter;
+
+	memcpy(layout->dungeon, dungeon, sizeof(dungeon));
+	memcpy(layout->pdungeon, pdungeon, sizeof(pdungeon));
+	layout->dungeonMask = DungeonMask;
+	layout->protectedTiles = Protected;
+	CopyTileLayer(layout->piece, dPiece);
+	CopyTileLayer(layout->transVal, dTransVal);
+	CopyTileLayer(layout->flags, dFlags);
+	CopyTileLayer(layout->special, dSpecial);
+	layout->nextTransVal = TransVal;
+	memcpy(layout->transList, TransList, sizeof(TransList));
+	layout->themeCount = themeCount;
+	std::copy_n(themeLoc, MAXTHEMES, layout->themeLoc);
+	layout->setPiece = SetPiece;
+	layout->setPieceRoom = SetPieceRoom;
+	layout->entryViewPositions = EntryViewPositions;
+	layout->dminPosition = dminPosition;
+	layout->dmaxPosition = dmaxPosition;
+	layout->generationAttempts = DungeonGenerationAttempts;
+	layout->rngState = GetLCGEngineState();
+	layout->globalsBefore = GlobalsBeforeGeneration;
+	layout->globalsAfter = GetGeneratedGlobals();
+	Layouts.push_back(std::move(layout));
+}
+
+void ClearLayoutCache()
+{
+	Layouts.clear();
+}
+
+LayoutCacheStats GetLayoutCacheStats()
+{
+	return { Layouts.size(), Hits, Misses, Layouts.size() * sizeof(CachedLayout) };
+}
+
+} // namespace devilution
@@ -0,0 +1,52 @@
+/**
+ * @file levels/layout_cache.h
+ *
+ * Interface of the cache of generated level layouts, which are reused when a level is entered again.
+ *
+ * Only levels that were already visited are cached, first visits still run the generator during the transition.
+ * Generating ahead of time would need the generators to build into their own buffers: they write the same
+ * globals (`dungeon`, `dPiece`, `dFlags`, `TransList`, `themeLoc`, quest positions, ...) the current level is played from.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "levels/gendung.h"
+
+namespace devilution {
+
+/**
+ * @brief Counters of the level layout cache.
+ */
+struct LayoutCacheStats {
+	size_t layouts;
+	size_t hits;
+	size_t misses;
+	/** Bytes held by the cached layouts. */
+	size_t memoryUsed;
+};
+
+/**
+ * @brief Restores the layout generated earlier for the current level from the same seed and quest state.
+ *
+ * Called by `CreateDungeon` once the level is cleared, in place of running the generator. The layout doesn't
+ * depend on how the level is entered, the view is moved to the position the generator placed for `entry`.
+ * @return Whether a cached layout was restored
+ */
+bool RestoreCachedLayout(uint32_t seed, lvl_entry entry);
+
+/**
+ * @brief Records the state outside of the level that the generators may change, called before generating.
+ */
+void BeginLayoutCapture();
+
+/**
+ * @brief Keeps the layout that was just generated for the current level.
+ */
+void CacheLayout(uint32_t seed);
+
+void ClearLayoutCache();
+LayoutCacheStats GetLayoutCacheStats();
+
+} // namespace devilution
@@ -68,6 +68,7 @@ void FillTile(int xx, int yy, int t)
 	dPiece[xx + 1][yy + 0] = SDL_SwapLE16(mega.micro2);
 	dPiece[xx + 0][yy + 1] = SDL_SwapLE16(mega.micro3);
 	dPiece[xx + 1][yy + 1] = SDL_SwapLE16(mega.micro4);
+	DungeonLayoutVersion++;
 }
 
 /**
@@ -124,6 +125,7 @@ void TownCloseHive()
 	dPiece[86][61] = 0x17;
 	dPiece[85][62] = 0x12;
 	dPiece[84][64] = 0x117;
+	DungeonLayoutVersion++;
 }
 
 /**
@@ -141,6 +143,7 @@ void TownCloseGrave()
 	dPiece[37][24] = 0x531;
 	dPiece[35][21] = 0x53a;
 	dPiece[34][21] = 0x53b;
+	DungeonLayoutVersion++;
 }
 
 void InitTownPieces()
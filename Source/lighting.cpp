@@ -6,11 +6,13 @@
 #include "lighting.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "automap.h"
 #include "diablo.h"
 #include "engine/load_file.hpp"
 #include "player.h"
+#include "utils/profiler.hpp"
 
 namespace devilution {
 
@@ -23,6 +25,8 @@ int ActiveLightCount;
 std::array<uint8_t, LIGHTSIZE> LightTables;
 bool DisableLighting;
 bool UpdateLighting;
+uint32_t LightingVersion;
+uint32_t LightTablesVersion;
 
 namespace {
 
@@ -326,8 +330,10 @@ void DoVision(Point position, int radius, MapExplorationType doAutomap, bool vis
 					break;
 
 				int8_t trans = dTransVal[crawl.x][crawl.y];
-				if (trans != 0)
+				if (trans != 0 && !TransList[trans]) {
 					TransList[trans] = true;
+					TransListVersion++;
+				}
 			}
 		}
 	}
@@ -516,19 +522,21 @@ void MakeLightTable()
 			}
 		}
 	}
+	LightTablesVersion++;
 }
 
 #ifdef _DEBUG
 void ToggleLighting()
 {
 	DisableLighting = !DisableLighting;
+	LightingVersion++;
 
 	if (DisableLighting) {
-		memset(dLight, 0, sizeof(dLight));
+		FillTileLayer(dLight, 0);
 		return;
 	}
 
-	memcpy(dLight, dPreLight, sizeof(dLight));
+	CopyTileLayer(dLight, dPreLight);
 	for (const Player &player : Players) {
 		if (player.plractive && player.isOnActiveLevel()) {
 			DoLighting(player.position.tile, player._pLightRad, -1);
@@ -641,6 +649,7 @@ void ChangeLight(int i, Point position, int r)
 
 void ProcessLightList()
 {
+	DVL_PROFILE_ZONE("ProcessLightList");
 	if (DisableLighting) {
 		return;
 	}
@@ -672,6 +681,7 @@ void ProcessLightList()
 				i++;
 			}
 		}
+		LightingVersion++;
 	}
 
 	UpdateLighting = false;
@@ -679,7 +689,7 @@ void ProcessLightList()
 
 void SavePreLighting()
 {
-	memcpy(dPreLight, dLight, sizeof(dPreLight));
+	CopyTileLayer(dPreLight, dLight);
 }
 
 void InitVision()
@@ -691,6 +701,7 @@ void InitVision()
 	for (int i = 0; i < TransVal; i++) {
 		TransList[i] = false;
 	}
+	TransListVersion++;
 }
 
 int AddVision(Point position, int r, bool mine)
@@ -758,6 +769,10 @@ void ProcessVisionList()
 			vision._lunflag = false;
 		}
 	}
+	// The rooms in view are usually the same as before, so only report a change if the list differs afterwards.
+	bool previousTransList[256];
+	memcpy(previousTransList, TransList, sizeof(TransList));
+	const uint32_t transListVersion = TransListVersion;
 	for (int i = 0; i < TransVal; i++) {
 		TransList[i] = false;
 	}
@@ -801,12 +816,21 @@ void ProcessVisionList()
 		}
 	} while (delflag);
 
+	TransListVersion = transListVersion;
+	if (memcmp(previousTransList, TransList, sizeof(TransList)) != 0)
+		TransListVersion++;
+
 	dovision = false;
 }
 
+bool IsLightTableColorCycling()
+{
+	return leveltype == DTYPE_HELL;
+}
+
 void lighting_color_cycling()
 {
-	if (leveltype != DTYPE_HELL) {
+	if (!IsLightTableColorCycling()) {
 		return;
 	}
 
@@ -822,6 +846,7 @@ void lighting_color_cycling()
 		*tbl = col;
 		tbl += 225;
 	}
+	LightTablesVersion++;
 }
 
 } // namespace devilution
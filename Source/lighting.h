@@ -53,6 +53,10 @@ constexpr char LightsMax = 15;
 extern std::array<uint8_t, LIGHTSIZE> LightTables;
 extern bool DisableLighting;
 extern bool UpdateLighting;
+/** Incremented whenever `dLight` changes, so that cached render data derived from it can be rebuilt. */
+extern uint32_t LightingVersion;
+/** Incremented whenever `LightTables` change, e.g. by color cycling. */
+extern uint32_t LightTablesVersion;
 
 void DoLighting(Point position, int nRadius, int Lnum);
 void DoUnVision(Point position, int nRadius);
@@ -75,6 +79,10 @@ int AddVision(Point position, int r, bool mine);
 void ChangeVisionRadius(int id, int r);
 void ChangeVisionXY(int id, Point position);
 void ProcessVisionList();
+/**
+ * @brief Whether `lighting_color_cycling` changes the light tables on the current level.
+ */
+bool IsLightTableColorCycling();
 void lighting_color_cycling();
 
 constexpr int MaxCrawlRadius = 18;
@@ -5,10 +5,12 @@
  */
 #include "loadsave.h"
 
+#include <algorithm>
 #include <climits>
 #include <cstring>
 #include <numeric>
 #include <unordered_map>
+#include <utility>
 
 #include <SDL.h>
 #include <fmt/core.h>
@@ -34,6 +36,7 @@
 #include "stores.h"
 #include "utils/endian.hpp"
 #include "utils/language.h"
+#include "utils/sdl_ptrs.h"
 
 namespace devilution {
 
@@ -104,6 +107,12 @@ public:
 			m_buffer_ = nullptr;
 	}
 
+	LoadHelper(std::unique_ptr<byte[]> buffer, size_t size)
+	    : m_buffer_(std::move(buffer))
+	    , m_size_(size)
+	{
+	}
+
 	bool IsValid(size_t size = 1)
 	{
 		return m_buffer_ != nullptr
@@ -162,27 +171,24 @@ public:
 };
 
 class SaveHelper {
-	SaveWriter &m_mpqWriter;
+	SaveSnapshot &m_snapshot;
 	const char *m_szFileName_;
 	std::unique_ptr<byte[]> m_buffer_;
 	size_t m_cur_ = 0;
 	size_t m_capacity_;
 
 public:
-	SaveHelper(SaveWriter &mpqWriter, const char *szFileName, size_t bufferLen)
-	    : m_mpqWriter(mpqWriter)
+	/**
+	 * @param bufferLen Initial size of the buffer, it grows as needed
+	 */
+	SaveHelper(SaveSnapshot &snapshot, const char *szFileName, size_t bufferLen)
+	    : m_snapshot(snapshot)
 	    , m_szFileName_(szFileName)
 	    , m_buffer_(new byte[bufferLen])
 	    , m_capacity_(bufferLen)
 	{
 	}
 
-	bool IsValid(size_t len = 1)
-	{
-		return m_buffer_ != nullptr
-		    && m_capacity_ >= (m_cur_ + len);
-	}
-
 	template <typename T>
 	constexpr void Skip(size_t count = 1)
 	{
@@ -191,19 +197,36 @@ public:
 
 	void Skip(size_t len)
 	{
+		Reserve(len);
 		std::memset(&m_buffer_[m_cur_], 0, len);
 		m_cur_ += len;
 	}
 
 	void WriteBytes(const void *bytes, size_t len)
 	{
-		if (!IsValid(len))
-			return;
-
+		Reserve(len);
 		memcpy(&m_buffer_[m_cur_], bytes, len);
 		m_cur_ += len;
 	}
 
+	/**
+	 * @brief Number of bytes written so far.
+	 */
+	size_t Tell() const
+	{
+		return m_cur_;
+	}
+
+	/**
+	 * @brief Overwrites a value written (or skipped) earlier.
+	 */
+	template <class T>
+	void PatchLE(size_t offset, T value)
+	{
+		value = SwapLE(value);
+		memcpy(&m_buffer_[offset], &value, sizeof(value));
+	}
+
 	template <class T>
 	void WriteLE(T value)
 	{
@@ -220,7 +243,20 @@ public:
 
 	~SaveHelper()
 	{
-		m_mpqWriter.WriteFile(m_szFileName_, m_buffer_.get(), m_cur_);
+		m_snapshot.WriteFile(m_szFileName_, std::move(m_buffer_), m_cur_);
+	}
+
+private:
+	void Reserve(size_t len)
+	{
+		if (m_capacity_ >= m_cur_ + len)
+			return;
+
+		const size_t capacity = std::max(m_capacity_ * 2, m_cur_ + len);
+		std::unique_ptr<byte[]> buffer { new byte[capacity] };
+		memcpy(buffer.get(), m_buffer_.get(), m_cur_);
+		m_buffer_ = std::move(buffer);
+		m_capacity_ = capacity;
 	}
 };
 
@@ -893,17 +929,31 @@ void GetLevelNames(string_view prefix, char *out)
 	*fmt::format_to(out, "{}{}{:02d}", prefix, suf, num) = '\0';
 }
 
-void GetTempLevelNames(char *szTemp)
+void GetPermLevelNames(char *szPerm)
 {
-	return GetLevelNames("temp", szTemp);
+	return GetLevelNames("perm", szPerm);
 }
 
-void GetPermLevelNames(char *szPerm)
+/**
+ * @brief Opens the saved state of the current level, preferring the one cached in memory.
+ */
+LoadHelper OpenLevelFile()
 {
-	return GetLevelNames("perm", szPerm);
+	char szName[MaxMpqPathSize];
+	GetTempLevelNames(szName);
+
+	size_t cachedSize;
+	std::unique_ptr<byte[]> cachedLevel = pfile_read_cached_level(szName, &cachedSize);
+	if (cachedLevel != nullptr)
+		return LoadHelper(std::move(cachedLevel), cachedSize);
+
+	std::optional<SaveReader> archive = OpenSaveArchive(gSaveNumber);
+	if (!archive || !archive->HasFile(szName))
+		GetPermLevelNames(szName);
+	return LoadHelper(std::move(archive), szName);
 }
 
-bool LevelFileExists(SaveWriter &archive)
+bool LevelFileExists(SaveReader &archive)
 {
 	char szName[MaxMpqPathSize];
 
@@ -931,21 +981,28 @@ void LoadMatchingItems(LoadHelper &file, const int n, Item *pItem)
 	}
 }
 
+void LoadHeroItems(LoadHelper &file, Player &player)
+{
+	if (!file.IsValid())
+		return;
+
+	LoadMatchingItems(file, NUM_INVLOC, player.InvBody);
+	LoadMatchingItems(file, InventoryGridCells, player.InvList);
+	LoadMatchingItems(file, MaxBeltItems, player.SpdList);
+}
+
 /**
  * @brief Loads items on the current dungeon floor
  * @param file interface to the save file
  * @param savedItemCount how many items to read from the save file
  */
-void LoadDroppedItems(LoadHelper &file, size_t savedItemCount)
+void LoadActiveItems(LoadHelper &file, size_t savedItemCount)
 {
-	// Skip loading ActiveItems and AvailableItems, the indices are initialised below based on the number of valid items
-	file.Skip<uint8_t>(MAXITEMS * 2);
-
 	// Reset ActiveItems, the Items array will be populated from the start
 	std::iota(ActiveItems, ActiveItems + MAXITEMS, 0);
 	ActiveItemCount = 0;
 	// Clear dItem so we can populate valid drop locations
-	memset(dItem, 0, sizeof(dItem));
+	FillTileLayer(dItem, 0);
 
 	for (size_t i = 0; i < savedItemCount; i++) {
 		Item &item = Items[ActiveItemCount];
@@ -960,9 +1017,11 @@ void LoadDroppedItems(LoadHelper &file, size_t savedItemCount)
 	}
 }
 
-int getHellfireLevelType(int type)
+void LoadDroppedItems(LoadHelper &file, size_t savedItemCount)
 {
-	return type;
+	// Skip loading ActiveItems and AvailableItems, the indices are initialised in LoadActiveItems based on the number of valid items
+	file.Skip<uint8_t>(MAXITEMS * 2);
+	LoadActiveItems(file, savedItemCount);
 }
 
 void SaveItem(SaveHelper &file, const Item &item)
@@ -1630,25 +1689,6 @@ void SaveDroppedItemLocations(SaveHelper &file, const std::unordered_map<uint8_t
 
 constexpr uint32_t VersionAdditionalMissiles = 0;
 
-void SaveAdditionalMissiles(SaveWriter &saveWriter)
-{
-	constexpr size_t BytesWrittenBySaveMissile = 180;
-	uint32_t missileCountAdditional = (Missiles.size() > MaxMissilesForSaveGame) ? static_cast<uint32_t>(Missiles.size() - MaxMissilesForSaveGame) : 0;
-	SaveHelper file(saveWriter, "additionalMissiles", sizeof(uint32_t) + sizeof(uint32_t) + (missileCountAdditional * BytesWrittenBySaveMissile));
-
-	file.WriteLE<uint32_t>(VersionAdditionalMissiles);
-	file.WriteLE<uint32_t>(missileCountAdditional);
-
-	if (missileCountAdditional > 0) {
-		auto it = Missiles.cbegin();
-		// std::list::const_iterator doesn't provide operator+() :/ using std::advance to get past the missiles we've already saved
-		std::advance(it, MaxMissilesForSaveGame);
-		for (; it != Missiles.cend(); it++) {
-			SaveMissile(&file, *it);
-		}
-	}
-}
-
 void LoadAdditionalMissiles()
 {
 	LoadHelper file(OpenSaveArchive(gSaveNumber), "additionalMissiles");
@@ -1669,194 +1709,833 @@ void LoadAdditionalMissiles()
 	}
 }
 
-const int DiabloItemSaveSize = 368;
-const int HellfireItemSaveSize = 372;
-
-} // namespace
+/** Magic number of "game" files from before the sectioned format, see `LoadGameV1`. */
+constexpr uint32_t GameFileMagicV1 = LoadLE32("SOTW");
 
-void ConvertLevels(SaveWriter &saveWriter)
-{
-	// Backup current level state
-	bool tmpSetlevel = setlevel;
-	_setlevels tmpSetlvlnum = setlvlnum;
-	int tmpCurrlevel = currlevel;
-	dungeon_type tmpLeveltype = leveltype;
+/**
+ * @brief Magic number of "game" files written by `SaveGameData`.
+ *
+ * The magic number is followed by the number of sections and the table of contents,
+ * one entry of 4 `uint32_t` per section: id (`GameSection`), version, offset and size.
+ */
+constexpr uint32_t GameFileMagic = LoadLE32("SOT2");
 
-	gbSkipSync = true;
+/**
+ * @brief Sections of a "game" file, in the order they are written.
+ */
+enum class GameSection : uint8_t {
+	/** Current level, view position and level seeds. */
+	Level,
+	Player,
+	/** Quests and town portals. */
+	Quests,
+	/** Kill counts and the monsters of the current level. */
+	Monsters,
+	Missiles,
+	Objects,
+	/** Lights, vision and the light maps. */
+	Lighting,
+	/** Dropped items, unique item flags and the smith's premium items. */
+	Items,
+	/** dFlags, dPlayer, dMonster, dCorpse and dObject. */
+	Dungeon,
+	Automap,
+};
 
-	setlevel = false; // Convert regular levels
-	for (int i = 0; i < giNumberOfLevels; i++) {
-		currlevel = i;
-		if (!LevelFileExists(saveWriter))
-			continue;
+constexpr size_t NumGameSections = static_cast<size_t>(GameSection::Automap) + 1;
 
-		leveltype = GetLevelType(currlevel);
+/**
+ * @brief Versions of the sections written by this build.
+ *
+ * Bump a section's version when changing its layout, older versions are handled by its load function.
+ */
+constexpr uint32_t GameSectionVersions[NumGameSections] = {};
 
-		LoadLevel();
-		SaveLevel(saveWriter);
+/**
+ * @brief Reads the sections of a "game" file one at a time, only decompressing the parts of the file it needs.
+ */
+class GameSectionReader {
+public:
+	explicit GameSectionReader(std::optional<SaveReader> archive)
+	    : archive_(std::move(archive))
+	{
+		if (archive_)
+			stream_.reset(OpenArchiveStream(*archive_, "game"));
 	}
 
-	setlevel = true; // Convert quest levels
-	for (auto &quest : Quests) {
-		if (quest._qactive == QUEST_NOTAVAIL) {
-			continue;
-		}
+	// The stream refers to `archive_`.
+	GameSectionReader(GameSectionReader &&) = delete;
+	GameSectionReader &operator=(GameSectionReader &&) = delete;
 
-		leveltype = quest._qlvltype;
-		if (leveltype == DTYPE_NONE) {
-			continue;
+	/**
+	 * @brief Reads the table of contents.
+	 * @return false if the file does not exist or is not in the sectioned format
+	 */
+	bool ReadTableOfContents()
+	{
+		uint32_t header[2];
+		if (stream_ == nullptr || SDL_RWread(stream_.get(), header, sizeof(header), 1) != 1)
+			return false;
+		if (SwapLE(header[0]) != GameFileMagic)
+			return false;
+
+		const uint32_t numSections = SwapLE(header[1]);
+		for (uint32_t i = 0; i < numSections; i++) {
+			uint32_t entry[4];
+			if (SDL_RWread(stream_.get(), entry, sizeof(entry), 1) != 1)
+				return false;
+			const uint32_t id = SwapLE(entry[0]);
+			// Sections added by newer builds are skipped.
+			if (id >= NumGameSections)
+				continue;
+			sections_[id] = { true, SwapLE(entry[1]), SwapLE(entry[2]), SwapLE(entry[3]) };
 		}
+		return true;
+	}
 
-		setlvlnum = quest._qslvl;
-		if (!LevelFileExists(saveWriter))
-			continue;
+	/**
+	 * @brief Reads a section into memory, a missing section or one from a newer build is fatal.
+	 */
+	LoadHelper Read(GameSection section)
+	{
+		const Entry &entry = sections_[static_cast<size_t>(section)];
+		if (!entry.present || entry.version > GameSectionVersions[static_cast<size_t>(section)])
+			app_fatal(_("Invalid save file"));
 
-		LoadLevel();
-		SaveLevel(saveWriter);
+		std::unique_ptr<byte[]> buffer { new byte[entry.size] };
+		if (entry.size != 0) {
+			if (SDL_RWseek(stream_.get(), entry.offset, RW_SEEK_SET) < 0
+			    || SDL_RWread(stream_.get(), buffer.get(), entry.size, 1) != 1)
+				app_fatal(_("Unable to open save file archive"));
+		}
+		return LoadHelper(std::move(buffer), entry.size);
 	}
 
-	gbSkipSync = false;
+private:
+	struct Entry {
+		bool present;
+		uint32_t version;
+		uint32_t offset;
+		uint32_t size;
+	};
 
-	// Restore current level state
-	setlevel = tmpSetlevel;
-	setlvlnum = tmpSetlvlnum;
-	currlevel = tmpCurrlevel;
-	leveltype = tmpLeveltype;
-}
+	std::optional<SaveReader> archive_;
+	SDLRWopsUniquePtr stream_;
+	Entry sections_[NumGameSections] = {};
+};
 
-void RemoveInvalidItem(Item &item)
+void WriteLevelSection(SaveHelper &file)
 {
-	bool isInvalid = !IsItemAvailable(item.IDidx) || !IsUniqueAvailable(item._iUid);
+	file.WriteLE<uint8_t>(setlevel ? 1 : 0);
+	file.WriteLE<uint32_t>(setlvlnum);
+	file.WriteLE<uint32_t>(currlevel);
+	file.WriteLE<uint32_t>(leveltype);
+	file.WriteLE<int32_t>(ViewPosition.x);
+	file.WriteLE<int32_t>(ViewPosition.y);
+	file.WriteLE<uint8_t>(invflag ? 1 : 0);
+	file.WriteLE<uint8_t>(chrflag ? 1 : 0);
+	for (uint32_t seed : glSeedTbl)
+		file.WriteLE<uint32_t>(seed);
+}
 
-	if (false) {
-		isInvalid = isInvalid || (item._itype == ItemType::Staff && GetSpellStaffLevel(item._iSpell) == -1);
-		isInvalid = isInvalid || (item._iMiscId == IMISC_BOOK && GetSpellBookLevel(item._iSpell) == -1);
-		isInvalid = isInvalid || item._iDamAcFlags != ItemSpecialEffectHf::None;
-		isInvalid = isInvalid || item._iPrePower > IPL_LASTDIABLO;
-		isInvalid = isInvalid || item._iSufPower > IPL_LASTDIABLO;
-	}
+void ReadLevelSection(LoadHelper &file, Point &viewPosition)
+{
+	setlevel = file.NextBool8();
+	setlvlnum = static_cast<_setlevels>(file.NextLE<uint32_t>());
+	currlevel = file.NextLE<uint32_t>();
+	leveltype = static_cast<dungeon_type>(file.NextLE<uint32_t>());
+	if (!setlevel)
+		leveltype = GetLevelType(currlevel);
+	viewPosition.x = file.NextLE<int32_t>();
+	viewPosition.y = file.NextLE<int32_t>();
+	invflag = file.NextBool8();
+	chrflag = file.NextBool8();
+	for (uint32_t &seed : glSeedTbl)
+		seed = file.NextLE<uint32_t>();
+}
 
-	if (isInvalid) {
-		item.clear();
-	}
+void WritePlayerSection(SaveHelper &file)
+{
+	Player &myPlayer = *MyPlayer;
+	myPlayer.pDifficulty = sgGameInitInfo.nDifficulty;
+	SavePlayer(file, myPlayer);
 }
 
-_item_indexes RemapItemIdxFromDiablo(_item_indexes i)
+void ReadPlayerSection(LoadHelper &file)
 {
-	constexpr auto GetItemIdValue = [](int i) -> int {
-		if (i == IDI_SORCERER) {
-			return IDI_SORCERER_DIABLO;
-		}
-		if (i >= 156) {
-			i += 5; // Hellfire exclusive items
-		}
-		if (i >= 88) {
-			i += 1; // Scroll of Search
-		}
-		if (i >= 83) {
-			i += 4; // Oils
-		}
+	Player &myPlayer = *MyPlayer;
 
-		return i;
-	};
+	LoadPlayer(file, myPlayer);
 
-	return static_cast<_item_indexes>(GetItemIdValue(i));
+	sgGameInitInfo.nDifficulty = myPlayer.pDifficulty;
+	if (sgGameInitInfo.nDifficulty < DIFF_NORMAL || sgGameInitInfo.nDifficulty > DIFF_HELL)
+		sgGameInitInfo.nDifficulty = DIFF_NORMAL;
 }
 
-_item_indexes RemapItemIdxToDiablo(_item_indexes i)
+void WriteQuestsSection(SaveHelper &file)
 {
-	constexpr auto GetItemIdValue = [](int i) -> int {
-		if (i == IDI_SORCERER_DIABLO) {
-			return IDI_SORCERER;
-		}
-		if ((i >= 83 && i <= 86) || i == 92 || i >= 161) {
-			return -1; // Hellfire exclusive items
-		}
-		if (i >= 93) {
-			i -= 1; // Scroll of Search
-		}
-		if (i >= 87) {
-			i -= 4; // Oils
-		}
-
-		return i;
-	};
+	for (int i = 0; i < MAXPORTAL; i++)
+		SavePortal(&file, i);
+	file.WriteLE<uint32_t>(giNumberQuests);
+	for (int i = 0; i < giNumberQuests; i++)
+		SaveQuest(&file, i);
+}
 
-	return static_cast<_item_indexes>(GetItemIdValue(i));
+void ReadQuestsSection(LoadHelper &file)
+{
+	for (int i = 0; i < MAXPORTAL; i++)
+		LoadPortal(&file, i);
+	// Quests added by newer builds are at the end and can be left unread.
+	const uint32_t savedQuests = std::min<uint32_t>(file.NextLE<uint32_t>(), giNumberQuests);
+	for (uint32_t i = 0; i < savedQuests; i++)
+		LoadQuest(&file, i);
 }
 
-_item_indexes RemapItemIdxFromSpawn(_item_indexes i)
+void WriteMonstersSection(SaveHelper &file)
 {
-	constexpr auto GetItemIdValue = [](int i) {
-		if (i >= 62) {
-			i += 9; // Medium and heavy armors
-		}
-		if (i >= 96) {
-			i += 1; // Scroll of Stone Curse
-		}
-		if (i >= 98) {
-			i += 1; // Scroll of Guardian
-		}
-		if (i >= 99) {
-			i += 1; // Scroll of ...
-		}
-		if (i >= 101) {
-			i += 1; // Scroll of Golem
-		}
-		if (i >= 102) {
-			i += 1; // Scroll of None
-		}
-		if (i >= 104) {
-			i += 1; // Scroll of Apocalypse
-		}
+	for (int monstkill : MonsterKillCounts)
+		file.WriteLE<int32_t>(monstkill);
+	file.WriteLE<uint32_t>(static_cast<uint32_t>(ActiveMonsterCount));
 
-		return i;
-	};
+	if (leveltype == DTYPE_TOWN)
+		return;
 
-	return static_cast<_item_indexes>(GetItemIdValue(i));
+	for (int monsterId : ActiveMonsters)
+		file.WriteLE<int32_t>(monsterId);
+	for (size_t i = 0; i < ActiveMonsterCount; i++)
+		SaveMonster(&file, Monsters[ActiveMonsters[i]]);
 }
 
-_item_indexes RemapItemIdxToSpawn(_item_indexes i)
+void ReadMonstersSection(LoadHelper &file)
 {
-	constexpr auto GetItemIdValue = [](int i) {
-		if (i >= 104) {
-			i -= 1; // Scroll of Apocalypse
-		}
-		if (i >= 102) {
-			i -= 1; // Scroll of None
-		}
-		if (i >= 101) {
-			i -= 1; // Scroll of Golem
-		}
-		if (i >= 99) {
-			i -= 1; // Scroll of ...
-		}
-		if (i >= 98) {
-			i -= 1; // Scroll of Guardian
-		}
-		if (i >= 96) {
-			i -= 1; // Scroll of Stone Curse
-		}
-		if (i >= 71) {
-			i -= 9; // Medium and heavy armors
-		}
+	for (int &monstkill : MonsterKillCounts)
+		monstkill = file.NextLE<int32_t>();
+	ActiveMonsterCount = file.NextLE<uint32_t>();
 
-		return i;
-	};
+	if (leveltype == DTYPE_TOWN)
+		return;
 
-	return static_cast<_item_indexes>(GetItemIdValue(i));
+	for (int &monsterId : ActiveMonsters)
+		monsterId = file.NextLE<int32_t>();
+	for (size_t i = 0; i < ActiveMonsterCount; i++)
+		LoadMonster(&file, Monsters[ActiveMonsters[i]]);
+	for (size_t i = 0; i < ActiveMonsterCount; i++)
+		SyncPackSize(Monsters[ActiveMonsters[i]]);
 }
 
-bool IsHeaderValid(uint32_t magicNumber)
+void WriteMissilesSection(SaveHelper &file)
 {
-	return magicNumber == LoadLE32("SOTW");
+	// Missiles in town are not saved, town portals are restored from the portal data.
+	if (leveltype == DTYPE_TOWN) {
+		file.WriteLE<uint32_t>(0);
+		return;
+	}
+
+	file.WriteLE<uint32_t>(static_cast<uint32_t>(Missiles.size()));
+	for (const Missile &missile : Missiles)
+		SaveMissile(&file, missile);
 }
 
-// Returns the size of the hotkeys file with the number of hotkeys passed and if a header with the number of hotkeys is present in the file
-size_t HotkeysSize(size_t nHotkeys = NumHotkeys)
+void ReadMissilesSection(LoadHelper &file)
 {
-	//     header            spells                         spell types                    active spell      active spell type
-	return sizeof(uint8_t) + (nHotkeys * sizeof(int32_t)) + (nHotkeys * sizeof(uint8_t)) + sizeof(int32_t) + sizeof(uint8_t);
+	const uint32_t savedMissiles = file.NextLE<uint32_t>();
+	for (uint32_t i = 0; i < savedMissiles; i++)
+		LoadMissile(&file);
+}
+
+void WriteObjectsSection(SaveHelper &file)
+{
+	file.WriteLE<int32_t>(ActiveObjectCount);
+
+	if (leveltype == DTYPE_TOWN)
+		return;
+
+	for (int objectId : ActiveObjects)
+		file.WriteLE(static_cast<int8_t>(objectId));
+	for (int objectId : AvailableObjects)
+		file.WriteLE(static_cast<int8_t>(objectId));
+	for (int i = 0; i < ActiveObjectCount; i++)
+		SaveObject(file, Objects[ActiveObjects[i]]);
+}
+
+void ReadObjectsSection(LoadHelper &file)
+{
+	ActiveObjectCount = file.NextLE<int32_t>();
+
+	if (leveltype == DTYPE_TOWN)
+		return;
+
+	for (int &objectId : ActiveObjects)
+		objectId = file.NextLE<int8_t>();
+	for (int &objectId : AvailableObjects)
+		objectId = file.NextLE<int8_t>();
+	for (int i = 0; i < ActiveObjectCount; i++)
+		LoadObject(file, Objects[ActiveObjects[i]]);
+	for (int i = 0; i < ActiveObjectCount; i++)
+		SyncObjectAnim(Objects[ActiveObjects[i]]);
+}
+
+void WriteLightingSection(SaveHelper &file)
+{
+	if (leveltype != DTYPE_TOWN) {
+		file.WriteLE<int32_t>(ActiveLightCount);
+		for (uint8_t lightId : ActiveLights)
+			file.WriteLE<uint8_t>(lightId);
+		for (int i = 0; i < ActiveLightCount; i++)
+			SaveLighting(&file, &Lights[ActiveLights[i]]);
+
+		file.WriteLE<int32_t>(VisionId);
+		file.WriteLE<int32_t>(VisionCount);
+		for (int i = 0; i < VisionCount; i++)
+			SaveLighting(&file, &VisionList[i]);
+	}
+
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<int8_t>(dLight[i][j]);
+	}
+
+	if (leveltype != DTYPE_TOWN) {
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+				file.WriteLE<int8_t>(dPreLight[i][j]);
+		}
+	}
+}
+
+void ReadLightingSection(LoadHelper &file)
+{
+	if (leveltype != DTYPE_TOWN) {
+		ActiveLightCount = file.NextLE<int32_t>();
+		for (uint8_t &lightId : ActiveLights)
+			lightId = file.NextLE<uint8_t>();
+		for (int i = 0; i < ActiveLightCount; i++)
+			LoadLighting(&file, &Lights[ActiveLights[i]]);
+
+		VisionId = file.NextLE<int32_t>();
+		VisionCount = file.NextLE<int32_t>();
+		for (int i = 0; i < VisionCount; i++)
+			LoadLighting(&file, &VisionList[i]);
+	}
+
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dLight[i][j] = file.NextLE<int8_t>();
+	}
+
+	if (leveltype != DTYPE_TOWN) {
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+				dPreLight[i][j] = file.NextLE<int8_t>();
+		}
+	}
+}
+
+void WriteItemsSection(SaveHelper &file)
+{
+	// Unlike the level files, no dItem map is written, LoadActiveItems rebuilds it from the item positions.
+	file.WriteLE<uint32_t>(ActiveItemCount);
+	for (uint8_t i = 0; i < ActiveItemCount; i++)
+		SaveItem(file, Items[ActiveItems[i]]);
+
+	for (bool uniqueItemFlag : UniqueItemFlags)
+		file.WriteLE<uint8_t>(uniqueItemFlag ? 1 : 0);
+
+	file.WriteLE<int32_t>(numpremium);
+	file.WriteLE<int32_t>(premiumlevel);
+	file.WriteLE<uint32_t>(giNumberOfSmithPremiumItems);
+	for (int i = 0; i < giNumberOfSmithPremiumItems; i++)
+		SaveItem(file, premiumitems[i]);
+}
+
+void ReadItemsSection(LoadHelper &file)
+{
+	LoadActiveItems(file, file.NextLE<uint32_t>());
+
+	for (bool &uniqueItemFlag : UniqueItemFlags)
+		uniqueItemFlag = file.NextBool8();
+
+	numpremium = file.NextLE<int32_t>();
+	premiumlevel = file.NextLE<int32_t>();
+	const uint32_t savedPremiumItems = std::min<uint32_t>(file.NextLE<uint32_t>(), giNumberOfSmithPremiumItems);
+	for (uint32_t i = 0; i < savedPremiumItems; i++)
+		LoadPremium(file, i);
+}
+
+void WriteDungeonSection(SaveHelper &file)
+{
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<uint8_t>(static_cast<uint8_t>(dFlags[i][j] & DungeonFlag::SavedFlags));
+	}
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<int8_t>(dPlayer[i][j]);
+	}
+
+	if (leveltype == DTYPE_TOWN)
+		return;
+
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<int32_t>(dMonster[i][j]);
+	}
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<int8_t>(dCorpse[i][j]);
+	}
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<int8_t>(dObject[i][j]);
+	}
+}
+
+void ReadDungeonSection(LoadHelper &file)
+{
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dFlags[i][j] = static_cast<DungeonFlag>(file.NextLE<uint8_t>()) & DungeonFlag::LoadedFlags;
+	}
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dPlayer[i][j] = file.NextLE<int8_t>();
+	}
+
+	if (leveltype == DTYPE_TOWN)
+		return;
+
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dMonster[i][j] = file.NextLE<int32_t>();
+	}
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dCorpse[i][j] = file.NextLE<int8_t>();
+	}
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dObject[i][j] = file.NextLE<int8_t>();
+	}
+}
+
+void WriteAutomapSection(SaveHelper &file)
+{
+	file.WriteLE<uint8_t>(AutomapActive ? 1 : 0);
+	file.WriteLE<int32_t>(AutoMapScale);
+
+	if (leveltype == DTYPE_TOWN)
+		return;
+
+	for (int j = 0; j < DMAXY; j++) {
+		for (int i = 0; i < DMAXX; i++) // NOLINT(modernize-loop-convert)
+			file.WriteLE<uint8_t>(AutomapView[i][j]);
+	}
+}
+
+void ReadAutomapSection(LoadHelper &file)
+{
+	AutomapActive = file.NextBool8();
+	AutoMapScale = file.NextLE<int32_t>();
+
+	if (leveltype == DTYPE_TOWN)
+		return;
+
+	for (int j = 0; j < DMAXY; j++) {
+		for (int i = 0; i < DMAXX; i++) // NOLINT(modernize-loop-convert)
+			AutomapView[i][j] = file.NextLE<uint8_t>();
+	}
+}
+
+/**
+ * @brief Loads a "game" file in the sectioned format, see `SaveGameData`.
+ */
+void LoadGameSections(GameSectionReader &sections, bool firstflag)
+{
+	Point viewPosition;
+	{
+		LoadHelper file = sections.Read(GameSection::Level);
+		ReadLevelSection(file, viewPosition);
+	}
+	{
+		LoadHelper file = sections.Read(GameSection::Player);
+		ReadPlayerSection(file);
+	}
+	{
+		LoadHelper file = sections.Read(GameSection::Quests);
+		ReadQuestsSection(file);
+	}
+
+	Player &myPlayer = *MyPlayer;
+	LoadGameLevel(firstflag, ENTRY_LOAD);
+	SyncInitPlr(myPlayer);
+	SyncPlrAnim(myPlayer);
+	ViewPosition = viewPosition;
+
+	const std::pair<GameSection, void (*)(LoadHelper &)> levelSections[] = {
+		{ GameSection::Monsters, ReadMonstersSection },
+		{ GameSection::Missiles, ReadMissilesSection },
+		{ GameSection::Objects, ReadObjectsSection },
+		{ GameSection::Lighting, ReadLightingSection },
+		{ GameSection::Items, ReadItemsSection },
+		{ GameSection::Dungeon, ReadDungeonSection },
+		{ GameSection::Automap, ReadAutomapSection },
+	};
+	for (const auto &[section, read] : levelSections) {
+		LoadHelper file = sections.Read(section);
+		read(file);
+	}
+}
+
+/**
+ * @brief Loads a "game" file from before the sectioned format, the next save converts it.
+ */
+void LoadGameV1(LoadHelper &file, bool firstflag)
+{
+	setlevel = file.NextBool8();
+	setlvlnum = static_cast<_setlevels>(file.NextBE<uint32_t>());
+	currlevel = file.NextBE<uint32_t>();
+	leveltype = static_cast<dungeon_type>(file.NextBE<uint32_t>());
+	if (!setlevel)
+		leveltype = GetLevelType(currlevel);
+	int viewX = file.NextBE<int32_t>();
+	int viewY = file.NextBE<int32_t>();
+	invflag = file.NextBool8();
+	chrflag = file.NextBool8();
+	int tmpNummonsters = file.NextBE<int32_t>();
+	auto savedItemCount = file.NextBE<uint32_t>();
+	int tmpNummissiles = file.NextBE<int32_t>();
+	int tmpNobjects = file.NextBE<int32_t>();
+
+	for (uint8_t i = 0; i < NUMLEVELS; i++) {
+		glSeedTbl[i] = file.NextBE<uint32_t>();
+		file.Skip(4); // Skip loading gnLevelTypeTbl
+	}
+
+	Player &myPlayer = *MyPlayer;
+
+	LoadPlayer(file, myPlayer);
+
+	sgGameInitInfo.nDifficulty = myPlayer.pDifficulty;
+	if (sgGameInitInfo.nDifficulty < DIFF_NORMAL || sgGameInitInfo.nDifficulty > DIFF_HELL)
+		sgGameInitInfo.nDifficulty = DIFF_NORMAL;
+
+	for (int i = 0; i < giNumberQuests; i++)
+		LoadQuest(&file, i);
+	for (int i = 0; i < MAXPORTAL; i++)
+		LoadPortal(&file, i);
+
+	if (false) {
+		pfile_convert_levels();
+		RemoveEmptyInventory(myPlayer);
+	}
+
+	LoadGameLevel(firstflag, ENTRY_LOAD);
+	SyncInitPlr(myPlayer);
+	SyncPlrAnim(myPlayer);
+
+	ViewPosition = { viewX, viewY };
+	ActiveMonsterCount = tmpNummonsters;
+	ActiveObjectCount = tmpNobjects;
+
+	for (int &monstkill : MonsterKillCounts)
+		monstkill = file.NextBE<int32_t>();
+
+	if (leveltype != DTYPE_TOWN) {
+		for (int &monsterId : ActiveMonsters)
+			monsterId = file.NextBE<int32_t>();
+		for (size_t i = 0; i < ActiveMonsterCount; i++)
+			LoadMonster(&file, Monsters[ActiveMonsters[i]]);
+		for (size_t i = 0; i < ActiveMonsterCount; i++)
+			SyncPackSize(Monsters[ActiveMonsters[i]]);
+		// Skip ActiveMissiles
+		file.Skip<int8_t>(MaxMissilesForSaveGame);
+		// Skip AvailableMissiles
+		file.Skip<int8_t>(MaxMissilesForSaveGame);
+		for (int i = 0; i < tmpNummissiles; i++)
+			LoadMissile(&file);
+		for (int &objectId : ActiveObjects)
+			objectId = file.NextLE<int8_t>();
+		for (int &objectId : AvailableObjects)
+			objectId = file.NextLE<int8_t>();
+		for (int i = 0; i < ActiveObjectCount; i++)
+			LoadObject(file, Objects[ActiveObjects[i]]);
+		for (int i = 0; i < ActiveObjectCount; i++)
+			SyncObjectAnim(Objects[ActiveObjects[i]]);
+
+		ActiveLightCount = file.NextBE<int32_t>();
+
+		for (uint8_t &lightId : ActiveLights)
+			lightId = file.NextLE<uint8_t>();
+		for (int i = 0; i < ActiveLightCount; i++)
+			LoadLighting(&file, &Lights[ActiveLights[i]]);
+
+		VisionId = file.NextBE<int32_t>();
+		VisionCount = file.NextBE<int32_t>();
+
+		for (int i = 0; i < VisionCount; i++)
+			LoadLighting(&file, &VisionList[i]);
+	}
+
+	LoadDroppedItems(file, savedItemCount);
+
+	LoadAdditionalMissiles();
+
+	for (bool &uniqueItemFlag : UniqueItemFlags)
+		uniqueItemFlag = file.NextBool8();
+
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dLight[i][j] = file.NextLE<int8_t>();
+	}
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dFlags[i][j] = static_cast<DungeonFlag>(file.NextLE<uint8_t>()) & DungeonFlag::LoadedFlags;
+	}
+	for (int j = 0; j < MAXDUNY; j++) {
+		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+			dPlayer[i][j] = file.NextLE<int8_t>();
+	}
+
+	// skip dItem indexes, this gets populated in LoadDroppedItems
+	file.Skip<uint8_t>(MAXDUNX * MAXDUNY);
+
+	if (leveltype != DTYPE_TOWN) {
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+				dMonster[i][j] = file.NextBE<int32_t>();
+		}
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+				dCorpse[i][j] = file.NextLE<int8_t>();
+		}
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+				dObject[i][j] = file.NextLE<int8_t>();
+		}
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++)         // NOLINT(modernize-loop-convert)
+				dLight[i][j] = file.NextLE<int8_t>(); // BUGFIX: dLight got loaded already
+		}
+		for (int j = 0; j < MAXDUNY; j++) {
+			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
+				dPreLight[i][j] = file.NextLE<int8_t>();
+		}
+		for (int j = 0; j < DMAXY; j++) {
+			for (int i = 0; i < DMAXX; i++) // NOLINT(modernize-loop-convert)
+				AutomapView[i][j] = file.NextLE<uint8_t>();
+		}
+		file.Skip(MAXDUNX * MAXDUNY); // dMissile
+	}
+
+	numpremium = file.NextBE<int32_t>();
+	premiumlevel = file.NextBE<int32_t>();
+
+	for (int i = 0; i < giNumberOfSmithPremiumItems; i++)
+		LoadPremium(file, i);
+	if (false)
+		SpawnPremium(myPlayer);
+
+	AutomapActive = file.NextBool8();
+	AutoMapScale = file.NextBE<int32_t>();
+}
+
+const int DiabloItemSaveSize = 368;
+const int HellfireItemSaveSize = 372;
+
+} // namespace
+
+void GetTempLevelNames(char *szTemp)
+{
+	return GetLevelNames("temp", szTemp);
+}
+
+void ConvertLevels(SaveSnapshot &snapshot)
+{
+	std::optional<SaveReader> archive = OpenSaveArchive(gSaveNumber);
+	if (!archive)
+		return;
+
+	// Backup current level state
+	bool tmpSetlevel = setlevel;
+	_setlevels tmpSetlvlnum = setlvlnum;
+	int tmpCurrlevel = currlevel;
+	dungeon_type tmpLeveltype = leveltype;
+
+	gbSkipSync = true;
+
+	setlevel = false; // Convert regular levels
+	for (int i = 0; i < giNumberOfLevels; i++) {
+		currlevel = i;
+		if (!LevelFileExists(*archive))
+			continue;
+
+		leveltype = GetLevelType(currlevel);
+
+		LoadLevel();
+		SaveLevel(snapshot);
+	}
+
+	setlevel = true; // Convert quest levels
+	for (auto &quest : Quests) {
+		if (quest._qactive == QUEST_NOTAVAIL) {
+			continue;
+		}
+
+		leveltype = quest._qlvltype;
+		if (leveltype == DTYPE_NONE) {
+			continue;
+		}
+
+		setlvlnum = quest._qslvl;
+		if (!LevelFileExists(*archive))
+			continue;
+
+		LoadLevel();
+		SaveLevel(snapshot);
+	}
+
+	gbSkipSync = false;
+
+	// Restore current level state
+	setlevel = tmpSetlevel;
+	setlvlnum = tmpSetlvlnum;
+	currlevel = tmpCurrlevel;
+	leveltype = tmpLeveltype;
+}
+
+void RemoveInvalidItem(Item &item)
+{
+	bool isInvalid = !IsItemAvailable(item.IDidx) || !IsUniqueAvailable(item._iUid);
+
+	if (false) {
+		isInvalid = isInvalid || (item._itype == ItemType::Staff && GetSpellStaffLevel(item._iSpell) == -1);
+		isInvalid = isInvalid || (item._iMiscId == IMISC_BOOK && GetSpellBookLevel(item._iSpell) == -1);
+		isInvalid = isInvalid || item._iDamAcFlags != ItemSpecialEffectHf::None;
+		isInvalid = isInvalid || item._iPrePower > IPL_LASTDIABLO;
+		isInvalid = isInvalid || item._iSufPower > IPL_LASTDIABLO;
+	}
+
+	if (isInvalid) {
+		item.clear();
+	}
+}
+
+_item_indexes RemapItemIdxFromDiablo(_item_indexes i)
+{
+	constexpr auto GetItemIdValue = [](int i) -> int {
+		if (i == IDI_SORCERER) {
+			return IDI_SORCERER_DIABLO;
+		}
+		if (i >= 156) {
+			i += 5; // Hellfire exclusive items
+		}
+		if (i >= 88) {
+			i += 1; // Scroll of Search
+		}
+		if (i >= 83) {
+			i += 4; // Oils
+		}
+
+		return i;
+	};
+
+	return static_cast<_item_indexes>(GetItemIdValue(i));
+}
+
+_item_indexes RemapItemIdxToDiablo(_item_indexes i)
+{
+	constexpr auto GetItemIdValue = [](int i) -> int {
+		if (i == IDI_SORCERER_DIABLO) {
+			return IDI_SORCERER;
+		}
+		if ((i >= 83 && i <= 86) || i == 92 || i >= 161) {
+			return -1; // Hellfire exclusive items
+		}
+		if (i >= 93) {
+			i -= 1; // Scroll of Search
+		}
+		if (i >= 87) {
+			i -= 4; // Oils
+		}
+
+		return i;
+	};
+
+	return static_cast<_item_indexes>(GetItemIdValue(i));
+}
+
+_item_indexes RemapItemIdxFromSpawn(_item_indexes i)
+{
+	constexpr auto GetItemIdValue = [](int i) {
+		if (i >= 62) {
+			i += 9; // Medium and heavy armors
+		}
+		if (i >= 96) {
+			i += 1; // Scroll of Stone Curse
+		}
+		if (i >= 98) {
+			i += 1; // Scroll of Guardian
+		}
+		if (i >= 99) {
+			i += 1; // Scroll of ...
+		}
+		if (i >= 101) {
+			i += 1; // Scroll of Golem
+		}
+		if (i >= 102) {
+			i += 1; // Scroll of None
+		}
+		if (i >= 104) {
+			i += 1; // Scroll of Apocalypse
+		}
+
+		return i;
+	};
+
+	return static_cast<_item_indexes>(GetItemIdValue(i));
+}
+
+_item_indexes RemapItemIdxToSpawn(_item_indexes i)
+{
+	constexpr auto GetItemIdValue = [](int i) {
+		if (i >= 104) {
+			i -= 1; // Scroll of Apocalypse
+		}
+		if (i >= 102) {
+			i -= 1; // Scroll of None
+		}
+		if (i >= 101) {
+			i -= 1; // Scroll of Golem
+		}
+		if (i >= 99) {
+			i -= 1; // Scroll of ...
+		}
+		if (i >= 98) {
+			i -= 1; // Scroll of Guardian
+		}
+		if (i >= 96) {
+			i -= 1; // Scroll of Stone Curse
+		}
+		if (i >= 71) {
+			i -= 9; // Medium and heavy armors
+		}
+
+		return i;
+	};
+
+	return static_cast<_item_indexes>(GetItemIdValue(i));
+}
+
+bool IsHeaderValid(uint32_t magicNumber)
+{
+	return magicNumber == GameFileMagic || magicNumber == GameFileMagicV1;
+}
+
+// Returns the size of the hotkeys file with the number of hotkeys passed and if a header with the number of hotkeys is present in the file
+size_t HotkeysSize(size_t nHotkeys = NumHotkeys)
+{
+	//     header            spells                         spell types                    active spell      active spell type
+	return sizeof(uint8_t) + (nHotkeys * sizeof(int32_t)) + (nHotkeys * sizeof(uint8_t)) + sizeof(int32_t) + sizeof(uint8_t);
 }
 
 void LoadHotkeys()
@@ -1901,9 +2580,9 @@ void LoadHotkeys()
 	myPlayer._pRSplType = static_cast<SpellType>(file.NextLE<uint8_t>());
 }
 
-void SaveHotkeys(SaveWriter &saveWriter, const Player &player)
+void SaveHotkeys(SaveSnapshot &snapshot, const Player &player)
 {
-	SaveHelper file(saveWriter, "hotkeys", HotkeysSize());
+	SaveHelper file(snapshot, "hotkeys", HotkeysSize());
 
 	// Write the number of spell hotkeys
 	file.WriteLE<uint8_t>(static_cast<uint8_t>(NumHotkeys));
@@ -1924,12 +2603,13 @@ void SaveHotkeys(SaveWriter &saveWriter, const Player &player)
 void LoadHeroItems(Player &player)
 {
 	LoadHelper file(OpenSaveArchive(gSaveNumber), "heroitems");
-	if (!file.IsValid())
-		return;
+	LoadHeroItems(file, player);
+}
 
-	LoadMatchingItems(file, NUM_INVLOC, player.InvBody);
-	LoadMatchingItems(file, InventoryGridCells, player.InvList);
-	LoadMatchingItems(file, MaxBeltItems, player.SpdList);
+void LoadHeroItems(Player &player, std::unique_ptr<byte[]> data, size_t size)
+{
+	LoadHelper file(std::move(data), size);
+	LoadHeroItems(file, player);
 }
 
 constexpr uint8_t StashVersion = 0;
@@ -1987,13 +2667,6 @@ void LoadGame(bool firstflag)
 {
 	FreeGameMem();
 
-	LoadHelper file(OpenSaveArchive(gSaveNumber), "game");
-	if (!file.IsValid())
-		app_fatal(_("Unable to open save file archive"));
-
-	if (!IsHeaderValid(file.NextLE<uint32_t>()))
-		app_fatal(_("Invalid save file"));
-
 	if (true) {
 		giNumberOfLevels = 25;
 		giNumberQuests = 24;
@@ -2005,154 +2678,22 @@ void LoadGame(bool firstflag)
 		giNumberOfSmithPremiumItems = 6;
 	}
 
+	// Before opening the archive, so that removing them is done by the time it is read.
 	pfile_remove_temp_files();
 
-	setlevel = file.NextBool8();
-	setlvlnum = static_cast<_setlevels>(file.NextBE<uint32_t>());
-	currlevel = file.NextBE<uint32_t>();
-	leveltype = static_cast<dungeon_type>(file.NextBE<uint32_t>());
-	if (!setlevel)
-		leveltype = GetLevelType(currlevel);
-	int viewX = file.NextBE<int32_t>();
-	int viewY = file.NextBE<int32_t>();
-	invflag = file.NextBool8();
-	chrflag = file.NextBool8();
-	int tmpNummonsters = file.NextBE<int32_t>();
-	auto savedItemCount = file.NextBE<uint32_t>();
-	int tmpNummissiles = file.NextBE<int32_t>();
-	int tmpNobjects = file.NextBE<int32_t>();
-
-	for (uint8_t i = 0; i < NUMLEVELS; i++) {
-		glSeedTbl[i] = file.NextBE<uint32_t>();
-		file.Skip(4); // Skip loading gnLevelTypeTbl
-	}
-
-	Player &myPlayer = *MyPlayer;
-
-	LoadPlayer(file, myPlayer);
-
-	sgGameInitInfo.nDifficulty = myPlayer.pDifficulty;
-	if (sgGameInitInfo.nDifficulty < DIFF_NORMAL || sgGameInitInfo.nDifficulty > DIFF_HELL)
-		sgGameInitInfo.nDifficulty = DIFF_NORMAL;
-
-	for (int i = 0; i < giNumberQuests; i++)
-		LoadQuest(&file, i);
-	for (int i = 0; i < MAXPORTAL; i++)
-		LoadPortal(&file, i);
-
-	if (false) {
-		pfile_convert_levels();
-		RemoveEmptyInventory(myPlayer);
-	}
-
-	LoadGameLevel(firstflag, ENTRY_LOAD);
-	SyncInitPlr(myPlayer);
-	SyncPlrAnim(myPlayer);
-
-	ViewPosition = { viewX, viewY };
-	ActiveMonsterCount = tmpNummonsters;
-	ActiveObjectCount = tmpNobjects;
-
-	for (int &monstkill : MonsterKillCounts)
-		monstkill = file.NextBE<int32_t>();
-
-	if (leveltype != DTYPE_TOWN) {
-		for (int &monsterId : ActiveMonsters)
-			monsterId = file.NextBE<int32_t>();
-		for (size_t i = 0; i < ActiveMonsterCount; i++)
-			LoadMonster(&file, Monsters[ActiveMonsters[i]]);
-		for (size_t i = 0; i < ActiveMonsterCount; i++)
-			SyncPackSize(Monsters[ActiveMonsters[i]]);
-		// Skip ActiveMissiles
-		file.Skip<int8_t>(MaxMissilesForSaveGame);
-		// Skip AvailableMissiles
-		file.Skip<int8_t>(MaxMissilesForSaveGame);
-		for (int i = 0; i < tmpNummissiles; i++)
-			LoadMissile(&file);
-		for (int &objectId : ActiveObjects)
-			objectId = file.NextLE<int8_t>();
-		for (int &objectId : AvailableObjects)
-			objectId = file.NextLE<int8_t>();
-		for (int i = 0; i < ActiveObjectCount; i++)
-			LoadObject(file, Objects[ActiveObjects[i]]);
-		for (int i = 0; i < ActiveObjectCount; i++)
-			SyncObjectAnim(Objects[ActiveObjects[i]]);
-
-		ActiveLightCount = file.NextBE<int32_t>();
-
-		for (uint8_t &lightId : ActiveLights)
-			lightId = file.NextLE<uint8_t>();
-		for (int i = 0; i < ActiveLightCount; i++)
-			LoadLighting(&file, &Lights[ActiveLights[i]]);
-
-		VisionId = file.NextBE<int32_t>();
-		VisionCount = file.NextBE<int32_t>();
-
-		for (int i = 0; i < VisionCount; i++)
-			LoadLighting(&file, &VisionList[i]);
-	}
-
-	LoadDroppedItems(file, savedItemCount);
-
-	LoadAdditionalMissiles();
-
-	for (bool &uniqueItemFlag : UniqueItemFlags)
-		uniqueItemFlag = file.NextBool8();
-
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dLight[i][j] = file.NextLE<int8_t>();
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dFlags[i][j] = static_cast<DungeonFlag>(file.NextLE<uint8_t>()) & DungeonFlag::LoadedFlags;
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dPlayer[i][j] = file.NextLE<int8_t>();
-	}
-
-	// skip dItem indexes, this gets populated in LoadDroppedItems
-	file.Skip<uint8_t>(MAXDUNX * MAXDUNY);
+	GameSectionReader sections(OpenSaveArchive(gSaveNumber));
+	if (sections.ReadTableOfContents()) {
+		LoadGameSections(sections, firstflag);
+	} else {
+		LoadHelper file(OpenSaveArchive(gSaveNumber), "game");
+		if (!file.IsValid())
+			app_fatal(_("Unable to open save file archive"));
+		if (file.NextLE<uint32_t>() != GameFileMagicV1)
+			app_fatal(_("Invalid save file"));
 
-	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dMonster[i][j] = file.NextBE<int32_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dCorpse[i][j] = file.NextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dObject[i][j] = file.NextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)         // NOLINT(modernize-loop-convert)
-				dLight[i][j] = file.NextLE<int8_t>(); // BUGFIX: dLight got loaded already
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dPreLight[i][j] = file.NextLE<int8_t>();
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++) // NOLINT(modernize-loop-convert)
-				AutomapView[i][j] = file.NextLE<uint8_t>();
-		}
-		file.Skip(MAXDUNX * MAXDUNY); // dMissile
+		LoadGameV1(file, firstflag);
 	}
 
-	numpremium = file.NextBE<int32_t>();
-	premiumlevel = file.NextBE<int32_t>();
-
-	for (int i = 0; i < giNumberOfSmithPremiumItems; i++)
-		LoadPremium(file, i);
-	if (false)
-		SpawnPremium(myPlayer);
-
-	AutomapActive = file.NextBool8();
-	AutoMapScale = file.NextBE<int32_t>();
 	AutomapZoomReset();
 	ResyncQuests();
 
@@ -2175,10 +2716,10 @@ void LoadGame(bool firstflag)
 	gbProcessPlayers = IsDiabloAlive(!firstflag);
 }
 
-void SaveHeroItems(SaveWriter &saveWriter, Player &player)
+void SaveHeroItems(SaveSnapshot &snapshot, Player &player)
 {
 	size_t itemCount = static_cast<size_t>(NUM_INVLOC) + InventoryGridCells + MaxBeltItems;
-	SaveHelper file(saveWriter, "heroitems", itemCount * HellfireItemSaveSize + sizeof(uint8_t));
+	SaveHelper file(snapshot, "heroitems", itemCount * HellfireItemSaveSize + sizeof(uint8_t));
 
 	file.WriteLE<uint8_t>(1);
 
@@ -2190,7 +2731,7 @@ void SaveHeroItems(SaveWriter &saveWriter, Player &player)
 		SaveItem(file, item);
 }
 
-void SaveStash(SaveWriter &stashWriter)
+void SaveStash(SaveSnapshot &snapshot)
 {
 	const char *filename;
 	if (!gbIsMultiplayer)
@@ -2201,7 +2742,7 @@ void SaveStash(SaveWriter &stashWriter)
 	const int itemSize = HellfireItemSaveSize;
 
 	SaveHelper file(
-	    stashWriter,
+	    snapshot,
 	    filename,
 	    sizeof(uint8_t)
 	        + sizeof(uint32_t)
@@ -2247,12 +2788,8 @@ void SaveStash(SaveWriter &stashWriter)
 	file.WriteLE<uint32_t>(static_cast<uint32_t>(Stash.GetPage()));
 }
 
-void SaveGameData(SaveWriter &saveWriter)
+void SaveGameData(SaveSnapshot &snapshot)
 {
-	SaveHelper file(saveWriter, "game", 320 * 1024);
-
-	file.WriteLE<uint32_t>(LoadLE32("SOTW"));
-
 	if (true) {
 		giNumberOfLevels = 25;
 		giNumberQuests = 24;
@@ -2263,141 +2800,34 @@ void SaveGameData(SaveWriter &saveWriter)
 		giNumberOfSmithPremiumItems = 6;
 	}
 
-	file.WriteLE<uint8_t>(setlevel ? 1 : 0);
-	file.WriteBE<uint32_t>(setlvlnum);
-	file.WriteBE<uint32_t>(currlevel);
-	file.WriteBE<uint32_t>(getHellfireLevelType(leveltype));
-	file.WriteBE<int32_t>(ViewPosition.x);
-	file.WriteBE<int32_t>(ViewPosition.y);
-	file.WriteLE<uint8_t>(invflag ? 1 : 0);
-	file.WriteLE<uint8_t>(chrflag ? 1 : 0);
-	file.WriteBE<int32_t>(ActiveMonsterCount);
-	file.WriteBE<int32_t>(ActiveItemCount);
-	// ActiveMissileCount will be a value from 0-125 (for vanilla compatibility). Writing an unsigned value here to avoid
-	// warnings about casting from unsigned to signed, but there's no sign extension issues when reading this as a signed
-	// value later so it doesn't have to match in LoadGameData().
-	file.WriteBE<uint32_t>(static_cast<uint32_t>(std::min(Missiles.size(), MaxMissilesForSaveGame)));
-	file.WriteBE<int32_t>(ActiveObjectCount);
-
-	for (uint8_t i = 0; i < NUMLEVELS; i++) {
-		file.WriteBE<uint32_t>(glSeedTbl[i]);
-		file.WriteBE<int32_t>(getHellfireLevelType(GetLevelType(i)));
-	}
-
-	Player &myPlayer = *MyPlayer;
-	myPlayer.pDifficulty = sgGameInitInfo.nDifficulty;
-	SavePlayer(file, myPlayer);
-
-	for (int i = 0; i < giNumberQuests; i++)
-		SaveQuest(&file, i);
-	for (int i = 0; i < MAXPORTAL; i++)
-		SavePortal(&file, i);
-	for (int monstkill : MonsterKillCounts)
-		file.WriteBE<int32_t>(monstkill);
-
-	if (leveltype != DTYPE_TOWN) {
-		for (int monsterId : ActiveMonsters)
-			file.WriteBE<int32_t>(monsterId);
-		for (size_t i = 0; i < ActiveMonsterCount; i++)
-			SaveMonster(&file, Monsters[ActiveMonsters[i]]);
-		// Write ActiveMissiles
-		for (uint8_t activeMissile = 0; activeMissile < MaxMissilesForSaveGame; activeMissile++)
-			file.WriteLE<uint8_t>(activeMissile);
-		// Write AvailableMissiles
-		for (size_t availableMissiles = Missiles.size(); availableMissiles < MaxMissilesForSaveGame; availableMissiles++)
-			file.WriteLE(static_cast<uint8_t>(availableMissiles));
-		const size_t savedMissiles = std::min(Missiles.size(), MaxMissilesForSaveGame);
-		file.Skip<uint8_t>(savedMissiles);
-		// Write Missile Data
-		{
-			auto missilesEnd = Missiles.cbegin();
-			std::advance(missilesEnd, savedMissiles);
-			for (auto it = Missiles.cbegin(); it != missilesEnd; it++) {
-				SaveMissile(&file, *it);
-			}
-		}
-		for (int objectId : ActiveObjects)
-			file.WriteLE(static_cast<int8_t>(objectId));
-		for (int objectId : AvailableObjects)
-			file.WriteLE(static_cast<int8_t>(objectId));
-		for (int i = 0; i < ActiveObjectCount; i++)
-			SaveObject(file, Objects[ActiveObjects[i]]);
-
-		file.WriteBE<int32_t>(ActiveLightCount);
-
-		for (uint8_t lightId : ActiveLights)
-			file.WriteLE<uint8_t>(lightId);
-		for (int i = 0; i < ActiveLightCount; i++)
-			SaveLighting(&file, &Lights[ActiveLights[i]]);
-
-		file.WriteBE<int32_t>(VisionId);
-		file.WriteBE<int32_t>(VisionCount);
-
-		for (int i = 0; i < VisionCount; i++)
-			SaveLighting(&file, &VisionList[i]);
-	}
-
-	auto itemIndexes = SaveDroppedItems(file);
-
-	for (bool uniqueItemFlag : UniqueItemFlags)
-		file.WriteLE<uint8_t>(uniqueItemFlag ? 1 : 0);
-
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<int8_t>(dLight[i][j]);
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<uint8_t>(static_cast<uint8_t>(dFlags[i][j] & DungeonFlag::SavedFlags));
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			file.WriteLE<int8_t>(dPlayer[i][j]);
-	}
-
-	SaveDroppedItemLocations(file, itemIndexes);
-
-	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteBE<int32_t>(dMonster[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dCorpse[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dObject[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)       // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dLight[i][j]); // BUGFIX: dLight got saved already
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(dPreLight[i][j]);
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++) // NOLINT(modernize-loop-convert)
-				file.WriteLE<uint8_t>(AutomapView[i][j]);
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++)                                 // NOLINT(modernize-loop-convert)
-				file.WriteLE<int8_t>(TileContainsMissile({ i, j }) ? -1 : 0); // For backwards compatability
-		}
+	SaveHelper file(snapshot, "game", 64 * 1024);
+
+	file.WriteLE<uint32_t>(GameFileMagic);
+	file.WriteLE<uint32_t>(NumGameSections);
+	const size_t tableOfContents = file.Tell();
+	file.Skip<uint32_t>(4 * NumGameSections);
+
+	void (*const writers[NumGameSections])(SaveHelper &) = {
+		WriteLevelSection,
+		WritePlayerSection,
+		WriteQuestsSection,
+		WriteMonstersSection,
+		WriteMissilesSection,
+		WriteObjectsSection,
+		WriteLightingSection,
+		WriteItemsSection,
+		WriteDungeonSection,
+		WriteAutomapSection,
+	};
+	for (uint32_t section = 0; section < NumGameSections; section++) {
+		const size_t offset = file.Tell();
+		writers[section](file);
+		const size_t entry = tableOfContents + section * 4 * sizeof(uint32_t);
+		file.PatchLE<uint32_t>(entry, section);
+		file.PatchLE<uint32_t>(entry + sizeof(uint32_t), GameSectionVersions[section]);
+		file.PatchLE<uint32_t>(entry + 2 * sizeof(uint32_t), static_cast<uint32_t>(offset));
+		file.PatchLE<uint32_t>(entry + 3 * sizeof(uint32_t), static_cast<uint32_t>(file.Tell() - offset));
 	}
-
-	file.WriteBE<int32_t>(numpremium);
-	file.WriteBE<int32_t>(premiumlevel);
-
-	for (int i = 0; i < giNumberOfSmithPremiumItems; i++)
-		SaveItem(file, premiumitems[i]);
-
-	file.WriteLE<uint8_t>(AutomapActive ? 1 : 0);
-	file.WriteBE<int32_t>(AutoMapScale);
-
-	SaveAdditionalMissiles(saveWriter);
 }
 
 void SaveGame()
@@ -2407,7 +2837,7 @@ void SaveGame()
 	sfile_write_stash();
 }
 
-void SaveLevel(SaveWriter &saveWriter)
+void SaveLevel(SaveSnapshot &snapshot)
 {
 	Player &myPlayer = *MyPlayer;
 
@@ -2418,7 +2848,7 @@ void SaveLevel(SaveWriter &saveWriter)
 
 	char szName[MaxMpqPathSize];
 	GetTempLevelNames(szName);
-	SaveHelper file(saveWriter, szName, 256 * 1024);
+	SaveHelper file(snapshot, szName, 256 * 1024);
 
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
@@ -2483,12 +2913,7 @@ void SaveLevel(SaveWriter &saveWriter)
 
 void LoadLevel()
 {
-	char szName[MaxMpqPathSize];
-	std::optional<SaveReader> archive = OpenSaveArchive(gSaveNumber);
-	GetTempLevelNames(szName);
-	if (!archive || !archive->HasFile(szName))
-		GetPermLevelNames(szName);
-	LoadHelper file(std::move(archive), szName);
+	LoadHelper file = OpenLevelFile();
 	if (!file.IsValid())
 		app_fatal(_("Unable to open save file archive"));
 
@@ -21,6 +21,10 @@ _item_indexes RemapItemIdxToSpawn(_item_indexes i);
 bool IsHeaderValid(uint32_t magicNumber);
 void LoadHotkeys();
 void LoadHeroItems(Player &player);
+/**
+ * @brief Same as `LoadHeroItems(Player &)`, for the contents of a "heroitems" file that has been read already.
+ */
+void LoadHeroItems(Player &player, std::unique_ptr<byte[]> data, size_t size);
 /**
  * @brief Remove invalid inventory items from the inventory grid
  * @param player The player to remove invalid items from
@@ -32,14 +36,18 @@ void RemoveEmptyInventory(Player &player);
  * @param firstflag Can be set to false if we are simply reloading the current game
  */
 void LoadGame(bool firstflag);
-void SaveHotkeys(SaveWriter &saveWriter, const Player &player);
-void SaveHeroItems(SaveWriter &saveWriter, Player &player);
-void SaveGameData(SaveWriter &saveWriter);
+void SaveHotkeys(SaveSnapshot &snapshot, const Player &player);
+void SaveHeroItems(SaveSnapshot &snapshot, Player &player);
+void SaveGameData(SaveSnapshot &snapshot);
 void SaveGame();
-void SaveLevel(SaveWriter &saveWriter);
+void SaveLevel(SaveSnapshot &snapshot);
+/**
+ * @brief Name of the file `SaveLevel` writes for the current level.
+ */
+void GetTempLevelNames(char *szTemp);
 void LoadLevel();
-void ConvertLevels(SaveWriter &saveWriter);
+void ConvertLevels(SaveSnapshot &snapshot);
 void LoadStash();
-void SaveStash(SaveWriter &stashWriter);
+void SaveStash(SaveSnapshot &snapshot);
 
 } // namespace devilution
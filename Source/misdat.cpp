@@ -5,10 +5,9 @@
  */
 #include "misdat.h"
 
+#include "engine/animation_store.hpp"
 #include "engine/load_cl2.hpp"
-#include "engine/load_clx.hpp"
 #include "missiles.h"
-#include "mpq/mpq_common.hpp"
 #include "utils/file_name_generator.hpp"
 #include "utils/str_cat.hpp"
 
@@ -279,35 +278,54 @@ uint8_t MissileFileData::animLen(uint8_t dir) const
 	return MissileAnimLengths[animLenIdx][dir];
 }
 
-void MissileFileData::LoadGFX()
+void MissileFileData::RequestGFX()
 {
-	if (sprites)
-		return;
-
-	if (name[0] == '\0')
+	if (sheet != nullptr || name[0] == '\0')
 		return;
 
+	const std::string key = StrCat("missiles\\", name);
 #ifdef UNPACKED_MPQS
-	char path[MaxMpqPathSize];
-	*BufCopy(path, "missiles\\", name, ".clx") = '\0';
-	sprites.emplace(LoadClxListOrSheet(path));
+	sheet = RequestAnimationSheet(StrCat(key, ".clx"), animWidth);
 #else
 	if (animFAmt == 1) {
-		char path[MaxMpqPathSize];
-		*BufCopy(path, "missiles\\", name) = '\0';
-		sprites.emplace(OwnedClxSpriteListOrSheet { LoadCl2(path, animWidth) });
+		sheet = RequestAnimationSheet(StrCat(key, DEVILUTIONX_CL2_EXT), animWidth);
 	} else {
 		FileNameGenerator pathGenerator({ "missiles\\", name }, DEVILUTIONX_CL2_EXT);
-		sprites.emplace(OwnedClxSpriteListOrSheet { LoadMultipleCl2Sheet<16>(pathGenerator, animFAmt, animWidth) });
+		std::vector<std::string> paths;
+		for (size_t i = 0; i < animFAmt; i++)
+			paths.emplace_back(pathGenerator(i));
+		sheet = RequestAnimationSheet(key, std::move(paths), animWidth);
 	}
 #endif
 }
 
+void MissileFileData::LoadGFX()
+{
+	if (sprites)
+		return;
+
+	RequestGFX();
+	if (sheet == nullptr)
+		return;
+
+	WaitForAnimationSheet(*sheet);
+	sheet->checkError();
+	sprites = sheet->sprites();
+}
+
 void InitMissileGFX(bool loadHellfireGraphics)
 {
 	if (HeadlessMode)
 		return;
 
+	for (size_t mi = 0; MissileSpriteData[mi].animFAmt != 0; mi++) {
+		if (!loadHellfireGraphics && mi > static_cast<uint8_t>(MissileGraphicID::BloodStarRedExplosion))
+			break;
+		if (MissileSpriteData[mi].flags == MissileGraphicsFlags::MonsterOwned)
+			continue;
+		MissileSpriteData[mi].RequestGFX();
+	}
+	// The files are read in the background while the earlier ones are waited for.
 	for (size_t mi = 0; MissileSpriteData[mi].animFAmt != 0; mi++) {
 		if (!loadHellfireGraphics && mi > static_cast<uint8_t>(MissileGraphicID::BloodStarRedExplosion))
 			break;
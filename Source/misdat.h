@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -162,8 +163,10 @@ enum class MissileGraphicsFlags : uint8_t {
 	// clang-format on
 };
 
+class AnimationSheet;
+
 struct MissileFileData {
-	OptionalOwnedClxSpriteListOrSheet sprites;
+	OptionalClxSpriteListOrSheet sprites;
 	uint16_t animWidth;
 	int8_t animWidth2;
 	char name[9];
@@ -171,15 +174,22 @@ struct MissileFileData {
 	MissileGraphicsFlags flags;
 	uint8_t animDelayIdx;
 	uint8_t animLenIdx;
+	/** @brief The file(s) holding the sprites, kept in the animation store across levels. */
+	std::shared_ptr<AnimationSheet> sheet;
 
 	[[nodiscard]] uint8_t animDelay(uint8_t dir) const;
 	[[nodiscard]] uint8_t animLen(uint8_t dir) const;
 
+	/**
+	 * @brief Queues the graphics to be loaded in the background, `LoadGFX` then waits for them.
+	 */
+	void RequestGFX();
 	void LoadGFX();
 
 	void FreeGFX()
 	{
 		sprites = std::nullopt;
+		sheet = nullptr;
 	}
 
 	/**
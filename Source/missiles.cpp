@@ -2147,6 +2147,8 @@ void AddChainLightning(Missile &missile, AddMissileParameter &parameter)
 namespace {
 void InitMissileAnimationFromMonster(Missile &mis, Direction midir, const Monster &mon, MonsterGraphic graphic)
 {
+	// The missile keeps the sprites, so they must not be released while it flies.
+	PinMonsterGraphic(LevelMonsterTypes[mon.levelType], graphic);
 	const AnimStruct &anim = mon.type().getAnimData(graphic);
 	mis._mimfnum = static_cast<int32_t>(midir);
 	mis._miAnimFlags = MissileGraphicsFlags::None;
@@ -4172,7 +4174,7 @@ void missiles_process_charge()
 		if (missile._mitype != MissileID::Rhino)
 			continue;
 
-		const CMonster &mon = Monsters[missile._misource].type();
+		CMonster &mon = LevelMonsterTypes[Monsters[missile._misource].levelType];
 
 		MonsterGraphic graphic;
 		if (IsAnyOf(mon.type, MT_HORNED, MT_MUDRUN, MT_FROSTC, MT_OBLORD)) {
@@ -4182,6 +4184,7 @@ void missiles_process_charge()
 		} else {
 			graphic = MonsterGraphic::Walk;
 		}
+		PinMonsterGraphic(mon, graphic);
 		missile._miAnimData = mon.getAnimData(graphic).spritesForDirection(static_cast<Direction>(missile._mimfnum));
 	}
 }
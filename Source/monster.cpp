@@ -16,11 +16,12 @@
 #include "control.h"
 #include "cursor.h"
 #include "dead.h"
+#include "engine/animation_store.hpp"
 #include "engine/load_cl2.hpp"
 #include "engine/load_file.hpp"
 #include "engine/points_in_rectangle_range.hpp"
 #include "engine/random.hpp"
-#include "engine/render/clx_render.hpp"
+#include "engine/sound_bank.hpp"
 #include "engine/sound_position.hpp"
 #include "engine/world_tile.hpp"
 #include "init.h"
@@ -37,8 +38,6 @@
 #include "spelldat.h"
 #include "storm/storm_net.hpp"
 #include "towners.h"
-#include "utils/cl2_to_clx.hpp"
-#include "utils/file_name_generator.hpp"
 #include "utils/language.h"
 #include "utils/stdcompat/string_view.hpp"
 #include "utils/str_cat.hpp"
@@ -96,27 +95,158 @@ size_t GetNumAnims(const MonsterData &monsterData)
 	return monsterData.hasSpecial ? 6 : 5;
 }
 
-void InitMonsterTRN(CMonster &monst)
+/** Game ticks between looking for graphics to release when the monster graphics use too much memory. */
+constexpr uint32_t ReleaseGraphicsInterval = 20;
+/**
+ * @brief Memory the graphics of the level's monster types may hold before idle ones are released.
+ *
+ * Player and missile sheets are held for the whole game and don't count here. All sheets together can still
+ * exceed the animation store budget of 64 MiB (12 MiB on 3DS), which only frees sheets that nothing holds.
+ */
+#ifdef __3DS__
+constexpr size_t MonsterGraphicsBudget = 6 * 1024 * 1024;
+#else
+constexpr size_t MonsterGraphicsBudget = 40 * 1024 * 1024;
+#endif
+uint32_t MonsterGraphicUses;
+uint32_t MonsterGraphicTicks;
+
+std::string GetMonsterGraphicPath(const MonsterData &monsterData, size_t graphic)
 {
-	char path[64];
-	*BufCopy(path, "monsters\\", monst.data->trnFile, ".trn") = '\0';
-	std::array<uint8_t, 256> colorTranslations;
-	LoadFileInMem(path, colorTranslations);
-	std::replace(colorTranslations.begin(), colorTranslations.end(), 255, 0);
+	return StrCat("monsters\\", monsterData.assetsSuffix, string_view(&Animletter[graphic], 1), DEVILUTIONX_CL2_EXT);
+}
 
-	const size_t numAnims = GetNumAnims(*monst.data);
-	for (size_t i = 0; i < numAnims; i++) {
-		if (i == 1 && IsAnyOf(monst.type, MT_COUNSLR, MT_MAGISTR, MT_CABALIST, MT_ADVOCATE)) {
-			continue;
-		}
+/**
+ * @brief The colour translation of a graphic, if it has one.
+ */
+std::optional<AnimationSheetTrn> GetMonsterTrn(const CMonster &monsterType, size_t graphic)
+{
+	if (monsterType.data->trnFile == nullptr)
+		return std::nullopt;
+	if (graphic == 1 && IsAnyOf(monsterType.type, MT_COUNSLR, MT_MAGISTR, MT_CABALIST, MT_ADVOCATE))
+		return std::nullopt;
 
-		AnimStruct &anim = monst.anims[i];
-		if (anim.sprites->isSheet()) {
-			ClxApplyTrans(ClxSpriteSheet { anim.sprites->sheet() }, colorTranslations.data());
-		} else {
-			ClxApplyTrans(ClxSpriteList { anim.sprites->list() }, colorTranslations.data());
+	AnimationSheetTrn trn;
+	trn.path = StrCat("monsters\\", monsterType.data->trnFile, ".trn");
+	trn.transparent255 = true;
+	return trn;
+}
+
+/**
+ * @brief Fills in the sprites of a graphic if its file has been loaded.
+ */
+void PublishMonsterGraphic(CMonster &monsterType, size_t graphic)
+{
+	const AnimationSheet &sheet = *monsterType.animSheets[graphic];
+	if (!sheet.isLoaded())
+		return;
+	sheet.checkError();
+	monsterType.anims[graphic].sprites = sheet.sprites();
+}
+
+/**
+ * @brief Marks a graphic as used and queues its file to be loaded if it isn't already.
+ */
+void RequestMonsterGraphic(CMonster &monsterType, MonsterGraphic graphic)
+{
+	const size_t index = static_cast<size_t>(graphic);
+	monsterType.animLastUse[index] = ++MonsterGraphicUses;
+	if (HeadlessMode || monsterType.anims[index].frames == 0 || monsterType.animSheets[index] != nullptr)
+		return;
+
+	const MonsterData &monsterData = *monsterType.data;
+	monsterType.animSheets[index] = RequestAnimationSheet(GetMonsterGraphicPath(monsterData, index), monsterData.width, GetMonsterTrn(monsterType, index));
+	// Sheets that are still cached from an earlier level are ready right away.
+	PublishMonsterGraphic(monsterType, index);
+}
+
+/**
+ * @brief Releases the least recently used graphics that no monster is playing, until the monster graphics fit within `MonsterGraphicsBudget`.
+ */
+void ReleaseIdleMonsterGraphics()
+{
+	std::vector<const AnimationSheet *> heldSheets;
+	for (size_t levelType = 0; levelType < LevelMonsterTypeCount; levelType++) {
+		for (const std::shared_ptr<AnimationSheet> &sheet : LevelMonsterTypes[levelType].animSheets) {
+			if (sheet != nullptr)
+				heldSheets.push_back(sheet.get());
+		}
+	}
+	// Monster types that look the same share their sheets.
+	std::sort(heldSheets.begin(), heldSheets.end());
+	heldSheets.erase(std::unique(heldSheets.begin(), heldSheets.end()), heldSheets.end());
+	size_t memoryUsed = 0;
+	for (const AnimationSheet *sheet : heldSheets)
+		memoryUsed += sheet->memorySize();
+	if (memoryUsed <= MonsterGraphicsBudget)
+		return;
+
+	std::array<uint8_t, MaxLvlMTypes> playing {};
+	for (size_t i = 0; i < ActiveMonsterCount; i++) {
+		const Monster &monster = Monsters[ActiveMonsters[i]];
+		playing[monster.levelType] |= 1 << static_cast<int>(monster.graphic);
+	}
+
+	struct IdleGraphic {
+		size_t levelType;
+		size_t graphic;
+		uint32_t lastUse;
+	};
+	std::vector<IdleGraphic> idle;
+	for (size_t levelType = 0; levelType < LevelMonsterTypeCount; levelType++) {
+		const CMonster &monsterType = LevelMonsterTypes[levelType];
+		const uint8_t keep = monsterType.pinnedAnims | playing[levelType];
+		for (size_t graphic = 0; graphic < 6; graphic++) {
+			if (monsterType.animSheets[graphic] != nullptr && monsterType.animSheets[graphic]->isLoaded() && (keep & (1 << graphic)) == 0)
+				idle.push_back({ levelType, graphic, monsterType.animLastUse[graphic] });
+		}
+	}
+	std::sort(idle.begin(), idle.end(), [](const IdleGraphic &a, const IdleGraphic &b) {
+		return a.lastUse < b.lastUse;
+	});
+
+	// Only graphics that no monster is playing are released, even if the rest alone exceed the budget.
+	for (const IdleGraphic &graphic : idle) {
+		if (memoryUsed <= MonsterGraphicsBudget)
+			break;
+		CMonster &monsterType = LevelMonsterTypes[graphic.levelType];
+		std::shared_ptr<AnimationSheet> &sheet = monsterType.animSheets[graphic.graphic];
+		// Held by this type and the store only, otherwise another type still uses it.
+		if (sheet.use_count() <= 2)
+			memoryUsed -= sheet->memorySize();
+		monsterType.anims[graphic.graphic].sprites = std::nullopt;
+		sheet = nullptr;
+	}
+	TrimAnimationSheets();
+}
+
+/**
+ * @brief Fills in the graphics that finished loading and releases idle ones now and then.
+ */
+void UpdateMonsterGraphics()
+{
+	if (HeadlessMode)
+		return;
+
+	for (size_t levelType = 0; levelType < LevelMonsterTypeCount; levelType++) {
+		CMonster &monsterType = LevelMonsterTypes[levelType];
+		for (size_t graphic = 0; graphic < 6; graphic++) {
+			if (monsterType.animSheets[graphic] == nullptr || monsterType.anims[graphic].sprites)
+				continue;
+			PublishMonsterGraphic(monsterType, graphic);
+			if (!monsterType.anims[graphic].sprites)
+				continue;
+			// Monsters that started the animation while it was loading were drawn standing until now.
+			for (size_t i = 0; i < ActiveMonsterCount; i++) {
+				Monster &monster = Monsters[ActiveMonsters[i]];
+				if (monster.levelType == levelType && static_cast<size_t>(monster.graphic) == graphic && !monster.animInfo.sprites)
+					monster.animInfo.sprites = monsterType.anims[graphic].spritesForDirection(monster.direction);
+			}
 		}
 	}
+
+	if (++MonsterGraphicTicks % ReleaseGraphicsInterval == 0)
+		ReleaseIdleMonsterGraphics();
 }
 
 void InitMonster(Monster &monster, Direction rd, size_t typeIndex, Point position)
@@ -580,6 +710,8 @@ void DeleteMonster(size_t activeIndex)
 
 void NewMonsterAnim(Monster &monster, MonsterGraphic graphic, Direction md, AnimationDistributionFlags flags = AnimationDistributionFlags::None, int8_t numSkippedFrames = 0, int8_t distributeFramesBeforeFrame = 0)
 {
+	RequestMonsterGraphic(LevelMonsterTypes[monster.levelType], graphic);
+	monster.graphic = graphic;
 	const auto &animData = monster.type().getAnimData(graphic);
 	monster.animInfo.setNewAnimation(animData.spritesForDirection(md), animData.frames, animData.rate, flags, numSkippedFrames, distributeFramesBeforeFrame);
 	monster.flags &= ~(MFLAG_LOCK_ANIMATION | MFLAG_ALLOW_SPECIAL);
@@ -3334,17 +3466,30 @@ void InitMonsterSND(CMonster &monsterType)
 	const MonsterData &data = MonstersData[monsterType.type];
 	string_view soundSuffix = data.soundSuffix != nullptr ? data.soundSuffix : data.assetsSuffix;
 
+	std::vector<std::string> paths;
 	for (int i = 0; i < 4; i++) {
 		string_view prefix = prefixes[i];
-		if (prefix == "s" && !data.hasSpecialSound)
-			continue;
-
 		for (int j = 0; j < 2; j++) {
-			char path[64];
-			*BufCopy(path, "monsters\\", soundSuffix, prefix, j + 1, ".wav") = '\0';
-			monsterType.sounds[i][j] = sound_file_load(path);
+			if (prefix == "s" && !data.hasSpecialSound)
+				paths.emplace_back();
+			else
+				paths.push_back(StrCat("monsters\\", soundSuffix, prefix, j + 1, ".wav"));
 		}
 	}
+
+	// Monster types that share their sounds share the bank.
+	monsterType.sounds = RequestSoundBank(StrCat("monsters\\", soundSuffix, data.hasSpecialSound ? "+s" : ""), std::move(paths));
+}
+
+void PinMonsterGraphic(CMonster &monsterType, MonsterGraphic graphic)
+{
+	const size_t index = static_cast<size_t>(graphic);
+	monsterType.pinnedAnims |= 1 << index;
+	RequestMonsterGraphic(monsterType, graphic);
+	if (monsterType.animSheets[index] == nullptr)
+		return;
+	WaitForAnimationSheet(*monsterType.animSheets[index]);
+	PublishMonsterGraphic(monsterType, index);
 }
 
 void InitMonsterGFX(CMonster &monsterType)
@@ -3352,46 +3497,30 @@ void InitMonsterGFX(CMonster &monsterType)
 	const _monster_id mtype = monsterType.type;
 	const MonsterData &monsterData = MonstersData[mtype];
 	const size_t numAnims = GetNumAnims(monsterData);
-	const auto hasAnim = [&monsterData](size_t index) {
-		return monsterData.frames[index] != 0;
-	};
-	constexpr size_t MaxAnims = 6;
-	std::array<uint32_t, MaxAnims + 1> animOffsets;
-	if (!HeadlessMode) {
-		monsterType.animData = MultiFileLoader<MaxAnims> {}(
-		    numAnims,
-		    FileNameWithCharAffixGenerator({ "monsters\\", monsterData.assetsSuffix }, DEVILUTIONX_CL2_EXT, Animletter),
-		    animOffsets.data(),
-		    hasAnim);
-	}
+	monsterType.data = &monsterData;
 
-	for (size_t i = 0, j = 0; i < numAnims; ++i) {
+	// Only the frame counts are needed up front, the files are loaded when the graphics are first used.
+	for (size_t i = 0; i < 6; ++i) {
 		AnimStruct &anim = monsterType.anims[i];
-		if (!hasAnim(i)) {
+		anim.sprites = std::nullopt;
+		monsterType.animSheets[i] = nullptr;
+		monsterType.animLastUse[i] = 0;
+		if (i >= numAnims || monsterData.frames[i] == 0) {
 			anim.frames = 0;
 			continue;
 		}
 		anim.frames = monsterData.frames[i];
 		anim.rate = monsterData.rate[i];
 		anim.width = monsterData.width;
-		if (!HeadlessMode) {
-			const uint32_t begin = animOffsets[j];
-			const uint32_t end = animOffsets[j + 1];
-			auto spritesData = reinterpret_cast<uint8_t *>(&monsterType.animData[begin]);
-			const uint16_t numLists = Cl2ToClx(spritesData, end - begin, PointerOrValue<uint16_t> { monsterData.width });
-			anim.sprites = ClxSpriteListOrSheet { spritesData, numLists };
-		}
-		++j;
 	}
-
-	monsterType.data = &monsterData;
+	monsterType.pinnedAnims = 0;
 
 	if (HeadlessMode)
 		return;
 
-	if (monsterData.trnFile != nullptr) {
-		InitMonsterTRN(monsterType);
-	}
+	// Standing doubles as the placeholder while the other graphics are loading and corpses show the end of dying.
+	PinMonsterGraphic(monsterType, MonsterGraphic::Stand);
+	PinMonsterGraphic(monsterType, MonsterGraphic::Death);
 
 	if (IsAnyOf(mtype, MT_NMAGMA, MT_YMAGMA, MT_BMAGMA, MT_WMAGMA))
 		GetMissileSpriteData(MissileGraphicID::MagmaBall).LoadGFX();
@@ -3937,6 +4066,7 @@ void DeleteMonsterList()
 void ProcessMonsters()
 {
 	DeleteMonsterList();
+	UpdateMonsterGraphics();
 
 	assert(ActiveMonsterCount <= MaxMonsters);
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
@@ -4011,16 +4141,17 @@ void ProcessMonsters()
 void FreeMonsters()
 {
 	for (CMonster &monsterType : LevelMonsterTypes) {
-		monsterType.animData = nullptr;
 		for (AnimStruct &animData : monsterType.anims) {
 			animData.sprites = std::nullopt;
 		}
-
-		for (auto &variants : monsterType.sounds) {
-			for (auto &sound : variants) {
-				sound = nullptr;
-			}
+		// The sheets stay cached for later levels, see `TrimAnimationSheets`.
+		for (std::shared_ptr<AnimationSheet> &sheet : monsterType.animSheets) {
+			sheet = nullptr;
 		}
+		monsterType.pinnedAnims = 0;
+
+		// The bank stays cached for later levels, see `TrimSoundBanks`.
+		monsterType.sounds = nullptr;
 	}
 }
 
@@ -4314,7 +4445,8 @@ void PlayEffect(Monster &monster, MonsterSound mode)
 		return;
 	}
 
-	TSnd *snd = monster.type().sounds[static_cast<size_t>(mode)][sndIdx].get();
+	const std::shared_ptr<SoundBank> &sounds = monster.type().sounds;
+	TSnd *snd = sounds != nullptr ? sounds->sound(static_cast<size_t>(mode) * 2 + sndIdx) : nullptr;
 	if (snd == nullptr || snd->isPlaying()) {
 		return;
 	}
@@ -4324,7 +4456,7 @@ void PlayEffect(Monster &monster, MonsterSound mode)
 	if (!CalculateSoundPosition(monster.position.tile, &lVolume, &lPan))
 		return;
 
-	snd_play_snd(snd, lVolume, lPan);
+	snd_play_snd(snd, lVolume, lPan, SoundPriority::Monster);
 }
 
 void MissToMonst(Missile &missile, Point position)
@@ -4599,6 +4731,16 @@ void Monster::setLeader(const Monster *leader)
 	return std::max(std::abs(mx), std::abs(my));
 }
 
+void Monster::changeAnimationData(MonsterGraphic graphic, Direction desiredDirection)
+{
+	RequestMonsterGraphic(LevelMonsterTypes[levelType], graphic);
+	this->graphic = graphic;
+	const AnimStruct &animationData = type().getAnimData(graphic);
+
+	// Passing the frames and rate properties here is only relevant when initialising a monster, but doesn't cause any harm when switching animations.
+	this->animInfo.changeAnimationData(animationData.spritesForDirection(desiredDirection), animationData.frames, animationData.rate);
+}
+
 void Monster::checkStandAnimationIsLoaded(Direction mdir)
 {
 	if (IsAnyOf(mode, MonsterMode::Stand, MonsterMode::Talk)) {
@@ -175,10 +175,22 @@ enum class MonsterSound : uint8_t {
 	Special
 };
 
+class AnimationSheet;
+class SoundBank;
+
 struct CMonster {
-	std::unique_ptr<byte[]> animData;
 	AnimStruct anims[6];
-	std::unique_ptr<TSnd> sounds[4][2];
+	/**
+	 * The animation file of each graphic. Standing and dying are loaded with the level, the others are
+	 * loaded in the background when first used and released again when memory is short.
+	 */
+	std::shared_ptr<AnimationSheet> animSheets[6];
+	/** When each graphic was last used, the least recently used are released first. */
+	uint32_t animLastUse[6];
+	/** Graphics that stay loaded until the level is left, as a bit mask indexed by `MonsterGraphic`. */
+	uint8_t pinnedAnims;
+	/** The two variants of each `MonsterSound`, in that order, see `InitMonsterSND`. */
+	std::shared_ptr<SoundBank> sounds;
 	const MonsterData *data;
 
 	_monster_id type;
@@ -270,6 +282,8 @@ struct Monster { // note: missing field _mAFNum
 	LeaderRelation leaderRelation;
 	uint8_t packSize;
 	int8_t lightId;
+	/** The animation sequence being played, its sprites are filled in once it is loaded if it wasn't yet. */
+	MonsterGraphic graphic;
 
 	static constexpr uint8_t NoLeader = -1;
 
@@ -278,13 +292,7 @@ struct Monster { // note: missing field _mAFNum
 	 * @param graphic Animation sequence of interest
 	 * @param desiredDirection Desired desiredDirection the monster should be visually facing
 	 */
-	void changeAnimationData(MonsterGraphic graphic, Direction desiredDirection)
-	{
-		const AnimStruct &animationData = type().getAnimData(graphic);
-
-		// Passing the frames and rate properties here is only relevant when initialising a monster, but doesn't cause any harm when switching animations.
-		this->animInfo.changeAnimationData(animationData.spritesForDirection(desiredDirection), animationData.frames, animationData.rate);
-	}
+	void changeAnimationData(MonsterGraphic graphic, Direction desiredDirection);
 
 	/**
 	 * @brief Sets the current cell sprite to match the desired animation sequence using the direction the monster is currently facing
@@ -451,6 +459,10 @@ void InitLevelMonsters();
 void GetLevelMTypes();
 void InitMonsterSND(CMonster &monsterType);
 void InitMonsterGFX(CMonster &monsterType);
+/**
+ * @brief Loads a graphic right away and keeps it until the level is left, for sprites that are used outside of the monster (e.g. by missiles).
+ */
+void PinMonsterGraphic(CMonster &monsterType, MonsterGraphic graphic);
 void WeakenNaKrul();
 void InitGolems();
 void InitMonsters();
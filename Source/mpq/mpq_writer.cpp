@@ -6,7 +6,6 @@
 #include <memory>
 #include <type_traits>
 
-#include "appfat.h"
 #include "encrypt.h"
 #include "engine.h"
 #include "utils/endian.hpp"
@@ -158,7 +157,8 @@ MpqWriter::MpqWriter(const char *path)
 	}
 	return;
 on_error:
-	app_fatal(StrCat(_("Failed to open archive for writing."), "\n", path, "\n", error));
+	error_ = StrCat(_("Failed to open archive for writing."), "\n", path, "\n", error);
+	stream_.Close();
 }
 
 MpqWriter::~MpqWriter()
@@ -166,6 +166,11 @@ MpqWriter::~MpqWriter()
 	if (!stream_.IsOpen())
 		return;
 	LogVerbose("Closing {}", name_);
+	if (!error_.empty()) {
+		// The tables may be inconsistent, leave the archive as it was last closed.
+		stream_.Close();
+		return;
+	}
 
 	bool result = true;
 	if (!(stream_.Seekp(0, SEEK_SET) && WriteHeaderAndTables()))
@@ -235,7 +240,8 @@ MpqBlockEntry *MpqWriter::NewBlock(uint32_t *blockIndex)
 		return blockEntry;
 	}
 
-	app_fatal("Out of free block entries");
+	error_ = "Out of free block entries";
+	return nullptr;
 }
 
 void MpqWriter::AllocBlock(uint32_t blockOffset, uint32_t blockSize)
@@ -266,7 +272,8 @@ void MpqWriter::AllocBlock(uint32_t blockOffset, uint32_t blockSize)
 	} while (expand);
 	if (blockOffset + blockSize > size_) {
 		// Expanded beyond EOF, this should never happen.
-		app_fatal("MPQ free list error");
+		error_ = "MPQ free list error";
+		return;
 	}
 	if (blockOffset + blockSize == size_) {
 		size_ = blockOffset;
@@ -334,8 +341,10 @@ MpqBlockEntry *MpqWriter::AddFile(const char *filename, MpqBlockEntry *block, ui
 	uint32_t h1 = Hash(filename, 0);
 	uint32_t h2 = Hash(filename, 1);
 	uint32_t h3 = Hash(filename, 2);
-	if (GetHashIndex(h1, h2, h3) != HashEntryNotFound)
-		app_fatal(StrCat("Hash collision between \"", filename, "\" and existing file\n"));
+	if (GetHashIndex(h1, h2, h3) != HashEntryNotFound) {
+		error_ = StrCat("Hash collision between \"", filename, "\" and existing file\n");
+		return nullptr;
+	}
 	unsigned int hIdx = h1 & 0x7FF;
 
 	bool hasSpace = false;
@@ -346,11 +355,15 @@ MpqBlockEntry *MpqWriter::AddFile(const char *filename, MpqBlockEntry *block, ui
 		}
 		hIdx = (hIdx + 1) & 0x7FF;
 	}
-	if (!hasSpace)
-		app_fatal("Out of hash space");
+	if (!hasSpace) {
+		error_ = "Out of hash space";
+		return nullptr;
+	}
 
 	if (block == nullptr)
 		block = NewBlock(&blockIndex);
+	if (block == nullptr)
+		return nullptr;
 
 	MpqHashEntry &entry = hashTable_[hIdx];
 	entry.hashA = h2;
@@ -481,6 +494,8 @@ bool MpqWriter::WriteHashTable()
 
 void MpqWriter::RemoveHashEntry(const char *filename)
 {
+	if (!error_.empty())
+		return;
 	uint32_t hIdx = FetchHandle(filename);
 	if (hIdx == HashEntryNotFound) {
 		return;
@@ -509,9 +524,13 @@ bool MpqWriter::WriteFile(const char *filename, const byte *data, size_t size)
 	MpqBlockEntry *blockEntry;
 
 	RemoveHashEntry(filename);
+	if (!error_.empty())
+		return false;
 	blockEntry = AddFile(filename, nullptr, 0);
+	if (blockEntry == nullptr)
+		return false;
 	if (!WriteFileContents(filename, data, size, blockEntry)) {
-		RemoveHashEntry(filename);
+		error_ = StrCat("Failed to write \"", filename, "\" to ", name_);
 		return false;
 	}
 	return true;
@@ -519,6 +538,8 @@ bool MpqWriter::WriteFile(const char *filename, const byte *data, size_t size)
 
 void MpqWriter::RenameFile(const char *name, const char *newName) // NOLINT(bugprone-easily-swappable-parameters)
 {
+	if (!error_.empty())
+		return;
 	uint32_t index = FetchHandle(name);
 	if (index == HashEntryNotFound) {
 		return;
@@ -533,6 +554,8 @@ void MpqWriter::RenameFile(const char *name, const char *newName) // NOLINT(bugp
 
 bool MpqWriter::HasFile(const char *name) const
 {
+	if (!error_.empty())
+		return false;
 	return FetchHandle(name) != HashEntryNotFound;
 }
 
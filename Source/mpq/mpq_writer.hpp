@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 
 #include "mpq/mpq_common.hpp"
 #include "utils/logged_fstream.hpp"
@@ -30,6 +31,15 @@ public:
 	bool WriteFile(const char *filename, const byte *data, size_t size);
 	void RenameFile(const char *name, const char *newName);
 
+	/**
+	 * @brief Describes the first failure, the writer ignores further changes after one.
+	 * @return An empty string if nothing failed
+	 */
+	const std::string &error() const
+	{
+		return error_;
+	}
+
 private:
 	bool IsValidMpqHeader(MpqFileHeader *hdr) const;
 	uint32_t GetHashIndex(uint32_t index, uint32_t hashA, uint32_t hashB) const;
@@ -56,6 +66,7 @@ private:
 
 	LoggedFStream stream_;
 	std::string name_;
+	std::string error_;
 	std::uintmax_t size_ {};
 	std::unique_ptr<MpqHashEntry[]> hashTable_;
 	std::unique_ptr<MpqBlockEntry[]> blockTable_;
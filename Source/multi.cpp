@@ -27,6 +27,7 @@
 #include "tmsg.h"
 #include "utils/endian.hpp"
 #include "utils/language.h"
+#include "utils/profiler.hpp"
 #include "utils/stdcompat/cstddef.hpp"
 #include "utils/stdcompat/string_view.hpp"
 #include "utils/str_cat.hpp"
@@ -601,6 +602,7 @@ bool multi_handle_delta()
 
 void multi_process_network_packets()
 {
+	DVL_PROFILE_ZONE("NetworkPoll");
 	ClearPlayerLeftState();
 	ProcessTmsgs();
 
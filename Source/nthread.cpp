@@ -5,6 +5,8 @@
  */
 #include "nthread.h"
 
+#include <cmath>
+
 #include <fmt/core.h>
 
 #include "diablo.h"
@@ -37,6 +39,25 @@ int8_t sgbPacketCountdown;
 bool sgbThreadIsRunning;
 SdlThread Thread;
 
+/**
+ * @brief Like `SDL_GetTicks`, but with sub-millisecond precision where SDL provides it.
+ *
+ * With whole milliseconds, frames at high refresh rates are spaced unevenly between game ticks
+ * and the interpolated movement judders.
+ */
+double GetTicksPrecise()
+{
+#ifndef USE_SDL1
+	static const Uint64 Frequency = SDL_GetPerformanceFrequency();
+	static const Uint64 StartCounter = SDL_GetPerformanceCounter();
+	// `SDL_GetTicks` truncates, on average it is half a millisecond behind.
+	static const double StartTicks = SDL_GetTicks() + 0.5;
+	return StartTicks + static_cast<double>(SDL_GetPerformanceCounter() - StartCounter) * 1000.0 / static_cast<double>(Frequency);
+#else
+	return SDL_GetTicks();
+#endif
+}
+
 void NthreadHandler()
 {
 	if (!nthread_should_run) {
@@ -248,14 +269,17 @@ void nthread_UpdateProgressToNextGameTick()
 {
 	if (!gbRunGame || PauseMode != 0 || (!gbIsMultiplayer && gmenu_is_active()) || !gbProcessPlayers || demo::IsRunning()) // if game is not running or paused there is no next gametick in the near future
 		return;
-	int currentTickCount = SDL_GetTicks();
-	int ticksMissing = last_tick - currentTickCount;
+	const double currentTicks = GetTicksPrecise();
+	const double wholeTicks = std::floor(currentTicks);
+	// Wraps around like `SDL_GetTicks` and `last_tick` do.
+	const int currentTickCount = static_cast<int>(static_cast<uint32_t>(std::fmod(wholeTicks, 4294967296.0)));
+	const double ticksMissing = (last_tick - currentTickCount) - (currentTicks - wholeTicks);
 	if (ticksMissing <= 0) {
 		ProgressToNextGameTick = AnimationInfo::baseValueFraction; // game tick is due
 		return;
 	}
-	int ticksAdvanced = gnTickDelay - ticksMissing;
-	int32_t fraction = ticksAdvanced * AnimationInfo::baseValueFraction / gnTickDelay;
+	const double ticksAdvanced = gnTickDelay - ticksMissing;
+	int32_t fraction = static_cast<int32_t>(ticksAdvanced * AnimationInfo::baseValueFraction / gnTickDelay);
 	fraction = clamp<int32_t>(fraction, 0, AnimationInfo::baseValueFraction);
 	ProgressToNextGameTick = static_cast<uint8_t>(fraction);
 }
@@ -1074,6 +1074,7 @@ void AddChest(Object &chest)
 void ObjSetMicro(Point position, int pn)
 {
 	dPiece[position.x][position.y] = pn;
+	DungeonLayoutVersion++;
 }
 
 void DoorSet(Point position, bool isLeftDoor)
@@ -4423,6 +4424,7 @@ void ObjChangeMap(int x1, int y1, int x2, int y2)
 	if (leveltype == DTYPE_LOTUS) {
 		AddLotusObjects(2 * x1 + 16, 2 * y1 + 16, 2 * x2 + 17, 2 * y2 + 17);
 	}
+	DungeonLayoutVersion++;
 }
 
 void ObjChangeMapResync(int x1, int y1, int x2, int y2)
@@ -4439,6 +4441,7 @@ void ObjChangeMapResync(int x1, int y1, int x2, int y2)
 	if (leveltype == DTYPE_CATACOMBS) {
 		ObjL2Special(2 * x1 + 16, 2 * y1 + 16, 2 * x2 + 17, 2 * y2 + 17);
 	}
+	DungeonLayoutVersion++;
 }
 
 _item_indexes ItemMiscIdIdx(item_misc_id imiscid)
@@ -4990,6 +4993,7 @@ void SyncNakrulRoom()
 	dPiece[UberRow][UberCol - 1] = 300;
 	dPiece[UberRow][UberCol - 2] = 299;
 	dPiece[UberRow][UberCol + 1] = 298;
+	DungeonLayoutVersion++;
 }
 
 } // namespace devilution
@@ -956,6 +956,8 @@ GraphicsOptions::GraphicsOptions()
     , hardwareCursorMaxSize("Hardware Cursor Maximum Size", OptionEntryFlags::CantChangeInGame | OptionEntryFlags::RecreateUI | (HardwareCursorSupported() ? OptionEntryFlags::None : OptionEntryFlags::Invisible), N_("Hardware Cursor Maximum Size"), N_("Maximum width / height for the hardware cursor. Larger cursors fall back to software."), 128, { 0, 64, 128, 256, 512 })
 #endif
     , limitFPS("FPS Limiter", OptionEntryFlags::None, N_("FPS Limiter"), N_("FPS is limited to avoid high CPU load. Limit considers refresh rate."), true)
+    , fastBlitter("Fast Blitter", OptionEntryFlags::None, N_("Fast Blitter"), N_("Converts the rendered image to the display format with a vectorized blitter instead of the generic one. Turn off if the image looks wrong."), true)
+    , floorCache("Floor Cache", OptionEntryFlags::None, N_("Floor Cache"), N_("Reuses the floor from the previous frame and only renders the parts that scrolled into view or changed lighting. Not used in Hell, where the lava colors cycle every frame."), false)
     , showItemGraphicsInStores("Show Item Graphics in Stores", OptionEntryFlags::None, N_("Show Item Graphics in Stores"), N_("Show item graphics to the left of item descriptions in store menus."), false)
     , showFPS("Show FPS", OptionEntryFlags::None, N_("Show FPS"), N_("Displays the FPS in the upper left corner of the screen."), false)
     , showHealthValues("Show health values", OptionEntryFlags::None, N_("Show health values"), N_("Displays current / max health value on health globe."), false)
@@ -994,6 +996,8 @@ std::vector<OptionEntryBase *> GraphicsOptions::GetEntries()
 		&gammaCorrection,
 		&zoom,
 		&limitFPS,
+		&fastBlitter,
+		&floorCache,
 		&showFPS,
 		&showItemGraphicsInStores,
 		&showHealthValues,
@@ -1038,6 +1042,7 @@ GameplayOptions::GameplayOptions()
     , autoRefillBelt("Auto Refill Belt", OptionEntryFlags::None, N_("Auto Refill Belt"), N_("Refill belt from inventory when belt item is consumed."), false)
     , disableCripplingShrines("Disable Crippling Shrines", OptionEntryFlags::None, N_("Disable Crippling Shrines"), N_("When enabled Cauldrons, Fascinating Shrines, Goat Shrines, Ornate Shrines and Sacred Shrines are not able to be clicked on and labeled as disabled."), false)
     , quickCast("Quick Cast", OptionEntryFlags::None, N_("Quick Cast"), N_("Spell hotkeys instantly cast the spell, rather than switching the readied spell."), false)
+    , reuseLevelLayouts("Reuse Level Layouts", OptionEntryFlags::None, N_("Reuse Level Layouts"), N_("Keeps the layouts of recently visited levels, so entering a level again skips generating it."), false)
     , numHealPotionPickup("Heal Potion Pickup", OptionEntryFlags::None, N_("Heal Potion Pickup"), N_("Number of Healing potions to pick up automatically."), 0, { 0, 1, 2, 4, 8, 16 })
     , numFullHealPotionPickup("Full Heal Potion Pickup", OptionEntryFlags::None, N_("Full Heal Potion Pickup"), N_("Number of Full Healing potions to pick up automatically."), 0, { 0, 1, 2, 4, 8, 16 })
     , numManaPotionPickup("Mana Potion Pickup", OptionEntryFlags::None, N_("Mana Potion Pickup"), N_("Number of Mana potions to pick up automatically."), 0, { 0, 1, 2, 4, 8, 16 })
@@ -1075,6 +1080,7 @@ std::vector<OptionEntryBase *> GameplayOptions::GetEntries()
 		&showItemLabels,
 		&disableCripplingShrines,
 		&quickCast,
+		&reuseLevelLayouts,
 		&autoRefillBelt,
 		&autoPickupInTown,
 		&autoGoldPickup,
@@ -509,6 +509,10 @@ struct GraphicsOptions : OptionCategoryBase {
 #endif
 	/** @brief Enable FPS Limiter. */
 	OptionEntryBoolean limitFPS;
+	/** @brief Use the built-in vectorized blitter to convert (and scale) the 8-bit back buffer for output. */
+	OptionEntryBoolean fastBlitter;
+	/** @brief Keep the rendered floor between frames and only render the parts that scrolled into view or changed. */
+	OptionEntryBoolean floorCache;
 	/** @brief Show item graphics to the left of item descriptions in store menus. */
 	OptionEntryBoolean showItemGraphicsInStores;
 	/** @brief Show FPS, even without the -f command line flag. */
@@ -577,6 +581,8 @@ struct GameplayOptions : OptionCategoryBase {
 	OptionEntryBoolean disableCripplingShrines;
 	/** @brief Spell hotkeys instantly cast the spell. */
 	OptionEntryBoolean quickCast;
+	/** @brief Keep generated level layouts and reuse them when a level is entered again. */
+	OptionEntryBoolean reuseLevelLayouts;
 	/** @brief Number of Healing potions to pick up automatically */
 	OptionEntryInt<int> numHealPotionPickup;
 	/** @brief Number of Full Healing potions to pick up automatically */
@@ -5,8 +5,13 @@
  */
 #include "pfile.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/core.h>
 
@@ -20,10 +25,17 @@
 #include "playerdat.hpp"
 #include "qol/stash.h"
 #include "utils/endian.hpp"
+#include "utils/endian_stream.hpp"
 #include "utils/file_util.h"
 #include "utils/language.h"
+#include "utils/log.hpp"
 #include "utils/paths.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_ptrs.h"
+#include "utils/sdl_thread.h"
 #include "utils/stdcompat/abs.hpp"
+#include "utils/stdcompat/algorithm.hpp"
 #include "utils/stdcompat/string_view.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
@@ -33,6 +45,7 @@
 #include "utils/file_util.h"
 #else
 #include "mpq/mpq_reader.hpp"
+#include "mpq/mpq_sdl_rwops.hpp"
 #endif
 
 namespace devilution {
@@ -95,7 +108,7 @@ bool GetTempSaveNames(uint8_t dwIndex, char *szTemp)
 	return GetSaveNames(dwIndex, "temp", szTemp);
 }
 
-void RenameTempToPerm(SaveWriter &saveWriter)
+void RenameTempToPerm(SaveSnapshot &snapshot)
 {
 	char szTemp[MaxMpqPathSize];
 	char szPerm[MaxMpqPathSize];
@@ -105,11 +118,7 @@ void RenameTempToPerm(SaveWriter &saveWriter)
 		[[maybe_unused]] bool result = GetPermSaveNames(dwIndex, szPerm); // DO NOT PUT DIRECTLY INTO ASSERT!
 		assert(result);
 		dwIndex++;
-		if (saveWriter.HasFile(szTemp)) {
-			if (saveWriter.HasFile(szPerm))
-				saveWriter.RemoveHashEntry(szPerm);
-			saveWriter.RenameFile(szTemp, szPerm);
-		}
+		snapshot.ReplaceFile(szTemp, szPerm);
 	}
 	assert(!GetPermSaveNames(dwIndex, szPerm));
 }
@@ -131,25 +140,273 @@ bool ReadHero(SaveReader &archive, PlayerPack *pPack)
 	return ret;
 }
 
-void EncodeHero(SaveWriter &saveWriter, const PlayerPack *pack)
+void EncodeHero(SaveSnapshot &snapshot, const PlayerPack *pack)
+{
+	std::unique_ptr<byte[]> data { new byte[sizeof(*pack)] };
+	memcpy(data.get(), pack, sizeof(*pack));
+	snapshot.WriteFile("hero", std::move(data), sizeof(*pack));
+}
+
+/** What the character selection screen lists for a save, see `pfile_ui_set_hero_infos`. */
+struct HeroSummary {
+	/** Modification time and size of the save the summary was made from. */
+	int64_t saveTime;
+	uintmax_t saveSize;
+	char name[PlayerNameLength];
+	/** Whether the hero could be unpacked, the others are not listed. */
+	bool listed;
+	_uiheroinfo info;
+};
+
+constexpr uint32_t HeroSummariesMagic = LoadLE32("HSC1");
+
+/** Summaries by save path, heroes whose save hasn't changed are listed without unpacking them. */
+std::unordered_map<std::string, HeroSummary> HeroSummaries;
+bool HeroSummariesLoaded;
+/** Whether summaries were dropped since heroes.cache was last written. */
+bool HeroSummariesDirty;
+
+std::string GetHeroSummariesPath()
+{
+	return StrCat(paths::PrefPath(), "heroes.cache");
+}
+
+void LoadHeroSummaries()
+{
+	HeroSummariesLoaded = true;
+	FILE *file = OpenFile(GetHeroSummariesPath().c_str(), "rb");
+	if (file == nullptr)
+		return;
+
+	if (ReadLE32(file) == HeroSummariesMagic) {
+		const uint32_t count = ReadLE32(file);
+		for (uint32_t i = 0; i < count; i++) {
+			std::string path(ReadLE16(file), '\0');
+			std::fread(&path[0], path.size(), 1, file);
+			HeroSummary summary {};
+			summary.saveTime = ReadLE64<int64_t>(file);
+			summary.saveSize = ReadLE64(file);
+			std::fread(summary.name, sizeof(summary.name), 1, file);
+			summary.listed = ReadByte(file) != 0;
+			std::fread(summary.info.name, sizeof(summary.info.name), 1, file);
+			summary.info.level = ReadByte(file);
+			summary.info.heroclass = static_cast<HeroClass>(ReadByte(file));
+			summary.info.herorank = ReadByte(file);
+			summary.info.strength = ReadLE16(file);
+			summary.info.magic = ReadLE16(file);
+			summary.info.dexterity = ReadLE16(file);
+			summary.info.vitality = ReadLE16(file);
+			summary.info.hassaved = ReadByte(file) != 0;
+			if (std::feof(file) != 0 || std::ferror(file) != 0)
+				break;
+			summary.name[sizeof(summary.name) - 1] = '\0';
+			summary.info.name[sizeof(summary.info.name) - 1] = '\0';
+			HeroSummaries.emplace(std::move(path), summary);
+		}
+	}
+	std::fclose(file);
+}
+
+void SaveHeroSummaries()
+{
+	HeroSummariesDirty = false;
+	FILE *file = OpenFile(GetHeroSummariesPath().c_str(), "wb");
+	if (file == nullptr)
+		return;
+
+	WriteLE32(file, HeroSummariesMagic);
+	WriteLE32(file, static_cast<uint32_t>(HeroSummaries.size()));
+	for (const auto &[path, summary] : HeroSummaries) {
+		WriteLE16(file, static_cast<uint16_t>(path.size()));
+		std::fwrite(path.data(), path.size(), 1, file);
+		WriteLE64(file, static_cast<uint64_t>(summary.saveTime));
+		WriteLE64(file, summary.saveSize);
+		std::fwrite(summary.name, sizeof(summary.name), 1, file);
+		WriteByte(file, summary.listed ? 1 : 0);
+		std::fwrite(summary.info.name, sizeof(summary.info.name), 1, file);
+		WriteByte(file, summary.info.level);
+		WriteByte(file, static_cast<uint8_t>(summary.info.heroclass));
+		WriteByte(file, summary.info.herorank);
+		WriteLE16(file, summary.info.strength);
+		WriteLE16(file, summary.info.magic);
+		WriteLE16(file, summary.info.dexterity);
+		WriteLE16(file, summary.info.vitality);
+		WriteByte(file, summary.info.hassaved ? 1 : 0);
+	}
+	std::fclose(file);
+}
+
+/**
+ * @brief Drops the summary of a save that is being written.
+ *
+ * The modification time may have too coarse a resolution to tell the saves apart.
+ * heroes.cache is only rewritten when the hero list is built again, or on exit.
+ */
+void ForgetHeroSummary(const std::string &savePath)
+{
+	if (!HeroSummariesLoaded)
+		LoadHeroSummaries();
+	if (HeroSummaries.erase(savePath) != 0)
+		HeroSummariesDirty = true;
+}
+
+/** A save waiting to be written by the save thread. */
+struct SaveJob {
+	std::string path;
+	SaveSnapshot snapshot;
+};
+
+SdlMutex SaveJobsMutex;
+/** Signaled when a save is submitted or the save thread is asked to stop. */
+SdlCond SaveJobsCond;
+/** Signaled when the save thread has written a save. */
+SdlCond SaveJobDoneCond;
+/** Pending saves, the front one stays queued while it is being written. */
+std::deque<SaveJob> SaveJobs;
+bool SaveThreadStopping;
+/** The first failure of the save thread, reported by the game thread in `CheckSaveError`. */
+std::string SaveError;
+SdlThread SaveThread;
+
+void SaveThreadHandler()
+{
+	std::unique_lock<SdlMutex> lock(SaveJobsMutex);
+	while (true) {
+		while (SaveJobs.empty() && !SaveThreadStopping)
+			SaveJobsCond.wait(SaveJobsMutex);
+		if (SaveJobs.empty())
+			return;
+
+		const SaveJob &job = SaveJobs.front();
+		lock.unlock();
+		std::string error;
+		{
+			SaveWriter saveWriter { std::string(job.path) };
+			job.snapshot.Apply(saveWriter);
+			error = saveWriter.error();
+		}
+		lock.lock();
+		if (!error.empty() && SaveError.empty())
+			SaveError = std::move(error);
+		SaveJobs.pop_front();
+		SaveJobDoneCond.signal();
+	}
+}
+
+/**
+ * @brief Shows the error of a failed save and quits, app_fatal can't be called from the save thread itself.
+ */
+void CheckSaveError()
+{
+	std::string error;
+	{
+		std::lock_guard<SdlMutex> lock(SaveJobsMutex);
+		error = std::move(SaveError);
+		SaveError.clear();
+	}
+	if (!error.empty())
+		app_fatal(error);
+}
+
+/**
+ * @brief Blocks until the saves pending for the archive at `path` are written, saves of other archives carry on.
+ */
+void WaitForSaves(const std::string &path)
 {
-	saveWriter.WriteFile("hero", reinterpret_cast<const byte *>(pack), sizeof(*pack));
+	{
+		std::unique_lock<SdlMutex> lock(SaveJobsMutex);
+		while (std::any_of(SaveJobs.begin(), SaveJobs.end(), [&path](const SaveJob &job) { return job.path == path; }))
+			SaveJobDoneCond.wait(SaveJobsMutex);
+	}
+	CheckSaveError();
 }
 
-SaveWriter GetSaveWriter(uint32_t saveNum)
+/**
+ * @brief Hands a snapshot to the save thread, saves are written in the order they are submitted.
+ */
+void SubmitSave(std::string &&path, SaveSnapshot &&snapshot)
 {
-	return SaveWriter(GetSavePath(saveNum));
+	if (snapshot.empty())
+		return;
+
+	ForgetHeroSummary(path);
+	{
+		std::lock_guard<SdlMutex> lock(SaveJobsMutex);
+		SaveJobs.push_back({ std::move(path), std::move(snapshot) });
+	}
+	SaveJobsCond.signal();
+	if (!SaveThread.joinable())
+		SaveThread = SdlThread { SaveThreadHandler };
 }
 
-SaveWriter GetStashWriter()
+/** A level state saved by `pfile_save_level`. */
+struct CachedLevel {
+	std::string name;
+	std::unique_ptr<byte[]> data;
+	size_t size;
+	/** Whether the save archive lacks this state. */
+	bool unwritten;
+};
+
+/** Total size of the level states kept in memory, older ones are written to the save archive beyond this. */
+constexpr size_t LevelCacheBudget = 4 * 1024 * 1024;
+
+/** Level states of the current game, the most recently saved one first. */
+std::vector<CachedLevel> LevelCache;
+size_t LevelCacheSize;
+
+std::vector<CachedLevel>::iterator FindCachedLevel(const char *name)
 {
-	return SaveWriter(GetStashSavePath());
+	return std::find_if(LevelCache.begin(), LevelCache.end(), [name](const CachedLevel &level) {
+		return level.name == name;
+	});
+}
+
+void CacheLevel(std::string &&name, std::unique_ptr<byte[]> data, size_t size)
+{
+	auto it = FindCachedLevel(name.c_str());
+	if (it != LevelCache.end()) {
+		LevelCacheSize -= it->size;
+		LevelCache.erase(it);
+	}
+	LevelCache.insert(LevelCache.begin(), { std::move(name), std::move(data), size, true });
+	LevelCacheSize += size;
+
+	SaveSnapshot evicted;
+	while (LevelCacheSize > LevelCacheBudget && LevelCache.size() > 1) {
+		CachedLevel &level = LevelCache.back();
+		if (level.unwritten)
+			evicted.WriteFile(level.name.c_str(), std::move(level.data), level.size);
+		LevelCacheSize -= level.size;
+		LevelCache.pop_back();
+	}
+	SubmitSave(GetSavePath(gSaveNumber), std::move(evicted));
+}
+
+/**
+ * @brief Records writing the cached level states that the save archive lacks.
+ * @param markWritten Whether `snapshot` goes to the save archive of the current game
+ */
+void WriteCachedLevels(SaveSnapshot &snapshot, bool markWritten)
+{
+	// Oldest first, the same order they would have been written in without the cache.
+	for (auto it = LevelCache.rbegin(); it != LevelCache.rend(); ++it) {
+		if (!it->unwritten)
+			continue;
+		std::unique_ptr<byte[]> data { new byte[it->size] };
+		memcpy(data.get(), it->data.get(), it->size);
+		snapshot.WriteFile(it->name.c_str(), std::move(data), it->size);
+		if (markWritten)
+			it->unwritten = false;
+	}
 }
 
 #ifndef DISABLE_DEMOMODE
 void CopySaveFile(uint32_t saveNum, std::string targetPath)
 {
 	const std::string savePath = GetSavePath(saveNum);
+	WaitForSaves(savePath);
+	WaitForSaves(targetPath);
 	CopyFileOverwrite(savePath.c_str(), targetPath.c_str());
 }
 #endif
@@ -195,13 +452,16 @@ bool ArchiveContainsGame(SaveReader &hsArchive)
 	if (gbIsMultiplayer)
 		return false;
 
-	auto gameData = ReadArchive(hsArchive, "game");
+	// Only the header is needed, the rest of the file is not decompressed.
+	SDLRWopsUniquePtr gameData { OpenArchiveStream(hsArchive, "game") };
 	if (gameData == nullptr)
 		return false;
 
-	uint32_t hdr = LoadLE32(gameData.get());
+	uint32_t hdr;
+	if (SDL_RWread(gameData.get(), &hdr, sizeof(hdr), 1) != 1)
+		return false;
 
-	return IsHeaderValid(hdr);
+	return IsHeaderValid(SDL_SwapLE32(hdr));
 }
 
 std::optional<SaveReader> CreateSaveReader(std::string &&path)
@@ -216,20 +476,94 @@ std::optional<SaveReader> CreateSaveReader(std::string &&path)
 #endif
 }
 
-void pfile_write_hero(SaveWriter &saveWriter, bool writeGameData)
+bool GetSaveStamp(const std::string &savePath, int64_t &time, uintmax_t &size)
+{
+#ifdef UNPACKED_SAVES
+	// The files of an unpacked save are replaced one by one, the directory itself need not change.
+	bool found = false;
+	time = 0;
+	size = 0;
+	for (const char *name : { "hero", "heroitems", "game" }) {
+		const std::string path = savePath + name;
+		int64_t fileTime;
+		uintmax_t fileSize;
+		if (!GetFileModificationTime(path.c_str(), &fileTime) || !GetFileSize(path.c_str(), &fileSize))
+			continue;
+		time = std::max(time, fileTime);
+		size += fileSize;
+		found = true;
+	}
+	return found;
+#else
+	return GetFileModificationTime(savePath.c_str(), &time) && GetFileSize(savePath.c_str(), &size);
+#endif
+}
+
+/** The files of a save that are needed to list the hero, read on a worker thread. */
+struct HeroSaveContents {
+	uint32_t saveNumber;
+	std::string path;
+	int64_t saveTime;
+	uintmax_t saveSize;
+	bool hasHero = false;
+	PlayerPack pack;
+	std::unique_ptr<byte[]> items;
+	size_t itemsSize = 0;
+	bool hasSaveGame = false;
+};
+
+void ReadHeroSaveContents(HeroSaveContents &contents)
+{
+	std::optional<SaveReader> archive = CreateSaveReader(std::string(contents.path));
+	if (!archive || !ReadHero(*archive, &contents.pack))
+		return;
+	contents.hasHero = true;
+	contents.items = ReadArchive(*archive, "heroitems", &contents.itemsSize);
+	contents.hasSaveGame = ArchiveContainsGame(*archive);
+}
+
+struct HeroSaveReaders {
+	std::vector<HeroSaveContents> *saves;
+	std::atomic<size_t> next;
+};
+
+int SDLCALL HeroSaveReaderThread(void *data)
+{
+	HeroSaveReaders &readers = *static_cast<HeroSaveReaders *>(data);
+	for (size_t i = readers.next++; i < readers.saves->size(); i = readers.next++)
+		ReadHeroSaveContents((*readers.saves)[i]);
+	return 0;
+}
+
+/**
+ * @brief Reads the saves on a few threads, each save is an independent archive.
+ */
+void ReadHeroSaves(std::vector<HeroSaveContents> &saves)
+{
+	HeroSaveReaders readers { &saves, 0 };
+	const size_t threadCount = std::min<size_t>(saves.size(), clamp(SDL_GetCPUCount(), 1, 8));
+	std::vector<SdlThread> threads;
+	for (size_t i = 1; i < threadCount; i++)
+		threads.emplace_back(HeroSaveReaderThread, &readers);
+	HeroSaveReaderThread(&readers);
+	for (SdlThread &thread : threads)
+		thread.join();
+}
+
+void pfile_write_hero(SaveSnapshot &snapshot, bool writeGameData)
 {
 	if (writeGameData) {
-		SaveGameData(saveWriter);
-		RenameTempToPerm(saveWriter);
+		SaveGameData(snapshot);
+		RenameTempToPerm(snapshot);
 	}
 	PlayerPack pkplr;
 	Player &myPlayer = *MyPlayer;
 
 	PackPlayer(&pkplr, myPlayer, !gbIsMultiplayer, false);
-	EncodeHero(saveWriter, &pkplr);
+	EncodeHero(snapshot, &pkplr);
 	if (true) {
-		SaveHotkeys(saveWriter, myPlayer);
-		SaveHeroItems(saveWriter, myPlayer);
+		SaveHotkeys(snapshot, myPlayer);
+		SaveHeroItems(snapshot, myPlayer);
 	}
 }
 
@@ -267,10 +601,14 @@ bool SaveWriter::WriteFile(const char *filename, const byte *data, size_t size)
 	const std::string path = dir_ + filename;
 	FILE *file = OpenFile(path.c_str(), "wb");
 	if (file == nullptr) {
+		if (error_.empty())
+			error_ = StrCat("Failed to open ", path, " for writing");
 		return false;
 	}
 	if (std::fwrite(data, size, 1, file) != 1) {
 		std::fclose(file);
+		if (error_.empty())
+			error_ = StrCat("Failed to write ", path);
 		return false;
 	}
 	std::fclose(file);
@@ -287,14 +625,76 @@ void SaveWriter::RemoveHashEntries(bool (*fnGetName)(uint8_t, char *))
 }
 #endif
 
+void SaveSnapshot::WriteFile(const char *filename, std::unique_ptr<byte[]> data, size_t size)
+{
+	operations_.push_back({ OperationType::Write, filename, {}, std::move(data), size });
+}
+
+void SaveSnapshot::RemoveHashEntries(bool (*fnGetName)(uint8_t, char *))
+{
+	char pszFileName[MaxMpqPathSize];
+
+	for (uint8_t i = 0; fnGetName(i, pszFileName); i++) {
+		operations_.push_back({ OperationType::Remove, pszFileName, {}, nullptr, 0 });
+	}
+}
+
+void SaveSnapshot::ReplaceFile(const char *from, const char *to)
+{
+	operations_.push_back({ OperationType::Replace, from, to, nullptr, 0 });
+}
+
+void SaveSnapshot::Apply(SaveWriter &saveWriter) const
+{
+	for (const Operation &operation : operations_) {
+		if (!saveWriter.error().empty())
+			return;
+		const char *filename = operation.filename.c_str();
+		switch (operation.type) {
+		case OperationType::Write:
+			saveWriter.WriteFile(filename, operation.data.get(), operation.size);
+			break;
+		case OperationType::Remove:
+			saveWriter.RemoveHashEntry(filename);
+			break;
+		case OperationType::Replace:
+			if (saveWriter.HasFile(filename)) {
+				if (saveWriter.HasFile(operation.newFilename.c_str()))
+					saveWriter.RemoveHashEntry(operation.newFilename.c_str());
+				saveWriter.RenameFile(filename, operation.newFilename.c_str());
+			}
+			break;
+		}
+	}
+}
+
+std::unique_ptr<byte[]> SaveSnapshot::TakeFile(const char *filename, size_t *pdwLen)
+{
+	auto it = std::find_if(operations_.begin(), operations_.end(), [filename](const Operation &operation) {
+		return operation.type == OperationType::Write && operation.filename == filename;
+	});
+	if (it == operations_.end())
+		return nullptr;
+
+	std::unique_ptr<byte[]> data = std::move(it->data);
+	if (pdwLen != nullptr)
+		*pdwLen = it->size;
+	operations_.erase(it);
+	return data;
+}
+
 std::optional<SaveReader> OpenSaveArchive(uint32_t saveNum)
 {
-	return CreateSaveReader(GetSavePath(saveNum));
+	std::string path = GetSavePath(saveNum);
+	WaitForSaves(path);
+	return CreateSaveReader(std::move(path));
 }
 
 std::optional<SaveReader> OpenStashArchive()
 {
-	return CreateSaveReader(GetStashSavePath());
+	std::string path = GetStashSavePath();
+	WaitForSaves(path);
+	return CreateSaveReader(std::move(path));
 }
 
 std::unique_ptr<byte[]> ReadArchive(SaveReader &archive, const char *pszName, size_t *pdwLen)
@@ -312,10 +712,27 @@ std::unique_ptr<byte[]> ReadArchive(SaveReader &archive, const char *pszName, si
 	return result;
 }
 
+SDL_RWops *OpenArchiveStream(SaveReader &archive, const char *pszName)
+{
+#ifdef UNPACKED_SAVES
+	if (!archive.HasFile(pszName))
+		return nullptr;
+	return SDL_RWFromFile((archive.dir() + pszName).c_str(), "rb");
+#else
+	uint32_t fileNumber;
+	if (!archive.GetFileNumber(MpqArchive::CalculateFileHash(pszName), fileNumber))
+		return nullptr;
+	return SDL_RWops_FromMpqFile(archive, fileNumber, pszName, /*threadsafe=*/false);
+#endif
+}
+
 void pfile_write_hero(bool writeGameData)
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
-	pfile_write_hero(saveWriter, writeGameData);
+	SaveSnapshot snapshot;
+	if (writeGameData)
+		WriteCachedLevels(snapshot, /*markWritten=*/true);
+	pfile_write_hero(snapshot, writeGameData);
+	SubmitSave(GetSavePath(gSaveNumber), std::move(snapshot));
 }
 
 #ifndef DISABLE_DEMOMODE
@@ -323,8 +740,10 @@ void pfile_write_hero_demo(int demo)
 {
 	std::string savePath = GetSavePath(gSaveNumber, StrCat("demo_", demo, "_reference_"));
 	CopySaveFile(gSaveNumber, savePath);
-	auto saveWriter = SaveWriter(savePath.c_str());
-	pfile_write_hero(saveWriter, true);
+	SaveSnapshot snapshot;
+	WriteCachedLevels(snapshot, /*markWritten=*/false);
+	pfile_write_hero(snapshot, true);
+	SubmitSave(std::move(savePath), std::move(snapshot));
 }
 #endif
 
@@ -333,9 +752,10 @@ void sfile_write_stash()
 	if (!Stash.dirty)
 		return;
 
-	SaveWriter stashWriter = GetStashWriter();
+	SaveSnapshot snapshot;
 
-	SaveStash(stashWriter);
+	SaveStash(snapshot);
+	SubmitSave(GetStashSavePath(), std::move(snapshot));
 
 	Stash.dirty = false;
 }
@@ -344,34 +764,72 @@ bool pfile_ui_set_hero_infos(bool (*uiAddHeroInfo)(_uiheroinfo *))
 {
 	memset(hero_names, 0, sizeof(hero_names));
 
+	if (!HeroSummariesLoaded)
+		LoadHeroSummaries();
+
+	bool summariesChanged = false;
+	std::vector<HeroSaveContents> changedSaves;
 	for (uint32_t i = 0; i < MAX_CHARACTERS; i++) {
-		std::optional<SaveReader> archive = OpenSaveArchive(i);
-		if (archive) {
-			PlayerPack pkplr;
-			if (ReadHero(*archive, &pkplr)) {
-				_uiheroinfo uihero;
-				uihero.saveNumber = i;
-				strcpy(hero_names[i], pkplr.pName);
-				bool hasSaveGame = ArchiveContainsGame(*archive);
-				if (hasSaveGame)
-					pkplr.bIsHellfire = 1;
-
-				Player &player = Players[0];
-
-				player = {};
-
-				if (UnPackPlayer(&pkplr, player, false)) {
-					LoadHeroItems(player);
-					RemoveEmptyInventory(player);
-					CalcPlrInv(player, false);
-
-					Game2UiPlayer(player, &uihero, hasSaveGame);
-					uiAddHeroInfo(&uihero);
-				}
-			}
+		std::string path = GetSavePath(i);
+		// The saves are read directly from the worker threads.
+		WaitForSaves(path);
+		int64_t saveTime;
+		uintmax_t saveSize;
+		if (!GetSaveStamp(path, saveTime, saveSize)) {
+			summariesChanged |= HeroSummaries.erase(path) != 0;
+			continue;
+		}
+		auto it = HeroSummaries.find(path);
+		if (it != HeroSummaries.end() && it->second.saveTime == saveTime && it->second.saveSize == saveSize)
+			continue;
+		changedSaves.push_back({ i, std::move(path), saveTime, saveSize });
+	}
+	ReadHeroSaves(changedSaves);
+
+	// Unpacking recreates the items through the shared item recreation cache and marks them in `UniqueItemFlags`,
+	// so it stays on this thread.
+	auto player = std::make_unique<Player>();
+	for (HeroSaveContents &save : changedSaves) {
+		if (!save.hasHero) {
+			summariesChanged |= HeroSummaries.erase(save.path) != 0;
+			continue;
+		}
+		HeroSummary summary {};
+		summary.saveTime = save.saveTime;
+		summary.saveSize = save.saveSize;
+		CopyUtf8(summary.name, save.pack.pName, sizeof(summary.name));
+		if (save.hasSaveGame)
+			save.pack.bIsHellfire = 1;
+
+		*player = {};
+		if (UnPackPlayer(&save.pack, *player, false)) {
+			LoadHeroItems(*player, std::move(save.items), save.itemsSize);
+			RemoveEmptyInventory(*player);
+			CalcPlrInv(*player, false);
+
+			Game2UiPlayer(*player, &summary.info, save.hasSaveGame);
+			summary.listed = true;
+		}
+		HeroSummaries[save.path] = summary;
+		summariesChanged = true;
+	}
+
+	for (uint32_t i = 0; i < MAX_CHARACTERS; i++) {
+		auto it = HeroSummaries.find(GetSavePath(i));
+		if (it == HeroSummaries.end())
+			continue;
+		const HeroSummary &summary = it->second;
+		strcpy(hero_names[i], summary.name);
+		if (summary.listed) {
+			_uiheroinfo uihero = summary.info;
+			uihero.saveNumber = i;
+			uiAddHeroInfo(&uihero);
 		}
 	}
 
+	if (summariesChanged || HeroSummariesDirty)
+		SaveHeroSummaries();
+
 	return true;
 }
 
@@ -404,20 +862,21 @@ bool pfile_ui_save_create(_uiheroinfo *heroinfo)
 
 	giNumberOfLevels = 25;
 
-	SaveWriter saveWriter = GetSaveWriter(saveNum);
-	saveWriter.RemoveHashEntries(GetFileName);
+	SaveSnapshot snapshot;
+	snapshot.RemoveHashEntries(GetFileName);
 	CopyUtf8(hero_names[saveNum], heroinfo->name, sizeof(hero_names[saveNum]));
 
 	Player &player = Players[0];
 	CreatePlayer(player, heroinfo->heroclass);
 	CopyUtf8(player._pName, heroinfo->name, PlayerNameLength);
 	PackPlayer(&pkplr, player, true, false);
-	EncodeHero(saveWriter, &pkplr);
+	EncodeHero(snapshot, &pkplr);
 	Game2UiPlayer(player, heroinfo, false);
 	if (true) {
-		SaveHotkeys(saveWriter, player);
-		SaveHeroItems(saveWriter, player);
+		SaveHotkeys(snapshot, player);
+		SaveHeroItems(snapshot, player);
 	}
+	SubmitSave(GetSavePath(saveNum), std::move(snapshot));
 
 	return true;
 }
@@ -427,7 +886,9 @@ bool pfile_delete_save(_uiheroinfo *heroInfo)
 	uint32_t saveNum = heroInfo->saveNumber;
 	if (saveNum < MAX_CHARACTERS) {
 		hero_names[saveNum][0] = '\0';
-		RemoveFile(GetSavePath(saveNum).c_str());
+		const std::string path = GetSavePath(saveNum);
+		WaitForSaves(path);
+		RemoveFile(path.c_str());
 	}
 	return true;
 }
@@ -460,29 +921,60 @@ void pfile_read_player_from_save(uint32_t saveNum, Player &player)
 
 void pfile_save_level()
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
-	SaveLevel(saveWriter);
+	SaveSnapshot snapshot;
+	SaveLevel(snapshot);
+
+	char szName[MaxMpqPathSize];
+	GetTempLevelNames(szName);
+	size_t size;
+	std::unique_ptr<byte[]> level = snapshot.TakeFile(szName, &size);
+	assert(level != nullptr);
+
+	// SaveLevel allocates for the largest possible level, only keep what was used.
+	std::unique_ptr<byte[]> data { new byte[size] };
+	memcpy(data.get(), level.get(), size);
+	CacheLevel(szName, std::move(data), size);
+}
+
+std::unique_ptr<byte[]> pfile_read_cached_level(const char *pszName, size_t *pdwLen)
+{
+	auto it = FindCachedLevel(pszName);
+	if (it == LevelCache.end())
+		return nullptr;
+
+	std::unique_ptr<byte[]> data { new byte[it->size] };
+	memcpy(data.get(), it->data.get(), it->size);
+	if (pdwLen != nullptr)
+		*pdwLen = it->size;
+	return data;
 }
 
 void pfile_convert_levels()
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
-	ConvertLevels(saveWriter);
+	SaveSnapshot snapshot;
+	ConvertLevels(snapshot);
+	SubmitSave(GetSavePath(gSaveNumber), std::move(snapshot));
 }
 
 void pfile_remove_temp_files()
 {
+	LevelCache.clear();
+	LevelCacheSize = 0;
+
 	if (gbIsMultiplayer)
 		return;
 
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
-	saveWriter.RemoveHashEntries(GetTempSaveNames);
+	SaveSnapshot snapshot;
+	snapshot.RemoveHashEntries(GetTempSaveNames);
+	SubmitSave(GetSavePath(gSaveNumber), std::move(snapshot));
 }
 
 void pfile_update(bool forceSave)
 {
 	static Uint32 prevTick;
 
+	CheckSaveError();
+
 	if (!gbIsMultiplayer)
 		return;
 
@@ -495,4 +987,30 @@ void pfile_update(bool forceSave)
 	sfile_write_stash();
 }
 
+void pfile_write_hero_summaries()
+{
+	if (HeroSummariesDirty)
+		SaveHeroSummaries();
+}
+
+void pfile_flush_saves()
+{
+	// Also reached through ErrSdl on the save thread itself.
+	if (!SaveThread.joinable() || SaveThread.get_id() == this_sdl_thread::get_id())
+		return;
+
+	{
+		std::lock_guard<SdlMutex> lock(SaveJobsMutex);
+		SaveThreadStopping = true;
+	}
+	SaveJobsCond.signal();
+	SaveThread.join();
+	SaveThreadStopping = false;
+	// This runs while quitting, which app_fatal would reach again.
+	if (!SaveError.empty()) {
+		LogError("{}", SaveError);
+		SaveError.clear();
+	}
+}
+
 } // namespace devilution
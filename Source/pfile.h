@@ -5,6 +5,12 @@
  */
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
 #include "DiabloUI/diabloui.h"
 #include "player.h"
 
@@ -69,8 +75,15 @@ struct SaveWriter {
 
 	void RemoveHashEntries(bool (*fnGetName)(uint8_t, char *));
 
+	/** @brief Describes the first failed write, empty if none failed. */
+	const std::string &error() const
+	{
+		return error_;
+	}
+
 private:
 	std::string dir_;
+	std::string error_;
 };
 
 #else
@@ -78,9 +91,74 @@ using SaveReader = MpqArchive;
 using SaveWriter = MpqWriter;
 #endif
 
+/**
+ * @brief The changes a save makes to a save archive, recorded in memory.
+ *
+ * Saves are serialized into a snapshot on the game thread, the save thread then
+ * compresses the files and writes them to the archive in the order they were recorded.
+ */
+class SaveSnapshot {
+public:
+	/**
+	 * @brief Records writing a file, taking ownership of its contents.
+	 */
+	void WriteFile(const char *filename, std::unique_ptr<byte[]> data, size_t size);
+
+	/**
+	 * @brief Records removing the files named by `fnGetName`, which is called right away.
+	 */
+	void RemoveHashEntries(bool (*fnGetName)(uint8_t, char *));
+
+	/**
+	 * @brief Records renaming `from` to `to`, replacing `to`, if `from` exists at that point.
+	 */
+	void ReplaceFile(const char *from, const char *to);
+
+	/**
+	 * @brief Applies the recorded changes to the archive, stopping at the first failure.
+	 */
+	void Apply(SaveWriter &saveWriter) const;
+
+	/**
+	 * @brief Moves the contents of a recorded file write out of the snapshot, dropping the write.
+	 * @return nullptr if the snapshot does not write `filename`
+	 */
+	std::unique_ptr<byte[]> TakeFile(const char *filename, size_t *pdwLen);
+
+	bool empty() const
+	{
+		return operations_.empty();
+	}
+
+private:
+	enum class OperationType : uint8_t {
+		Write,
+		Remove,
+		Replace,
+	};
+
+	struct Operation {
+		OperationType type;
+		std::string filename;
+		std::string newFilename;
+		std::unique_ptr<byte[]> data;
+		size_t size;
+	};
+
+	std::vector<Operation> operations_;
+};
+
 std::optional<SaveReader> OpenSaveArchive(uint32_t saveNum);
 std::optional<SaveReader> OpenStashArchive();
 std::unique_ptr<byte[]> ReadArchive(SaveReader &archive, const char *pszName, size_t *pdwLen = nullptr);
+
+/**
+ * @brief Opens a file in a save archive for reading parts of it, without decompressing all of it.
+ *
+ * The stream refers to `archive`, which has to outlive it.
+ * @return nullptr if the file does not exist
+ */
+SDL_RWops *OpenArchiveStream(SaveReader &archive, const char *pszName);
 void pfile_write_hero(bool writeGameData = false);
 
 #ifndef DISABLE_DEMOMODE
@@ -98,10 +176,34 @@ uint32_t pfile_ui_get_first_unused_save_num();
 bool pfile_ui_save_create(_uiheroinfo *heroinfo);
 bool pfile_delete_save(_uiheroinfo *heroInfo);
 void pfile_read_player_from_save(uint32_t saveNum, Player &player);
+/**
+ * @brief Saves the state of the current level, to be restored by `LoadLevel` when the player returns.
+ *
+ * The state is kept in memory and only written to the save archive when the game is saved,
+ * or when the cached level states exceed their memory budget.
+ */
 void pfile_save_level();
+
+/**
+ * @brief Returns a copy of a level state saved by `pfile_save_level` that is still in memory.
+ * @return nullptr if the level state is not cached, it then has to be read from the save archive
+ */
+std::unique_ptr<byte[]> pfile_read_cached_level(const char *pszName, size_t *pdwLen);
 void pfile_convert_levels();
 void pfile_remove_temp_files();
 std::unique_ptr<byte[]> pfile_read(const char *pszName, size_t *pdwLen);
 void pfile_update(bool forceSave);
 
+/**
+ * @brief Writes heroes.cache if summaries were dropped for saves written since the hero list was built.
+ */
+void pfile_write_hero_summaries();
+
+/**
+ * @brief Writes all pending saves to disk and stops the save thread, called on exit.
+ *
+ * Reading a save archive only waits for the saves pending for that archive.
+ */
+void pfile_flush_saves();
+
 } // namespace devilution
@@ -15,12 +15,12 @@
 #ifdef _DEBUG
 #include "debug.h"
 #endif
+#include "engine/animation_store.hpp"
 #include "engine/backbuffer_state.hpp"
 #include "engine/load_cl2.hpp"
 #include "engine/load_file.hpp"
 #include "engine/points_in_rectangle_range.hpp"
 #include "engine/random.hpp"
-#include "engine/render/clx_render.hpp"
 #include "engine/trn.hpp"
 #include "engine/world_tile.hpp"
 #include "gamemenu.h"
@@ -2159,11 +2159,14 @@ void LoadPlrGFX(Player &player, player_graphic graphic)
 	char pszName[256];
 	*fmt::format_to(pszName, R"(plrgfx\{0}\{1}\{1}{2})", path, string_view(prefix, 3), szCel) = 0;
 	const uint16_t animationWidth = GetPlayerSpriteWidth(cls, graphic, animWeaponId);
-	animationData.sprites = LoadCl2Sheet(pszName, animationWidth);
-	std::optional<std::array<uint8_t, 256>> trn = GetClassTRN(player);
-	if (trn) {
-		ClxApplyTrans(*animationData.sprites, trn->data());
-	}
+	AnimationSheetTrn trn;
+	trn.path = GetClassTRNPath(player);
+	trn.optional = true;
+	// Players of the same class wearing the same gear share the sheet.
+	animationData.sheet = RequestAnimationSheet(StrCat(pszName, DEVILUTIONX_CL2_EXT), animationWidth, trn);
+	WaitForAnimationSheet(*animationData.sheet);
+	animationData.sheet->checkError();
+	animationData.sprites = animationData.sheet->sprites()->sheet();
 }
 
 void InitPlayerGFX(Player &player)
@@ -2192,6 +2195,7 @@ void ResetPlayerGFX(Player &player)
 	player.AnimInfo.sprites = std::nullopt;
 	for (PlayerAnimationData &animData : player.AnimationData) {
 		animData.sprites = std::nullopt;
+		animData.sheet = nullptr;
 	}
 }
 
@@ -2623,12 +2627,14 @@ void PlrClrTrans(Point position)
 			TransList[dTransVal[j][i]] = false;
 		}
 	}
+	TransListVersion++;
 }
 
 void PlrDoTrans(Point position)
 {
 	if (IsNoneOf(leveltype, DTYPE_CATHEDRAL, DTYPE_CATACOMBS, DTYPE_CRYPT)) {
 		TransList[1] = true;
+		TransListVersion++;
 		return;
 	}
 
@@ -2639,6 +2645,7 @@ void PlrDoTrans(Point position)
 			}
 		}
 	}
+	TransListVersion++;
 }
 
 void SetPlayerOld(Player &player)
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <algorithm>
@@ -29,6 +30,8 @@
 
 namespace devilution {
 
+class AnimationSheet;
+
 constexpr int InventoryGridCells = 40;
 constexpr int MaxBeltItems = 8;
 constexpr int MaxResistance = 75;
@@ -195,10 +198,15 @@ constexpr std::array<char, 6> CharChar = {
  * @brief Contains Data (CelSprites) for a player graphic (player_graphic)
  */
 struct PlayerAnimationData {
+	/**
+	 * @brief The file holding the sprites, shared with other players using the same graphic.
+	 */
+	std::shared_ptr<AnimationSheet> sheet;
+
 	/**
 	 * @brief Sprite lists for each of the 8 directions.
 	 */
-	OptionalOwnedClxSpriteSheet sprites;
+	OptionalClxSpriteSheet sprites;
 
 	[[nodiscard]] ClxSpriteList spritesForDirection(Direction direction) const
 	{
@@ -366,6 +374,12 @@ struct Player {
 	uint16_t wReflections;
 	_difficulty pDifficulty;
 	ItemSpecialEffectHf pDamAcFlags;
+	/** @brief What each equipped item added to the stats at the last `CalcPlrItemVals`. */
+	ItemStatContribution equippedItemSlotStats[NUM_INVLOC] {};
+	/** @brief The equipped items that `equippedItemSlotStats` were computed from. */
+	ItemStatKey equippedItemSlotKeys[NUM_INVLOC] {};
+	/** @brief Sum of `equippedItemSlotStats`, updated only for the slots whose contribution changed. */
+	ItemStatContribution equippedItemStats {};
 
 	void CalcScrolls();
 
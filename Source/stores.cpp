@@ -24,6 +24,7 @@
 #include "qol/stash.h"
 #include "towners.h"
 #include "utils/format_int.hpp"
+#include "utils/sdl_thread.h"
 #include "utils/language.h"
 #include "utils/stdcompat/string_view.hpp"
 #include "utils/str_cat.hpp"
@@ -128,6 +129,19 @@ _speech_id gossipend;
 /** Temporary item used to hold the the item being traided */
 Item StoreItem;
 
+/** Everything the vendors' stock depends on, captured when entering town. */
+struct QueuedTownStores {
+	uint32_t seed;
+	int storeLevel;
+	int boyLevel;
+	/** Where spawning the stock left the RNG, set by the worker. */
+	uint32_t endSeed;
+};
+
+/** Stock being spawned by `TownStoresThread`, until `FinishTownStores` collects it. */
+std::optional<QueuedTownStores> QueuedStores;
+SdlThread TownStoresThread;
+
 /** Maps from towner IDs to NPC names. */
 const char *const TownerNames[] = {
 	N_("Griswold"),
@@ -2193,6 +2207,18 @@ void DrawSelector(const Surface &out, const Rectangle &rect, string_view text, U
 	ClxDraw(out, { x2, rect.position.y + 13 }, (*pSPentSpn2Cels)[PentSpn2Spin()]);
 }
 
+void SpawnQueuedTownStores()
+{
+	QueuedTownStores &stores = *QueuedStores;
+	SetRndSeed(stores.seed);
+	SpawnSmith(stores.storeLevel);
+	SpawnWitch(stores.storeLevel);
+	SpawnHealer(stores.storeLevel);
+	SpawnBoy(stores.boyLevel);
+	SpawnPremium(*MyPlayer);
+	stores.endSeed = GetLCGEngineState();
+}
+
 } // namespace
 
 void AddStoreHoldRepair(Item *itm, int8_t i)
@@ -2234,11 +2260,14 @@ void InitStores()
 	boylevel = 0;
 }
 
-void SetupTownStores()
+void QueueTownStores()
 {
+	FinishTownStores();
+
 	Player &myPlayer = *MyPlayer;
 
 	int l = myPlayer._pLevel / 2;
+	uint32_t seed = GetLCGEngineState();
 	if (!gbIsMultiplayer) {
 		l = 0;
 		for (int i = 0; i < NUMLEVELS; i++) {
@@ -2246,15 +2275,28 @@ void SetupTownStores()
 				l = i;
 		}
 	} else {
-		SetRndSeed(glSeedTbl[currlevel] * SDL_GetTicks());
+		seed = glSeedTbl[currlevel] * SDL_GetTicks();
 	}
 
-	l = clamp(l + 2, 6, 16);
-	SpawnSmith(l);
-	SpawnWitch(l);
-	SpawnHealer(l);
-	SpawnBoy(myPlayer._pLevel);
-	SpawnPremium(myPlayer);
+	QueuedStores = QueuedTownStores { seed, clamp(l + 2, 6, 16), myPlayer._pLevel, 0 };
+	// The RNG state is per thread, so the worker's rolls don't disturb the level loader's.
+	TownStoresThread = SdlThread { SpawnQueuedTownStores };
+}
+
+void FinishTownStores()
+{
+	if (!QueuedStores)
+		return;
+	TownStoresThread.join();
+	// Continue from where spawning the stock on this thread would have left the RNG, the rubble in town is rolled from there.
+	SetRndSeed(QueuedStores->endSeed);
+	QueuedStores = std::nullopt;
+}
+
+void SetupTownStores()
+{
+	QueueTownStores();
+	FinishTownStores();
 }
 
 void FreeStoreMem()
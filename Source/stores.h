@@ -57,30 +57,45 @@ extern int8_t storehidx[48];
 extern DVL_API_FOR_TEST Item storehold[48];
 
 /** Items sold by Griswold */
-extern Item smithitem[SMITH_ITEMS];
+extern DVL_API_FOR_TEST Item smithitem[SMITH_ITEMS];
 /** Number of premium items for sale by Griswold */
 extern int numpremium;
 /** Base level of current premium items sold by Griswold */
 extern int premiumlevel;
 /** Premium items sold by Griswold */
-extern Item premiumitems[SMITH_PREMIUM_ITEMS];
+extern DVL_API_FOR_TEST Item premiumitems[SMITH_PREMIUM_ITEMS];
 
 /** Items sold by Pepin */
-extern Item healitem[20];
+extern DVL_API_FOR_TEST Item healitem[20];
 
 /** Items sold by Adria */
-extern Item witchitem[WITCH_ITEMS];
+extern DVL_API_FOR_TEST Item witchitem[WITCH_ITEMS];
 
 /** Current level of the item sold by Wirt */
 extern int boylevel;
 /** Current item sold by Wirt */
-extern Item boyitem;
+extern DVL_API_FOR_TEST Item boyitem;
 
 void AddStoreHoldRepair(Item *itm, int8_t i);
 
 /** Clears premium items sold by Griswold and Wirt. */
 void InitStores();
 
+/**
+ * @brief Starts spawning the vendors' stock on a worker thread, from the current RNG state.
+ *
+ * Used when entering town, so that the stock is spawned while the level graphics load.
+ * Nothing may read or write the store items or the local player until `FinishTownStores` returns.
+ */
+void QueueTownStores();
+
+/**
+ * @brief Waits for the stock queued by `QueueTownStores`, if any.
+ *
+ * Leaves the RNG where spawning the stock directly would have left it.
+ */
+void FinishTownStores();
+
 /** Spawns items sold by vendors, including premium items sold by Griswold and Wirt. */
 void SetupTownStores();
 
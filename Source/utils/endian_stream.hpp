@@ -34,6 +34,15 @@ T ReadLE32(FILE *stream)
 	return static_cast<T>(LoadLE32(buf));
 }
 
+template <typename T = uint64_t>
+T ReadLE64(FILE *stream)
+{
+	static_assert(sizeof(T) == 8, "invalid argument");
+	const uint64_t low = ReadLE32(stream);
+	const uint64_t high = ReadLE32(stream);
+	return static_cast<T>(high << 32 | low);
+}
+
 inline float ReadLEFloat(FILE *stream)
 {
 	static_assert(sizeof(float) == sizeof(uint32_t), "invalid float size");
@@ -62,6 +71,12 @@ inline void WriteLE32(FILE *out, uint32_t val)
 	std::fwrite(data, sizeof(data), 1, out);
 }
 
+inline void WriteLE64(FILE *out, uint64_t val)
+{
+	WriteLE32(out, static_cast<uint32_t>(val));
+	WriteLE32(out, static_cast<uint32_t>(val >> 32));
+}
+
 inline void WriteLEFloat(FILE *out, float val)
 {
 	static_assert(sizeof(float) == sizeof(uint32_t), "invalid float size");
@@ -29,6 +29,11 @@ string_view Dirname(string_view path);
 bool FileExistsAndIsWriteable(const char *path);
 bool GetFileSize(const char *path, std::uintmax_t *size);
 
+/**
+ * @brief Gets the time a file was last modified, in a platform dependent unit.
+ */
+bool GetFileModificationTime(const char *path, std::int64_t *time);
+
 /**
  * @brief Creates a single directory (non-recursively).
  *
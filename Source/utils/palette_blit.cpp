@@ -0,0 +1,301 @@
+#include "utils/palette_blit.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+#include <SDL_cpuinfo.h>
+
+#include "utils/sdl_bilinear_scale.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 4) && ((defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || defined(_M_X64))
+#define DVL_PALETTE_BLIT_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define DVL_PALETTE_BLIT_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DVL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DVL_TARGET_AVX2
+#endif
+
+namespace devilution {
+
+namespace {
+
+#ifdef DVL_PALETTE_BLIT_AVX2
+DVL_TARGET_AVX2 void ConvertPaletteRow32AVX2(const uint8_t *src, uint32_t *dst, unsigned count, const PaletteBlitTable &table)
+{
+	const auto *pixels = reinterpret_cast<const int *>(table.pixels);
+	for (; count >= 16; count -= 16, src += 16, dst += 16) {
+		const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+		const __m256i lo = _mm256_i32gather_epi32(pixels, _mm256_cvtepu8_epi32(indices), 4);
+		const __m256i hi = _mm256_i32gather_epi32(pixels, _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8)), 4);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), lo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 8), hi);
+	}
+	ConvertPaletteRow32Scalar(src, dst, count, table);
+}
+#endif
+
+#ifdef DVL_PALETTE_BLIT_NEON
+uint8x16_t LookupPlaneNEON(const uint8_t *plane, uint8x16_t indices)
+{
+	// `vqtbl4q_u8` covers 64 entries and yields 0 for larger indices.
+	// `vqtbx4q_u8` leaves the lanes with out-of-range indices untouched,
+	// so each subsequent quarter of the table only fills in its own lanes.
+	const uint8x16_t quarter = vdupq_n_u8(64);
+	uint8x16x4_t t = { { vld1q_u8(plane), vld1q_u8(plane + 16), vld1q_u8(plane + 32), vld1q_u8(plane + 48) } };
+	uint8x16_t result = vqtbl4q_u8(t, indices);
+	for (unsigned offset = 64; offset < 256; offset += 64) {
+		indices = vsubq_u8(indices, quarter);
+		t = { { vld1q_u8(plane + offset), vld1q_u8(plane + offset + 16), vld1q_u8(plane + offset + 32), vld1q_u8(plane + offset + 48) } };
+		result = vqtbx4q_u8(result, t, indices);
+	}
+	return result;
+}
+
+void ConvertPaletteRow32NEON(const uint8_t *src, uint32_t *dst, unsigned count, const PaletteBlitTable &table)
+{
+	for (; count >= 16; count -= 16, src += 16, dst += 16) {
+		const uint8x16_t indices = vld1q_u8(src);
+		uint8x16x4_t result;
+		result.val[0] = LookupPlaneNEON(table.planes[0], indices);
+		result.val[1] = LookupPlaneNEON(table.planes[1], indices);
+		result.val[2] = LookupPlaneNEON(table.planes[2], indices);
+		result.val[3] = LookupPlaneNEON(table.planes[3], indices);
+		vst4q_u8(reinterpret_cast<uint8_t *>(dst), result);
+	}
+	ConvertPaletteRow32Scalar(src, dst, count, table);
+}
+#endif
+
+ConvertPaletteRow32Fn SelectConvertPaletteRow32()
+{
+	// SSE2 has no gather or wide table lookup, so x86 without AVX2 uses the scalar loop.
+	for (const PaletteRowKernel kernel : { PaletteRowKernel::AVX2, PaletteRowKernel::NEON }) {
+		if (const ConvertPaletteRow32Fn convert = GetConvertPaletteRow32Kernel(kernel))
+			return convert;
+	}
+	return ConvertPaletteRow32Scalar;
+}
+
+/**
+ * @brief Clips a blit the same way `SDL_BlitSurface` does.
+ * @return Whether anything is left to draw.
+ */
+bool ClipBlit(const SDL_Surface &src, const SDL_Rect *srcRect, const SDL_Rect &clip, const SDL_Rect *dstRect, SDL_Rect &srcArea, int &dstX, int &dstY)
+{
+	srcArea = srcRect != nullptr ? *srcRect : SDL_Rect { 0, 0, static_cast<Uint16>(src.w), static_cast<Uint16>(src.h) };
+	int x = srcArea.x;
+	int y = srcArea.y;
+	int w = srcArea.w;
+	int h = srcArea.h;
+	dstX = dstRect != nullptr ? dstRect->x : 0;
+	dstY = dstRect != nullptr ? dstRect->y : 0;
+
+	if (x < 0) {
+		dstX -= x;
+		w += x;
+		x = 0;
+	}
+	if (y < 0) {
+		dstY -= y;
+		h += y;
+		y = 0;
+	}
+	w = std::min(w, src.w - x);
+	h = std::min(h, src.h - y);
+
+	if (dstX < clip.x) {
+		x += clip.x - dstX;
+		w -= clip.x - dstX;
+		dstX = clip.x;
+	}
+	if (dstY < clip.y) {
+		y += clip.y - dstY;
+		h -= clip.y - dstY;
+		dstY = clip.y;
+	}
+	w = std::min(w, clip.x + clip.w - dstX);
+	h = std::min(h, clip.y + clip.h - dstY);
+
+	if (w <= 0 || h <= 0)
+		return false;
+
+	srcArea.x = x;
+	srcArea.y = y;
+	srcArea.w = w;
+	srcArea.h = h;
+	return true;
+}
+
+/**
+ * @brief Locks `surface` for direct pixel access for the lifetime of the object, if required.
+ */
+class ScopedSurfaceLock {
+public:
+	explicit ScopedSurfaceLock(SDL_Surface &surface)
+	    : surface_(SDL_MUSTLOCK(&surface) ? &surface : nullptr)
+	{
+		if (surface_ != nullptr && SDL_LockSurface(surface_) < 0)
+			surface_ = nullptr;
+	}
+
+	ScopedSurfaceLock(const ScopedSurfaceLock &) = delete;
+	ScopedSurfaceLock &operator=(const ScopedSurfaceLock &) = delete;
+
+	~ScopedSurfaceLock()
+	{
+		if (surface_ != nullptr)
+			SDL_UnlockSurface(surface_);
+	}
+
+private:
+	SDL_Surface *surface_;
+};
+
+} // namespace
+
+void BuildPaletteBlitTable(const SDL_Palette &palette, const SDL_PixelFormat &format, PaletteBlitTable &table)
+{
+	for (unsigned i = 0; i < 256; ++i) {
+		uint32_t pixel = 0;
+		if (static_cast<int>(i) < palette.ncolors) {
+			const SDL_Color &color = palette.colors[i];
+			pixel = SDL_MapRGB(&format, color.r, color.g, color.b);
+		}
+		table.pixels[i] = pixel;
+
+		uint8_t bytes[4];
+		std::memcpy(bytes, &pixel, sizeof(bytes));
+		for (unsigned plane = 0; plane < 4; ++plane)
+			table.planes[plane][i] = bytes[plane];
+	}
+}
+
+bool CanBlitPaletteSurface32(const SDL_Surface &src, const SDL_Surface &dst)
+{
+	if (src.format->BitsPerPixel != 8 || src.format->palette == nullptr)
+		return false;
+	if (dst.format->BytesPerPixel != 4)
+		return false;
+#ifndef USE_SDL1
+	Uint32 colorKey;
+	if (SDL_GetColorKey(const_cast<SDL_Surface *>(&src), &colorKey) == 0)
+		return false;
+#else
+	if ((src.flags & SDL_SRCCOLORKEY) != 0)
+		return false;
+#endif
+	return true;
+}
+
+void ConvertPaletteRow32Scalar(const uint8_t *src, uint32_t *dst, unsigned count, const PaletteBlitTable &table)
+{
+	const uint32_t *pixels = table.pixels;
+	for (; count >= 4; count -= 4, src += 4, dst += 4) {
+		dst[0] = pixels[src[0]];
+		dst[1] = pixels[src[1]];
+		dst[2] = pixels[src[2]];
+		dst[3] = pixels[src[3]];
+	}
+	while (count-- != 0)
+		*dst++ = pixels[*src++];
+}
+
+ConvertPaletteRow32Fn GetConvertPaletteRow32Kernel(PaletteRowKernel kernel)
+{
+	switch (kernel) {
+	case PaletteRowKernel::Scalar:
+		return ConvertPaletteRow32Scalar;
+	case PaletteRowKernel::AVX2:
+#ifdef DVL_PALETTE_BLIT_AVX2
+		if (SDL_HasAVX2() == SDL_TRUE)
+			return ConvertPaletteRow32AVX2;
+#endif
+		return nullptr;
+	case PaletteRowKernel::NEON:
+#ifdef DVL_PALETTE_BLIT_NEON
+		// NEON is a mandatory part of AArch64.
+		return ConvertPaletteRow32NEON;
+#else
+		return nullptr;
+#endif
+	}
+	return nullptr;
+}
+
+void ConvertPaletteRow32(const uint8_t *src, uint32_t *dst, unsigned count, const PaletteBlitTable &table)
+{
+	static const ConvertPaletteRow32Fn Convert = SelectConvertPaletteRow32();
+	Convert(src, dst, count, table);
+}
+
+void BlitPaletteSurface32(const SDL_Surface &src, const SDL_Rect *srcRect, SDL_Surface &dst, const SDL_Rect *dstRect, const PaletteBlitTable &table)
+{
+	SDL_Rect srcArea;
+	int dstX;
+	int dstY;
+	if (!ClipBlit(src, srcRect, dst.clip_rect, dstRect, srcArea, dstX, dstY))
+		return;
+
+	ScopedSurfaceLock lock(dst);
+	const auto *srcPixels = static_cast<const uint8_t *>(src.pixels) + static_cast<ptrdiff_t>(srcArea.y) * src.pitch + srcArea.x;
+	auto *dstPixels = static_cast<uint8_t *>(dst.pixels) + static_cast<ptrdiff_t>(dstY) * dst.pitch + static_cast<ptrdiff_t>(dstX) * 4;
+	for (int y = 0; y < srcArea.h; ++y) {
+		ConvertPaletteRow32(srcPixels, reinterpret_cast<uint32_t *>(dstPixels), srcArea.w, table);
+		srcPixels += src.pitch;
+		dstPixels += dst.pitch;
+	}
+}
+
+void BlitPaletteSurfaceScaled32(const SDL_Surface &src, const SDL_Rect *srcRect, SDL_Surface &dst, const SDL_Rect *dstRect, unsigned factor, const PaletteBlitTable &table)
+{
+	if (factor <= 1) {
+		BlitPaletteSurface32(src, srcRect, dst, dstRect, table);
+		return;
+	}
+
+	const auto scale = static_cast<int>(factor);
+	const SDL_Rect clip {
+		static_cast<Sint16>((dst.clip_rect.x + scale - 1) / scale),
+		static_cast<Sint16>((dst.clip_rect.y + scale - 1) / scale),
+		static_cast<Uint16>(dst.clip_rect.w / scale),
+		static_cast<Uint16>(dst.clip_rect.h / scale),
+	};
+	SDL_Rect srcArea;
+	int dstX;
+	int dstY;
+	if (!ClipBlit(src, srcRect, clip, dstRect, srcArea, dstX, dstY))
+		return;
+
+	// Reused between frames to avoid an allocation per blit.
+	static std::unique_ptr<uint32_t[]> row;
+	static int rowCapacity = 0;
+	if (rowCapacity < srcArea.w) {
+		row.reset(new uint32_t[srcArea.w]);
+		rowCapacity = srcArea.w;
+	}
+
+	ScopedSurfaceLock lock(dst);
+	const size_t scaledRowBytes = static_cast<size_t>(srcArea.w) * scale * 4;
+	const auto *srcPixels = static_cast<const uint8_t *>(src.pixels) + static_cast<ptrdiff_t>(srcArea.y) * src.pitch + srcArea.x;
+	auto *dstPixels = static_cast<uint8_t *>(dst.pixels) + static_cast<ptrdiff_t>(dstY) * scale * dst.pitch + static_cast<ptrdiff_t>(dstX) * scale * 4;
+	for (int y = 0; y < srcArea.h; ++y) {
+		ConvertPaletteRow32(srcPixels, row.get(), srcArea.w, table);
+		IntegerScaleRow32(row.get(), reinterpret_cast<uint32_t *>(dstPixels), srcArea.w, factor);
+		for (int i = 1; i < scale; ++i)
+			std::memcpy(dstPixels + static_cast<ptrdiff_t>(i) * dst.pitch, dstPixels, scaledRowBytes);
+		srcPixels += src.pitch;
+		dstPixels += static_cast<ptrdiff_t>(dst.pitch) * scale;
+	}
+}
+
+} // namespace devilution
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+#include <SDL_version.h>
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+#include <SDL_pixels.h>
+#include <SDL_surface.h>
+#else
+#include <SDL_video.h>
+#endif
+
+namespace devilution {
+
+/**
+ * @brief Maps 8-bit palette indices to pixels of a 32-bit output format.
+ */
+struct PaletteBlitTable {
+	/** @brief Output pixel for each palette index. */
+	uint32_t pixels[256];
+
+	/** @brief `pixels` split into byte planes (in memory order), used by the NEON kernel. */
+	uint8_t planes[4][256];
+};
+
+/**
+ * @brief Fills `table` with the colors of `palette` mapped to `format`.
+ */
+void BuildPaletteBlitTable(const SDL_Palette &palette, const SDL_PixelFormat &format, PaletteBlitTable &table);
+
+/**
+ * @brief Whether `BlitPaletteSurface32` supports converting from `src` to `dst`.
+ *
+ * `src` must be an 8-bit paletted surface without a color key and `dst` must be a 32-bit surface.
+ */
+bool CanBlitPaletteSurface32(const SDL_Surface &src, const SDL_Surface &dst);
+
+using ConvertPaletteRow32Fn = void (*)(const uint8_t *src, uint32_t *dst, unsigned count, const PaletteBlitTable &table);
+
+enum class PaletteRowKernel : uint8_t {
+	Scalar,
+	AVX2,
+	NEON,
+};
+
+/**
+ * @brief Converts `count` palette indices to 32-bit pixels.
+ *
+ * Uses the fastest kernel supported by the CPU (AVX2, NEON or scalar), picked on the first call.
+ */
+void ConvertPaletteRow32(const uint8_t *src, uint32_t *dst, unsigned count, const PaletteBlitTable &table);
+
+/**
+ * @brief Portable reference implementation of `ConvertPaletteRow32`.
+ */
+void ConvertPaletteRow32Scalar(const uint8_t *src, uint32_t *dst, unsigned count, const PaletteBlitTable &table);
+
+/**
+ * @brief Returns the implementation of `ConvertPaletteRow32` that uses `kernel`, for tests and benchmarks.
+ * @return `nullptr` if this build or CPU doesn't support the kernel
+ */
+ConvertPaletteRow32Fn GetConvertPaletteRow32Kernel(PaletteRowKernel kernel);
+
+/**
+ * @brief Converting blit from an 8-bit paletted surface to a 32-bit surface.
+ *
+ * Clips the same way as `SDL_BlitSurface`: `srcRect` and `dstRect` may be `nullptr`,
+ * only the position of `dstRect` is used.
+ */
+void BlitPaletteSurface32(const SDL_Surface &src, const SDL_Rect *srcRect, SDL_Surface &dst, const SDL_Rect *dstRect, const PaletteBlitTable &table);
+
+/**
+ * @brief Same as `BlitPaletteSurface32` but also scales the image up by a whole number factor.
+ *
+ * `dstRect` is in unscaled coordinates.
+ */
+void BlitPaletteSurfaceScaled32(const SDL_Surface &src, const SDL_Rect *srcRect, SDL_Surface &dst, const SDL_Rect *dstRect, unsigned factor, const PaletteBlitTable &table);
+
+} // namespace devilution
@@ -0,0 +1,111 @@
+#include "utils/pcm_aulib_decoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <Aulib/DecoderDrmp3.h>
+#include <Aulib/DecoderDrwav.h>
+#include <SDL.h>
+
+#include "appfat.h"
+#include "utils/stdcompat/algorithm.hpp"
+
+namespace devilution {
+
+namespace {
+
+std::unique_ptr<Aulib::Decoder> CreateDecoder(bool isMp3)
+{
+	if (isMp3)
+		return std::make_unique<Aulib::DecoderDrmp3>();
+	return std::make_unique<Aulib::DecoderDrwav>();
+}
+
+std::int16_t FloatToSample(float sample)
+{
+	constexpr float Scale = std::numeric_limits<std::int16_t>::max() + 1.F;
+	const float scaled = std::round(sample * Scale);
+	return static_cast<std::int16_t>(clamp(scaled, static_cast<float>(std::numeric_limits<std::int16_t>::min()), static_cast<float>(std::numeric_limits<std::int16_t>::max())));
+}
+
+} // namespace
+
+std::shared_ptr<const PcmSamples> DecodePcmSamples(const std::uint8_t *fileData, std::size_t size, bool isMp3)
+{
+	SDL_RWops *rwops = SDL_RWFromConstMem(fileData, static_cast<int>(size));
+	if (rwops == nullptr)
+		return nullptr;
+
+	std::unique_ptr<Aulib::Decoder> decoder = CreateDecoder(isMp3);
+	if (!decoder->open(rwops)) {
+		SDL_RWclose(rwops);
+		return nullptr;
+	}
+
+	std::vector<std::int16_t> samples;
+	constexpr int BufferLength = 4096;
+	float buf[BufferLength];
+	while (true) {
+		bool callAgain = false;
+		const int decoded = decoder->decode(buf, BufferLength, callAgain);
+		if (decoded <= 0 && !callAgain)
+			break;
+		for (int i = 0; i < decoded; ++i)
+			samples.push_back(FloatToSample(buf[i]));
+	}
+
+	auto result = std::make_shared<PcmSamples>();
+	result->channels = decoder->getChannels();
+	result->rate = decoder->getRate();
+	decoder = nullptr;
+	SDL_RWclose(rwops);
+
+	result->size = samples.size();
+	result->data.reset(new std::int16_t[samples.size()]);
+	std::memcpy(result->data.get(), samples.data(), samples.size() * sizeof(samples[0]));
+	return result;
+}
+
+bool PcmAulibDecoder::open([[maybe_unused]] SDL_RWops *rwops)
+{
+	assert(rwops == nullptr);
+	return true;
+}
+
+bool PcmAulibDecoder::rewind()
+{
+	pos_ = 0;
+	return true;
+}
+
+std::chrono::microseconds PcmAulibDecoder::duration() const
+{
+	const auto frames = static_cast<std::int64_t>(samples_->size / samples_->channels);
+	return std::chrono::microseconds { frames * 1000000 / samples_->rate };
+}
+
+bool PcmAulibDecoder::seekToTime(std::chrono::microseconds pos)
+{
+	const auto frame = static_cast<std::size_t>(pos.count() * samples_->rate / 1000000);
+	pos_ = std::min(frame * samples_->channels, samples_->size);
+	return true;
+}
+
+int PcmAulibDecoder::doDecoding(float buf[], int len, bool &callAgain)
+{
+	callAgain = false;
+
+	constexpr float Scale = std::numeric_limits<std::int16_t>::max() + 1.F;
+	const std::size_t count = std::min(static_cast<std::size_t>(len), samples_->size - pos_);
+	const std::int16_t *samples = &samples_->data[pos_];
+	for (std::size_t i = 0; i < count; ++i) {
+		buf[i] = static_cast<float>(samples[i]) / Scale;
+	}
+	pos_ += count;
+	return static_cast<int>(count);
+}
+
+} // namespace devilution
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <Aulib/Decoder.h>
+
+namespace devilution {
+
+/**
+ * @brief A sound decoded in full, shared by all the streams that play it.
+ */
+struct PcmSamples {
+	/** @brief Interleaved samples of all channels. */
+	std::unique_ptr<std::int16_t[]> data;
+	/** @brief Number of samples in `data`, over all channels. */
+	std::size_t size;
+	int channels;
+	int rate;
+};
+
+/**
+ * @brief Decodes an entire WAV or MP3 file.
+ * @return nullptr on failure
+ */
+std::shared_ptr<const PcmSamples> DecodePcmSamples(const std::uint8_t *fileData, std::size_t size, bool isMp3);
+
+/**
+ * @brief A Decoder interface implementation that plays samples that have been decoded already.
+ */
+class PcmAulibDecoder final : public ::Aulib::Decoder {
+public:
+	explicit PcmAulibDecoder(std::shared_ptr<const PcmSamples> samples)
+	    : samples_(std::move(samples))
+	{
+	}
+
+	[[nodiscard]] const std::shared_ptr<const PcmSamples> &GetSamples() const
+	{
+		return samples_;
+	}
+
+	/**
+	 * @brief Plays different samples from the start, only valid while the stream is stopped.
+	 *
+	 * The samples must have the same number of channels and rate as the ones the stream was opened with.
+	 */
+	void SetSamples(std::shared_ptr<const PcmSamples> samples)
+	{
+		samples_ = std::move(samples);
+		pos_ = 0;
+	}
+
+	bool open(SDL_RWops *rwops) override;
+
+	[[nodiscard]] int getChannels() const override
+	{
+		return samples_->channels;
+	}
+
+	[[nodiscard]] int getRate() const override
+	{
+		return samples_->rate;
+	}
+
+	bool rewind() override;
+	[[nodiscard]] std::chrono::microseconds duration() const override;
+	bool seekToTime(std::chrono::microseconds pos) override;
+
+protected:
+	int doDecoding(float buf[], int len, bool &callAgain) override;
+
+private:
+	std::shared_ptr<const PcmSamples> samples_;
+	std::size_t pos_ = 0;
+};
+
+} // namespace devilution
@@ -0,0 +1,181 @@
+/**
+ * @file profiler.cpp
+ *
+ * Implementation of the scoped-zone frame profiler.
+ */
+#ifdef DEVILUTIONX_PROFILER
+
+#include "utils/profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include <SDL.h>
+#include <fmt/format.h>
+
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+bool ProfilerRecording;
+
+namespace {
+
+struct ProfileEvent {
+	const char *name;
+	ProfilerClock::time_point start;
+	ProfilerClock::time_point end;
+	uint16_t depth;
+};
+
+/** Bounds the memory used by a capture, later events are dropped. */
+constexpr size_t MaxCaptureEvents = 1 << 20;
+
+SDL_threadID MainThreadId;
+/** The zones of the current frame, in the order they were entered. */
+std::vector<ProfileEvent> FrameEvents;
+uint16_t Depth;
+ProfilerClock::time_point FrameStart;
+ProfilerClock::duration LastFrameDuration;
+
+bool OverlayEnabled;
+std::vector<ProfilerOverlayLine> OverlayLines;
+
+unsigned CaptureFramesLeft;
+std::vector<ProfileEvent> CaptureEvents;
+ProfilerClock::time_point CaptureStart;
+std::string CapturePath;
+
+void UpdateRecording()
+{
+	ProfilerRecording = OverlayEnabled || CaptureFramesLeft != 0;
+	if (ProfilerRecording)
+		MainThreadId = SDL_ThreadID();
+}
+
+void UpdateOverlayLines()
+{
+	OverlayLines.clear();
+	for (const ProfileEvent &event : FrameEvents) {
+		if (event.depth != 0)
+			continue;
+		auto it = std::find_if(OverlayLines.begin(), OverlayLines.end(), [&event](const ProfilerOverlayLine &line) {
+			return std::strcmp(line.name, event.name) == 0;
+		});
+		if (it == OverlayLines.end()) {
+			OverlayLines.push_back({ event.name, {}, 0 });
+			it = OverlayLines.end() - 1;
+		}
+		it->duration += event.end - event.start;
+		it->count++;
+	}
+}
+
+void WriteCapture()
+{
+	using Microseconds = std::chrono::duration<double, std::micro>;
+
+	std::string json = "{\"traceEvents\":[";
+	const char *separator = "\n";
+	for (const ProfileEvent &event : CaptureEvents) {
+		fmt::format_to(std::back_inserter(json), R"({}{{"name":"{}","cat":"devilutionx","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":1}})",
+		    separator, event.name, Microseconds(event.start - CaptureStart).count(), Microseconds(event.end - event.start).count());
+		separator = ",\n";
+	}
+	json += "\n]}\n";
+
+	FILE *file = OpenFile(CapturePath.c_str(), "wb");
+	if (file == nullptr) {
+		LogError("Failed to write the profile to {}", CapturePath);
+		return;
+	}
+	std::fwrite(json.data(), json.size(), 1, file);
+	std::fclose(file);
+	LogInfo("Wrote the profile of {} zones to {}", CaptureEvents.size(), CapturePath);
+}
+
+} // namespace
+
+int BeginProfileZoneSlow(const char *name)
+{
+	if (SDL_ThreadID() != MainThreadId)
+		return -1;
+	FrameEvents.push_back({ name, ProfilerClock::now(), {}, Depth });
+	Depth++;
+	return static_cast<int>(FrameEvents.size() - 1);
+}
+
+void EndProfileZoneSlow(int index)
+{
+	if (static_cast<size_t>(index) >= FrameEvents.size())
+		return;
+	FrameEvents[index].end = ProfilerClock::now();
+	Depth--;
+}
+
+void ProfilerNextFrame()
+{
+	const ProfilerClock::time_point now = ProfilerClock::now();
+	LastFrameDuration = now - FrameStart;
+	FrameStart = now;
+
+	// Zones that are still open keep their indices, the frame is then recorded together with the next one.
+	if (Depth != 0)
+		return;
+
+	if (OverlayEnabled)
+		UpdateOverlayLines();
+
+	if (CaptureFramesLeft != 0) {
+		const size_t count = std::min(FrameEvents.size(), MaxCaptureEvents - CaptureEvents.size());
+		CaptureEvents.insert(CaptureEvents.end(), FrameEvents.begin(), FrameEvents.begin() + count);
+		if (--CaptureFramesLeft == 0) {
+			WriteCapture();
+			CaptureEvents = {};
+			UpdateRecording();
+		}
+	}
+
+	FrameEvents.clear();
+}
+
+void SetProfilerOverlay(bool enabled)
+{
+	OverlayEnabled = enabled;
+	OverlayLines.clear();
+	UpdateRecording();
+}
+
+bool IsProfilerOverlayEnabled()
+{
+	return OverlayEnabled;
+}
+
+const std::vector<ProfilerOverlayLine> &GetProfilerOverlayLines()
+{
+	return OverlayLines;
+}
+
+ProfilerClock::duration GetProfilerFrameDuration()
+{
+	return LastFrameDuration;
+}
+
+std::string StartProfilerCapture(unsigned frames)
+{
+	CapturePath = StrCat(paths::PrefPath(), "profile-", SDL_GetTicks(), ".json");
+	CaptureFramesLeft = std::max(frames, 1U);
+	CaptureEvents.clear();
+	CaptureStart = ProfilerClock::now();
+	UpdateRecording();
+	return CapturePath;
+}
+
+} // namespace devilution
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file profiler.hpp
+ *
+ * Scoped-zone frame profiler, built with the DEVILUTIONX_PROFILER option.
+ *
+ * Zones are only recorded on the main thread and only while the overlay is shown or a capture is running,
+ * without DEVILUTIONX_PROFILER the `DVL_PROFILE_*` macros expand to nothing.
+ */
+#pragma once
+
+#ifdef DEVILUTIONX_PROFILER
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#endif
+
+namespace devilution {
+
+#ifdef DEVILUTIONX_PROFILER
+
+using ProfilerClock = std::chrono::steady_clock;
+
+/** @brief Whether zones are being recorded, checked inline so that idle zones only cost a branch. */
+extern bool ProfilerRecording;
+
+int BeginProfileZoneSlow(const char *name);
+void EndProfileZoneSlow(int index);
+
+/**
+ * @brief Starts a zone and returns its index, -1 if it isn't recorded.
+ */
+inline int BeginProfileZone(const char *name)
+{
+	if (!ProfilerRecording)
+		return -1;
+	return BeginProfileZoneSlow(name);
+}
+
+inline void EndProfileZone(int index)
+{
+	if (index >= 0)
+		EndProfileZoneSlow(index);
+}
+
+/**
+ * @brief Times the scope it is declared in, see `DVL_PROFILE_ZONE`.
+ */
+class ProfileZone {
+public:
+	explicit ProfileZone(const char *name)
+	    : index_(BeginProfileZone(name))
+	{
+	}
+
+	~ProfileZone()
+	{
+		EndProfileZone(index_);
+	}
+
+	ProfileZone(const ProfileZone &) = delete;
+	ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+	int index_;
+};
+
+/**
+ * @brief Times consecutive steps of a long function, each step lasts until the next one or the end of the scope.
+ */
+class ProfileSteps {
+public:
+	ProfileSteps() = default;
+
+	~ProfileSteps()
+	{
+		EndProfileZone(index_);
+	}
+
+	ProfileSteps(const ProfileSteps &) = delete;
+	ProfileSteps &operator=(const ProfileSteps &) = delete;
+
+	void next(const char *name)
+	{
+		EndProfileZone(index_);
+		index_ = BeginProfileZone(name);
+	}
+
+private:
+	int index_ = -1;
+};
+
+/**
+ * @brief Time spent in a top-level zone during the previous frame, for the overlay.
+ */
+struct ProfilerOverlayLine {
+	const char *name;
+	/** Summed over all the zones with this name. */
+	ProfilerClock::duration duration;
+	unsigned count;
+};
+
+/**
+ * @brief Ends the frame's recording, call once at the start of each game loop iteration.
+ */
+void ProfilerNextFrame();
+
+void SetProfilerOverlay(bool enabled);
+bool IsProfilerOverlayEnabled();
+
+/**
+ * @brief The top-level zones of the previous frame, in the order they were first entered.
+ */
+const std::vector<ProfilerOverlayLine> &GetProfilerOverlayLines();
+
+/**
+ * @brief Duration of the previous frame, from one `ProfilerNextFrame` to the next.
+ */
+ProfilerClock::duration GetProfilerFrameDuration();
+
+/**
+ * @brief Records the next `frames` frames and writes them as a Chrome trace (chrome://tracing, Perfetto).
+ * @return The path of the trace file, it is written once the frames have been recorded
+ */
+std::string StartProfilerCapture(unsigned frames);
+
+#define DVL_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DVL_PROFILE_CONCAT(a, b) DVL_PROFILE_CONCAT_IMPL(a, b)
+/** @brief Times the rest of the enclosing scope as a zone called `name` (a string literal). */
+#define DVL_PROFILE_ZONE(name) const ::devilution::ProfileZone DVL_PROFILE_CONCAT(profileZone, __LINE__) { name }
+/** @brief Declares `steps` for timing the consecutive steps of a function with `DVL_PROFILE_STEP`. */
+#define DVL_PROFILE_STEPS(steps) ::devilution::ProfileSteps steps
+/** @brief Ends the previous step of `steps` and starts one called `name` (a string literal). */
+#define DVL_PROFILE_STEP(steps, name) steps.next(name)
+
+#else
+
+#define DVL_PROFILE_ZONE(name) (void)0
+#define DVL_PROFILE_STEPS(steps) (void)0
+#define DVL_PROFILE_STEP(steps, name) (void)0
+
+#endif
+
+} // namespace devilution
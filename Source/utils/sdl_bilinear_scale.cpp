@@ -1,8 +1,17 @@
 #include "utils/sdl_bilinear_scale.hpp"
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DVL_INTEGER_SCALE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DVL_INTEGER_SCALE_NEON
+#include <arm_neon.h>
+#endif
+
 // Performs bilinear scaling using fixed-width integer math.
 
 namespace devilution {
@@ -62,6 +71,52 @@ uint8_t MixColorsWithAlpha(uint8_t first, uint8_t firstAlpha,
 	return ToInt((secondWithAlpha - firstWithAlpha) * ((ratio + (mixedAlpha - 1)) / mixedAlpha)) + (firstWithAlpha + (mixedAlpha - 1)) / mixedAlpha;
 }
 
+#if defined(DVL_INTEGER_SCALE_SSE2)
+void ScaleRowBy2(const uint32_t *src, uint32_t *dst, unsigned width)
+{
+	for (; width >= 4; width -= 4, src += 4, dst += 8) {
+		const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi32(pixels, pixels));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 4), _mm_unpackhi_epi32(pixels, pixels));
+	}
+	for (; width != 0; --width, ++src, dst += 2)
+		dst[0] = dst[1] = *src;
+}
+
+void ScaleRowBy4(const uint32_t *src, uint32_t *dst, unsigned width)
+{
+	for (; width >= 4; width -= 4, src += 4, dst += 16) {
+		const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi32(pixels, 0x00));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 4), _mm_shuffle_epi32(pixels, 0x55));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 8), _mm_shuffle_epi32(pixels, 0xAA));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 12), _mm_shuffle_epi32(pixels, 0xFF));
+	}
+	for (; width != 0; --width, ++src, dst += 4)
+		dst[0] = dst[1] = dst[2] = dst[3] = *src;
+}
+#elif defined(DVL_INTEGER_SCALE_NEON)
+void ScaleRowBy2(const uint32_t *src, uint32_t *dst, unsigned width)
+{
+	for (; width >= 4; width -= 4, src += 4, dst += 8) {
+		const uint32x4_t pixels = vld1q_u32(src);
+		vst2q_u32(dst, uint32x4x2_t { { pixels, pixels } });
+	}
+	for (; width != 0; --width, ++src, dst += 2)
+		dst[0] = dst[1] = *src;
+}
+
+void ScaleRowBy4(const uint32_t *src, uint32_t *dst, unsigned width)
+{
+	for (; width >= 4; width -= 4, src += 4, dst += 16) {
+		const uint32x4_t pixels = vld1q_u32(src);
+		vst4q_u32(dst, uint32x4x4_t { { pixels, pixels, pixels, pixels } });
+	}
+	for (; width != 0; --width, ++src, dst += 4)
+		dst[0] = dst[1] = dst[2] = dst[3] = *src;
+}
+#endif
+
 } // namespace
 
 void BilinearScale32(SDL_Surface *src, SDL_Surface *dst)
@@ -185,4 +240,23 @@ void BilinearDownscaleByHalf8(const SDL_Surface *src, const uint8_t (*paletteBle
 	}
 }
 
+void IntegerScaleRow32(const uint32_t *src, uint32_t *dst, unsigned width, unsigned factor)
+{
+#if defined(DVL_INTEGER_SCALE_SSE2) || defined(DVL_INTEGER_SCALE_NEON)
+	if (factor == 2) {
+		ScaleRowBy2(src, dst, width);
+		return;
+	}
+	if (factor == 4) {
+		ScaleRowBy4(src, dst, width);
+		return;
+	}
+#endif
+	for (unsigned x = 0; x < width; ++x) {
+		const uint32_t pixel = src[x];
+		for (unsigned i = 0; i < factor; ++i)
+			*dst++ = pixel;
+	}
+}
+
 } // namespace devilution
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <SDL_version.h>
 
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -22,4 +24,10 @@ void BilinearScale32(SDL_Surface *src, SDL_Surface *dst);
  */
 void BilinearDownscaleByHalf8(const SDL_Surface *src, const uint8_t (*paletteBlendingTable)[256], SDL_Surface *dst, uint8_t transparentIndex);
 
+/**
+ * @brief Nearest-neighbour scaling of a single row of 32-bit pixels by a whole number factor.
+ * `dst` must have room for `width * factor` pixels.
+ */
+void IntegerScaleRow32(const uint32_t *src, uint32_t *dst, unsigned width, unsigned factor);
+
 } // namespace devilution
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <SDL_mutex.h>
+
+#include "appfat.h"
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+/*
+ * RAII wrapper for SDL_cond, the counterpart of SdlMutex.
+ */
+class SdlCond final {
+public:
+	SdlCond()
+	    : cond_(SDL_CreateCond())
+	{
+		if (cond_ == nullptr)
+			ErrSdl();
+	}
+
+	~SdlCond()
+	{
+		SDL_DestroyCond(cond_);
+	}
+
+	SdlCond(const SdlCond &) = delete;
+	SdlCond(SdlCond &&) = delete;
+	SdlCond &operator=(const SdlCond &) = delete;
+	SdlCond &operator=(SdlCond &&) = delete;
+
+	/** @brief Wakes up one thread waiting on this condition. */
+	void signal() noexcept // NOLINT(readability-identifier-naming)
+	{
+		int err = SDL_CondSignal(cond_);
+		if (err == -1)
+			ErrSdl();
+	}
+
+	/** @brief Waits for a signal, `mutex` must be locked and is locked again on return. */
+	void wait(SdlMutex &mutex) noexcept // NOLINT(readability-identifier-naming)
+	{
+		int err = SDL_CondWait(cond_, mutex.get());
+		if (err == -1)
+			ErrSdl();
+	}
+
+private:
+	SDL_cond *cond_;
+};
+
+} // namespace devilution
@@ -49,6 +49,15 @@ struct SDLTextureDeleter {
 using SDLTextureUniquePtr = std::unique_ptr<SDL_Texture, SDLTextureDeleter>;
 #endif
 
+struct SDLRWopsDeleter {
+	void operator()(SDL_RWops *rwops) const
+	{
+		SDL_RWclose(rwops);
+	}
+};
+
+using SDLRWopsUniquePtr = std::unique_ptr<SDL_RWops, SDLRWopsDeleter>;
+
 struct SDLPaletteDeleter {
 	void operator()(SDL_Palette *palette) const
 	{
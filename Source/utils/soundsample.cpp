@@ -93,8 +93,8 @@ float VolumeLogToLinear(int logVolume, int logMin, int logMax)
 void SoundSample::Release()
 {
 	stream_ = nullptr;
-	file_data_ = nullptr;
-	file_data_size_ = 0;
+	pcm_ = nullptr;
+	pcm_decoder_ = nullptr;
 }
 
 /**
@@ -124,6 +124,8 @@ int SoundSample::SetChunkStream(std::string filePath, bool isMp3, bool logErrors
 	}
 	file_path_ = std::move(filePath);
 	isMp3_ = isMp3;
+	pcm_ = nullptr;
+	pcm_decoder_ = nullptr;
 	stream_ = CreateStream(handle, isMp3);
 	if (!stream_->open()) {
 		stream_ = nullptr;
@@ -134,21 +136,38 @@ int SoundSample::SetChunkStream(std::string filePath, bool isMp3, bool logErrors
 	return 0;
 }
 
-int SoundSample::SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwBytes, bool isMp3)
+int SoundSample::SetChunk(const std::uint8_t *fileData, std::size_t dwBytes, bool isMp3)
 {
 	isMp3_ = isMp3;
-	file_data_ = std::move(fileData);
-	file_data_size_ = dwBytes;
-	SDL_RWops *buf = SDL_RWFromConstMem(file_data_.get(), dwBytes);
-	if (buf == nullptr) {
+	std::shared_ptr<const PcmSamples> samples = DecodePcmSamples(fileData, dwBytes, isMp3);
+	if (samples == nullptr) {
+		LogError(LogCategory::Audio, "Decoding failed (from SoundSample::SetChunk): {}", SDL_GetError());
 		return -1;
 	}
+	return SetPcm(std::move(samples));
+}
+
+int SoundSample::SetPcm(std::shared_ptr<const PcmSamples> samples)
+{
+	if (pcm_decoder_ != nullptr && !stream_->isPlaying()) {
+		const PcmSamples &current = *pcm_decoder_->GetSamples();
+		if (current.rate == samples->rate && current.channels == samples->channels) {
+			pcm_ = samples;
+			pcm_decoder_->SetSamples(std::move(samples));
+			return 0;
+		}
+	}
 
-	stream_ = CreateStream(buf, isMp3_);
+	pcm_ = samples;
+	const int rate = samples->rate;
+	auto decoder = std::make_unique<PcmAulibDecoder>(std::move(samples));
+	pcm_decoder_ = decoder.get();
+	stream_ = std::make_unique<Aulib::Stream>(/*rwops=*/nullptr, std::move(decoder), CreateAulibResampler(rate), /*closeRw=*/false);
 	if (!stream_->open()) {
 		stream_ = nullptr;
-		file_data_ = nullptr;
-		LogError(LogCategory::Audio, "Aulib::Stream::open (from SoundSample::SetChunk): {}", SDL_GetError());
+		pcm_ = nullptr;
+		pcm_decoder_ = nullptr;
+		LogError(LogCategory::Audio, "Aulib::Stream::open (from SoundSample::SetPcm): {}", SDL_GetError());
 		return -1;
 	}
 
@@ -7,7 +7,7 @@
 #include <Aulib/Stream.h>
 
 #include "engine/sound_defs.hpp"
-#include "utils/stdcompat/shared_ptr_array.hpp"
+#include "utils/pcm_aulib_decoder.h"
 
 namespace devilution {
 
@@ -34,24 +34,46 @@ public:
 	}
 
 	/**
-	 * @brief Sets the sample's WAV, FLAC, or Ogg/Vorbis data.
+	 * @brief Sets the sample's WAV or MP3 data, it is decoded right away and the data is not kept.
 	 * @param fileData Buffer containing the data
 	 * @param dwBytes Length of buffer
 	 * @param isMp3 Whether the data is an MP3
 	 * @return 0 on success, -1 otherwise
 	 */
-	int SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwBytes, bool isMp3);
+	int SetChunk(const std::uint8_t *fileData, std::size_t dwBytes, bool isMp3);
+
+	/**
+	 * @brief Sets the sample's decoded data, which may be shared with other samples.
+	 *
+	 * If the sample is stopped and its stream plays the same rate and number of channels,
+	 * the stream is reused without allocating.
+	 * @return 0 on success, -1 otherwise
+	 */
+	int SetPcm(std::shared_ptr<const PcmSamples> samples);
+
+	[[nodiscard]] const std::shared_ptr<const PcmSamples> &GetPcm() const
+	{
+		return pcm_;
+	}
+
+	/**
+	 * @brief Bytes of decoded samples held by the sample, 0 for streamed audio.
+	 */
+	[[nodiscard]] std::size_t GetMemorySize() const
+	{
+		return pcm_ != nullptr ? pcm_->size * sizeof(std::int16_t) : 0;
+	}
 
 	[[nodiscard]] bool IsStreaming() const
 	{
-		return file_data_ == nullptr;
+		return pcm_ == nullptr;
 	}
 
 	int DuplicateFrom(const SoundSample &other)
 	{
 		if (other.IsStreaming())
 			return SetChunkStream(other.file_path_, other.isMp3_);
-		return SetChunk(other.file_data_, other.file_data_size_, other.isMp3_);
+		return SetPcm(other.pcm_);
 	}
 
 	/**
@@ -97,8 +119,8 @@ public:
 
 private:
 	// Non-streaming audio fields:
-	ArraySharedPtr<std::uint8_t> file_data_;
-	std::size_t file_data_size_;
+	std::shared_ptr<const PcmSamples> pcm_;
+	PcmAulibDecoder *pcm_decoder_ = nullptr;
 
 	// Set for streaming audio to allow for duplicating it:
 	std::string file_path_;
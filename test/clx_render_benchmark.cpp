@@ -0,0 +1,203 @@
+/**
+ * @file clx_render_benchmark.cpp
+ *
+ * Times drawing real monster sprites with the scalar and the vector blit kernels, and checks that both
+ * kernel sets draw the same pixels.
+ *
+ * Usage: clx_render_benchmark [--passes 20] [--assets path]
+ *
+ * Needs spawn.mpq or diabdat.mpq. Each sprite is drawn plainly, with the monster's TRN and blended with it,
+ * using the cathedral palette's blending table.
+ */
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "engine/assets.hpp"
+#include "engine/load_cl2.hpp"
+#include "engine/load_file.hpp"
+#include "engine/palette.h"
+#include "engine/render/blit_simd.hpp"
+#include "engine/render/clx_render.hpp"
+#include "engine/surface.hpp"
+#include "init.h"
+#include "levels/gendung.h"
+#include "monstdat.h"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+using namespace devilution;
+
+namespace {
+
+/** @brief The monsters of the first levels, available in spawn.mpq, and a large one from the full game. */
+constexpr _monster_id Monsters[] = { MT_NZOMBIE, MT_RFALLSP, MT_WSKELAX, MT_FAT };
+
+/** @brief Letters of the monster graphics: stand, walk, attack, hit, death and special. */
+constexpr char GraphicLetters[] = "nwahds";
+
+struct BenchmarkOptions {
+	int passes = 20;
+};
+
+struct MonsterSprites {
+	std::string name;
+	std::vector<OwnedClxSpriteSheet> sheets;
+	std::array<uint8_t, 256> trn;
+};
+
+/**
+ * @brief Loads every graphic of the monster and its TRN, the identity table if it has none.
+ */
+MonsterSprites LoadMonsterSprites(_monster_id monsterId)
+{
+	const MonsterData &monsterData = MonstersData[monsterId];
+	MonsterSprites sprites;
+	sprites.name = monsterData.assetsSuffix;
+	for (const char *letter = GraphicLetters; *letter != '\0'; ++letter) {
+		const std::string path = StrCat("monsters\\", monsterData.assetsSuffix, string_view(letter, 1), DEVILUTIONX_CL2_EXT);
+		if (FindAsset(path.c_str()).ok())
+			sprites.sheets.push_back(LoadCl2Sheet(path.c_str(), monsterData.width));
+	}
+	for (unsigned i = 0; i < sprites.trn.size(); ++i)
+		sprites.trn[i] = static_cast<uint8_t>(i);
+	if (monsterData.trnFile != nullptr) {
+		LoadFileInMem(StrCat("monsters\\", monsterData.trnFile, ".trn").c_str(), sprites.trn);
+		// Like `GetMonsterTrn`, index 255 of a monster TRN is transparent.
+		std::replace(sprites.trn.begin(), sprites.trn.end(), 255, 0);
+	}
+	return sprites;
+}
+
+using DrawFn = void (*)(const Surface &out, Point position, ClxSprite clx, const uint8_t *trn);
+
+/**
+ * @brief Draws every frame of the monster `passes` times, sliding along the surface.
+ * @return Nanoseconds per drawn pixel
+ */
+double TimeDraw(DrawFn draw, const MonsterSprites &sprites, const Surface &out, int passes)
+{
+	uint64_t pixels = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (int pass = 0; pass < passes; ++pass) {
+		for (const OwnedClxSpriteSheet &sheet : sprites.sheets) {
+			for (const ClxSpriteList list : sheet) {
+				for (const ClxSprite sprite : list) {
+					draw(out, Point { 40 + pass * 8 % 320, 300 }, sprite, sprites.trn.data());
+					pixels += sprite.width() * sprite.height();
+				}
+			}
+		}
+	}
+	const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / std::max<uint64_t>(pixels, 1);
+}
+
+bool SurfacesEqual(const Surface &a, const Surface &b)
+{
+	for (int y = 0; y < a.h(); ++y) {
+		if (std::memcmp(a.at(0, y), b.at(0, y), a.w()) != 0)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Times one way of drawing with the scalar kernels and with the best vector kernels for this CPU.
+ * @return Whether both kernel sets drew the same pixels
+ */
+bool BenchmarkDraw(const char *name, DrawFn draw, const MonsterSprites &sprites, BlitRunKernelSet vectorSet, const BenchmarkOptions &options)
+{
+	OwnedSurface expected { 640, 480 };
+	OwnedSurface actual { 640, 480 };
+	for (int y = 0; y < expected.h(); ++y) {
+		for (int x = 0; x < expected.w(); ++x)
+			*expected.at(x, y) = *actual.at(x, y) = static_cast<uint8_t>(x * 3 + y * 5);
+	}
+
+	UseBlitRunKernelSet(BlitRunKernelSet::Scalar);
+	const double scalar = TimeDraw(draw, sprites, expected, options.passes);
+	UseBlitRunKernelSet(vectorSet);
+	const double vector = TimeDraw(draw, sprites, actual, options.passes);
+
+	const bool same = SurfacesEqual(expected, actual);
+	std::printf("%-18s %-18s scalar %6.3f ns/pixel, vector %6.3f ns/pixel%s\n", sprites.name.c_str(), name,
+	    scalar, vector, same ? "" : ", OUTPUT DIFFERS");
+	return same;
+}
+
+const char *KernelSetName(BlitRunKernelSet set)
+{
+	switch (set) {
+	case BlitRunKernelSet::Scalar:
+		return "scalar";
+	case BlitRunKernelSet::AVX2:
+		return "AVX2";
+	case BlitRunKernelSet::NEON:
+		return "NEON";
+	}
+	return "unknown";
+}
+
+[[noreturn]] void PrintUsage(const char *program)
+{
+	std::fprintf(stderr, "Usage: %s [--passes 20] [--assets path]\n", program);
+	std::exit(EXIT_FAILURE);
+}
+
+BenchmarkOptions ParseOptions(int argc, char **argv)
+{
+	BenchmarkOptions options;
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		if (i + 1 >= argc)
+			PrintUsage(argv[0]);
+		const char *value = argv[++i];
+		if (std::strcmp(arg, "--passes") == 0) {
+			options.passes = std::max(std::atoi(value), 1);
+		} else if (std::strcmp(arg, "--assets") == 0) {
+			paths::SetAssetsPath(value);
+		} else {
+			PrintUsage(argv[0]);
+		}
+	}
+	return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	const BenchmarkOptions options = ParseOptions(argc, argv);
+
+	LoadCoreArchives();
+	LoadGameArchives();
+	if (!HaveSpawn() && !HaveDiabdat()) {
+		std::fprintf(stderr, "spawn.mpq or diabdat.mpq is required\n");
+		return EXIT_FAILURE;
+	}
+
+	leveltype = DTYPE_CATHEDRAL;
+	LoadPalette("levels\\l1data\\l1_1.pal");
+
+	const BlitRunKernelSet vectorSet = GetBestBlitRunKernelSet();
+	std::printf("Vector kernels: %s\n", KernelSetName(vectorSet));
+
+	bool ok = true;
+	for (const _monster_id monsterId : Monsters) {
+		const MonsterSprites sprites = LoadMonsterSprites(monsterId);
+		if (sprites.sheets.empty())
+			continue;
+		ok = BenchmarkDraw("ClxDraw", [](const Surface &out, Point position, ClxSprite clx, const uint8_t *) { ClxDraw(out, position, clx); }, sprites, vectorSet, options) && ok;
+		ok = BenchmarkDraw("ClxDrawTRN", ClxDrawTRN, sprites, vectorSet, options) && ok;
+		ok = BenchmarkDraw("ClxDrawBlendedTRN", ClxDrawBlendedTRN, sprites, vectorSet, options) && ok;
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <SDL_cpuinfo.h>
+#include <SDL_version.h>
+
+#include "engine/palette.h"
+#include "engine/render/blit_impl.hpp"
+#include "engine/render/clx_render.hpp"
+#include "engine/surface.hpp"
+
+namespace devilution {
+namespace {
+
+class ClxRenderTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		std::memcpy(savedTransparencyLookup_, paletteTransparencyLookup, sizeof(paletteTransparencyLookup));
+		std::mt19937 rng(42);
+		for (auto &row : paletteTransparencyLookup) {
+			for (uint8_t &color : row)
+				color = static_cast<uint8_t>(rng());
+		}
+		for (uint8_t &color : trn_)
+			color = static_cast<uint8_t>(rng());
+	}
+
+	void TearDown() override
+	{
+		UseBlitRunKernelSet(GetBestBlitRunKernelSet());
+		std::memcpy(paletteTransparencyLookup, savedTransparencyLookup_, sizeof(paletteTransparencyLookup));
+	}
+
+	uint8_t trn_[256];
+	uint8_t savedTransparencyLookup_[256][256];
+};
+
+/**
+ * @brief The vector kernel sets supported by this build and CPU, the tests comparing them with scalar skip without any.
+ */
+std::vector<BlitRunKernelSet> GetVectorKernelSets()
+{
+	std::vector<BlitRunKernelSet> sets;
+	for (const BlitRunKernelSet set : { BlitRunKernelSet::AVX2, BlitRunKernelSet::NEON }) {
+		if (UseBlitRunKernelSet(set))
+			sets.push_back(set);
+	}
+	UseBlitRunKernelSet(GetBestBlitRunKernelSet());
+	return sets;
+}
+
+TEST_F(ClxRenderTest, PicksKernelSetForCpu)
+{
+	const BlitRunKernelSet best = GetBestBlitRunKernelSet();
+#if defined(__aarch64__) && defined(__ARM_NEON)
+	EXPECT_EQ(best, BlitRunKernelSet::NEON);
+#elif SDL_VERSION_ATLEAST(2, 0, 4) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64))
+	EXPECT_EQ(best, SDL_HasAVX2() == SDL_TRUE ? BlitRunKernelSet::AVX2 : BlitRunKernelSet::Scalar);
+#else
+	EXPECT_EQ(best, BlitRunKernelSet::Scalar);
+#endif
+	EXPECT_TRUE(UseBlitRunKernelSet(BlitRunKernelSet::Scalar));
+	EXPECT_TRUE(UseBlitRunKernelSet(best));
+}
+
+/**
+ * @brief Encodes rows of pixels (index 0 is transparent) as a CLX sprite.
+ *
+ * Uses fill runs for repeated colors and pixel runs for the rest, both as long as the format allows.
+ */
+std::vector<uint8_t> EncodeClx(const std::vector<uint8_t> &pixels, uint16_t width, uint16_t height)
+{
+	std::vector<uint8_t> data { 10, 0, static_cast<uint8_t>(width), static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(height), static_cast<uint8_t>(height >> 8), 0, 0, 0, 0 };
+	for (int y = height - 1; y >= 0; --y) {
+		const uint8_t *row = &pixels[y * width];
+		unsigned x = 0;
+		while (x < width) {
+			unsigned length = 1;
+			if (row[x] == 0) {
+				while (x + length < width && row[x + length] == 0 && length < 0x7F)
+					++length;
+				data.push_back(static_cast<uint8_t>(length));
+			} else if (x + 1 < width && row[x + 1] == row[x]) {
+				while (x + length < width && row[x + length] == row[x] && length < 63)
+					++length;
+				data.push_back(static_cast<uint8_t>(0xBF - length));
+				data.push_back(row[x]);
+			} else {
+				while (x + length < width && row[x + length] != 0 && length < 65)
+					++length;
+				data.push_back(static_cast<uint8_t>(0x100 - length));
+				data.insert(data.end(), row + x, row + x + length);
+			}
+			x += length;
+		}
+	}
+	return data;
+}
+
+std::vector<uint8_t> CreateTestPixels(uint16_t width, uint16_t height)
+{
+	std::mt19937 rng(7);
+	std::vector<uint8_t> pixels(width * height);
+	for (uint8_t &pixel : pixels) {
+		const unsigned kind = rng() % 16;
+		if (kind == 0)
+			pixel = 0;
+		else
+			pixel = static_cast<uint8_t>(rng() % 255 + 1);
+	}
+	// Long transparent, fill and pixel runs to exercise the vector kernels.
+	for (uint16_t y = 0; y < height; y += 3) {
+		std::memset(&pixels[y * width + 3], 0, 40);
+		std::memset(&pixels[y * width + 50], static_cast<uint8_t>(y + 1), 60);
+	}
+	return pixels;
+}
+
+using DrawFn = void (*)(const Surface &out, Point position, ClxSprite clx, const uint8_t *trn);
+
+void ExpectDrawMatchesScalar(DrawFn draw, const uint8_t *trn)
+{
+	const std::vector<BlitRunKernelSet> vectorSets = GetVectorKernelSets();
+	if (vectorSets.empty())
+		GTEST_SKIP() << "Only the scalar blit kernels are available";
+
+	constexpr uint16_t Width = 150;
+	constexpr uint16_t Height = 37;
+	const std::vector<uint8_t> pixels = CreateTestPixels(Width, Height);
+	const std::vector<uint8_t> data = EncodeClx(pixels, Width, Height);
+	const ClxSprite sprite { data.data(), static_cast<uint32_t>(data.size()) };
+
+	for (const BlitRunKernelSet set : vectorSets) {
+		// Unclipped, and clipped on every side.
+		for (const Point position : { Point { 10, 50 }, Point { -17, 50 }, Point { 120, 50 }, Point { 10, 20 }, Point { 10, 70 } }) {
+			OwnedSurface expected { 200, 60 };
+			OwnedSurface actual { 200, 60 };
+			for (int y = 0; y < expected.h(); ++y) {
+				for (int x = 0; x < expected.w(); ++x)
+					*expected.at(x, y) = *actual.at(x, y) = static_cast<uint8_t>(x * 3 + y * 5);
+			}
+
+			UseBlitRunKernelSet(BlitRunKernelSet::Scalar);
+			draw(expected, position, sprite, trn);
+			UseBlitRunKernelSet(set);
+			draw(actual, position, sprite, trn);
+
+			for (int y = 0; y < expected.h(); ++y)
+				ASSERT_EQ(std::memcmp(expected.at(0, y), actual.at(0, y), expected.w()), 0) << "Row " << y << " differs at " << position << " with kernel set " << static_cast<int>(set);
+		}
+	}
+}
+
+TEST_F(ClxRenderTest, RunKernelsMatchScalar)
+{
+	const std::vector<BlitRunKernelSet> vectorSets = GetVectorKernelSets();
+	if (vectorSets.empty())
+		GTEST_SKIP() << "Only the scalar blit kernels are available";
+
+	std::mt19937 rng(1);
+	uint8_t src[300];
+	for (uint8_t &pixel : src)
+		pixel = static_cast<uint8_t>(rng());
+	// The last entries of the tables are the edge cases for the table lookups.
+	std::memset(src + 200, 0xFF, 40);
+	uint8_t trn[256];
+	std::memcpy(trn, trn_, sizeof(trn));
+	trn[0xFF] = 0xFF;
+
+	for (unsigned length = 1; length <= 260; ++length) {
+		uint8_t background[300];
+		for (uint8_t &pixel : background)
+			pixel = static_cast<uint8_t>(rng());
+		std::memset(background + 210, 0xFF, 20);
+
+		const auto expectSame = [&](const char *name, auto &&blit) {
+			for (const BlitRunKernelSet set : vectorSets) {
+				uint8_t expected[300];
+				uint8_t actual[300];
+				std::memcpy(expected, background, sizeof(background));
+				std::memcpy(actual, background, sizeof(background));
+				UseBlitRunKernelSet(BlitRunKernelSet::Scalar);
+				blit(expected);
+				UseBlitRunKernelSet(set);
+				blit(actual);
+				EXPECT_EQ(std::memcmp(expected, actual, sizeof(expected)), 0) << name << " length " << length << " with kernel set " << static_cast<int>(set);
+			}
+		};
+		expectSame("PixelsWithMap", [&](uint8_t *dst) { BlitPixelsWithMap(dst + 1, src + 20, length, trn); });
+		expectSame("PixelsBlendedWithMap", [&](uint8_t *dst) { BlitPixelsBlendedWithMap(dst + 1, src + 20, length, trn); });
+		expectSame("FillBlended", [&](uint8_t *dst) { BlitFillBlended(dst + 1, length, src[length]); });
+	}
+}
+
+TEST_F(ClxRenderTest, DirectRunsMatchMemcpy)
+{
+	std::mt19937 rng(1);
+	uint8_t src[300];
+	for (uint8_t &pixel : src)
+		pixel = static_cast<uint8_t>(rng());
+
+	for (unsigned length = 1; length <= 260; ++length) {
+		uint8_t background[300];
+		for (uint8_t &pixel : background)
+			pixel = static_cast<uint8_t>(rng());
+
+		uint8_t expected[300];
+		uint8_t actual[300];
+		std::memcpy(expected, background, sizeof(background));
+		std::memcpy(actual, background, sizeof(background));
+		std::memcpy(expected + 1, src, length);
+		BlitPixelsDirect(actual + 1, src, length);
+		EXPECT_EQ(std::memcmp(expected, actual, sizeof(expected)), 0) << "PixelsDirect length " << length;
+		std::memset(expected + 1, src[length], length);
+		BlitFillDirect(actual + 1, length, src[length]);
+		EXPECT_EQ(std::memcmp(expected, actual, sizeof(expected)), 0) << "FillDirect length " << length;
+	}
+}
+
+TEST_F(ClxRenderTest, DrawMatchesScalar)
+{
+	ExpectDrawMatchesScalar([](const Surface &out, Point position, ClxSprite clx, const uint8_t *) { ClxDraw(out, position, clx); }, nullptr);
+}
+
+TEST_F(ClxRenderTest, DrawTRNMatchesScalar)
+{
+	ExpectDrawMatchesScalar(ClxDrawTRN, trn_);
+}
+
+TEST_F(ClxRenderTest, DrawBlendedTRNMatchesScalar)
+{
+	ExpectDrawMatchesScalar(ClxDrawBlendedTRN, trn_);
+}
+
+} // namespace
+} // namespace devilution
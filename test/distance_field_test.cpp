@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "engine/distance_field.hpp"
+#include "engine/path.h"
+
+// The following headers are included to access globals used in functions that have not been isolated yet.
+#include "levels/gendung.h"
+
+namespace devilution {
+namespace {
+
+class DistanceFieldTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		FillTileLayer(dPiece, 0);
+		SOLData[0] = TileProperties::None;
+		SOLData[1] = TileProperties::Solid;
+	}
+
+	DistanceField field_;
+};
+
+TEST_F(DistanceFieldTest, OpenSpace)
+{
+	constexpr Point start { 56, 56 };
+	field_.update([](Point) { return true; }, start);
+
+	EXPECT_EQ(field_.distance(start), 0);
+	EXPECT_EQ(field_.distance(start + Displacement { 1, 1 }), 1) << "Diagonal steps count as one step";
+	EXPECT_EQ(field_.distance(start + Displacement { 5, -3 }), 5);
+	EXPECT_EQ(field_.distance(start + Displacement { -26, 10 }), 26) << "Tiles at the maximum distance are reached";
+	EXPECT_EQ(field_.distance(start + Displacement { 27, 0 }), -1) << "Tiles beyond the maximum distance aren't reached";
+	EXPECT_TRUE(field_.obstacles().empty());
+
+	field_.update([](Point) { return true; }, { 2, 2 });
+	EXPECT_EQ(field_.distance({ 0, 0 }), 2) << "The search stops at the edge of the map";
+	EXPECT_EQ(field_.distance({ -1, 0 }), -1) << "Tiles outside the map are never reached";
+}
+
+TEST_F(DistanceFieldTest, Obstacles)
+{
+	// A wall from { 50, 40 } to { 50, 60 }, with the start just west of it.
+	const auto posOk = [](Point position) { return position.x != 50 || position.y < 40 || position.y > 60; };
+	constexpr Point start { 49, 50 };
+	field_.update(posOk, start);
+
+	EXPECT_EQ(field_.distance({ 50, 50 }), 1) << "Obstacles next to a reachable tile can be targeted";
+	EXPECT_EQ(field_.distance({ 50, 45 }), 5);
+	EXPECT_EQ(field_.distance({ 51, 50 }), 22) << "The shortest path goes around the end of the wall";
+
+	const std::vector<Point> &obstacles = field_.obstacles();
+	ASSERT_EQ(obstacles.size(), 21U);
+	EXPECT_TRUE(std::is_sorted(obstacles.begin(), obstacles.end(), [this](Point a, Point b) {
+		return field_.distance(a) < field_.distance(b);
+	})) << "Obstacles are in the order they were found";
+}
+
+TEST_F(DistanceFieldTest, SolidCorners)
+{
+	constexpr Point start { 30, 30 };
+	dPiece[31][30] = 1;
+	// The solid piece passes the check, but stepping diagonally past it isn't allowed.
+	field_.update([](Point) { return true; }, start);
+
+	EXPECT_EQ(field_.distance({ 31, 31 }), 2) << "Can't cut a solid corner";
+	EXPECT_EQ(field_.distance({ 29, 29 }), 1);
+}
+
+TEST_F(DistanceFieldTest, Invalidate)
+{
+	EXPECT_FALSE(field_.isValid());
+	field_.update([](Point) { return true; }, { 10, 10 });
+	EXPECT_TRUE(field_.isValid());
+	EXPECT_EQ(field_.origin(), (Point { 10, 10 }));
+
+	field_.invalidate();
+	EXPECT_FALSE(field_.isValid());
+	EXPECT_EQ(field_.distance({ 10, 10 }), -1);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,345 @@
+/**
+ * @file dungeon_sweep.cpp
+ *
+ * Generates dungeon levels without a window for a range of seeds, to measure the speed of the
+ * generators and to find seeds that hang, retry for a long time or produce invalid layouts.
+ *
+ * Usage: dungeon_sweep [--levels 1-28] [--seeds 100000] [--start 0] [--jobs N] [--timeout 10] [--retries 100] [--assets DIR]
+ *
+ * Level 0 is the town. The generators share global state, so the seeds are split between
+ * worker processes instead of threads (a single in-process worker on Windows).
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "diablo.h"
+#include "init.h"
+#include "levels/gendung.h"
+#include "multi.h"
+#include "player.h"
+#include "quests.h"
+#include "utils/paths.h"
+
+using namespace devilution;
+
+namespace {
+
+struct SweepOptions {
+	int firstLevel = 1;
+	int lastLevel = 28;
+	uint32_t firstSeed = 0;
+	uint32_t seedCount = 100000;
+	unsigned jobs = std::max(std::thread::hardware_concurrency(), 1U);
+	unsigned timeoutSeconds = 10;
+	/** Layouts needing more attempts than this are reported as retry loops. */
+	uint32_t retryThreshold = 100;
+};
+
+/**
+ * @brief Progress and findings of a worker, in memory shared with the parent process.
+ */
+struct WorkerState {
+	std::atomic<uint32_t> generated;
+	std::atomic<uint32_t> currentSeed;
+	uint64_t attempts;
+	uint32_t maxAttempts;
+	uint32_t maxAttemptsSeed;
+	uint32_t retryLoops;
+	uint32_t firstRetryLoopSeed;
+	uint32_t invalidLayouts;
+	uint32_t firstInvalidSeed;
+	/** Seeds the parent killed the worker for, the worker is restarted after each one. */
+	uint32_t hangs;
+	uint32_t firstHangSeed;
+	/** Seeds the worker crashed on, it is restarted after each one. */
+	uint32_t crashes;
+	uint32_t firstCrashSeed;
+};
+
+bool IsValidLayout()
+{
+	if (leveltype == DTYPE_TOWN)
+		return true;
+
+	// Tile 0 doesn't exist, `DRLG_LPass3` would read before the start of the mega tiles.
+	for (int y = 0; y < DMAXY; y++) {
+		for (int x = 0; x < DMAXX; x++) {
+			if (dungeon[x][y] == 0)
+				return false;
+		}
+	}
+
+	const Rectangle levelArea { { 16, 16 }, { DMAXX * 2, DMAXY * 2 } };
+	return levelArea.contains(ViewPosition);
+}
+
+/**
+ * @brief Generates every `options.jobs`th seed, starting with the seed at index `first`.
+ */
+void RunWorker(int level, const SweepOptions &options, uint32_t first, WorkerState &state)
+{
+	currlevel = level;
+	leveltype = GetLevelType(level);
+
+	for (uint32_t i = first; i < options.seedCount; i += options.jobs) {
+		const uint32_t seed = options.firstSeed + i;
+		state.currentSeed.store(seed, std::memory_order_relaxed);
+
+		CreateDungeon(seed, ENTRY_MAIN);
+
+		state.attempts += DungeonGenerationAttempts;
+		if (DungeonGenerationAttempts > state.maxAttempts) {
+			state.maxAttempts = DungeonGenerationAttempts;
+			state.maxAttemptsSeed = seed;
+		}
+		if (DungeonGenerationAttempts > options.retryThreshold && state.retryLoops++ == 0)
+			state.firstRetryLoopSeed = seed;
+		if (!IsValidLayout() && state.invalidLayouts++ == 0)
+			state.firstInvalidSeed = seed;
+
+		state.generated.fetch_add(1, std::memory_order_release);
+	}
+}
+
+#ifndef _WIN32
+/**
+ * @brief Runs one worker process per job and waits for them.
+ *
+ * Workers that stop making progress are killed, and workers that hang or crash are restarted at the
+ * seed after the failing one, so every other seed of the range is still generated.
+ */
+void RunWorkers(int level, const SweepOptions &options, WorkerState *states)
+{
+	struct Worker {
+		pid_t pid;
+		uint32_t lastGenerated;
+		std::chrono::steady_clock::time_point lastProgress;
+	};
+	std::vector<Worker> workers(options.jobs);
+	size_t running = 0;
+
+	const auto spawn = [&](unsigned worker, uint32_t first) {
+		Worker &process = workers[worker];
+		process.pid = 0;
+		if (first >= options.seedCount)
+			return;
+		WorkerState &state = states[worker];
+		// The seed of a worker that dies before generating anything isn't left at a previous one.
+		state.currentSeed.store(options.firstSeed + first, std::memory_order_relaxed);
+		const pid_t pid = fork();
+		if (pid == 0) {
+			RunWorker(level, options, first, state);
+			std::_Exit(EXIT_SUCCESS);
+		}
+		if (pid < 0) {
+			std::perror("fork");
+			std::exit(EXIT_FAILURE);
+		}
+		process = { pid, state.generated.load(std::memory_order_acquire), std::chrono::steady_clock::now() };
+		running++;
+	};
+	for (unsigned worker = 0; worker < options.jobs; worker++)
+		spawn(worker, worker);
+
+	while (running != 0) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		const auto now = std::chrono::steady_clock::now();
+		for (unsigned worker = 0; worker < workers.size(); worker++) {
+			Worker &process = workers[worker];
+			if (process.pid == 0)
+				continue;
+			WorkerState &state = states[worker];
+
+			int status;
+			if (waitpid(process.pid, &status, WNOHANG) == process.pid) {
+				running--;
+				process.pid = 0;
+				if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+					const uint32_t seed = state.currentSeed.load();
+					std::printf("level %d: seed %u crashed the generator\n", level, seed);
+					if (state.crashes++ == 0)
+						state.firstCrashSeed = seed;
+					spawn(worker, seed - options.firstSeed + options.jobs);
+				}
+				continue;
+			}
+
+			const uint32_t generated = state.generated.load(std::memory_order_acquire);
+			if (generated != process.lastGenerated) {
+				process.lastGenerated = generated;
+				process.lastProgress = now;
+			} else if (now - process.lastProgress > std::chrono::seconds(options.timeoutSeconds)) {
+				kill(process.pid, SIGKILL);
+				waitpid(process.pid, &status, 0);
+				running--;
+				const uint32_t seed = state.currentSeed.load();
+				std::printf("level %d: seed %u hangs (no layout after %us)\n", level, seed, options.timeoutSeconds);
+				if (state.hangs++ == 0)
+					state.firstHangSeed = seed;
+				spawn(worker, seed - options.firstSeed + options.jobs);
+			}
+		}
+	}
+}
+#endif
+
+/**
+ * @brief Generates all seeds of a level and prints the results, returns false if any seed failed.
+ */
+bool SweepLevel(int level, const SweepOptions &options)
+{
+#ifdef _WIN32
+	std::unique_ptr<WorkerState[]> ownedStates { new WorkerState[1] {} };
+	WorkerState *states = ownedStates.get();
+#else
+	void *sharedMemory = mmap(nullptr, sizeof(WorkerState) * options.jobs, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (sharedMemory == MAP_FAILED) {
+		std::perror("mmap");
+		std::exit(EXIT_FAILURE);
+	}
+	auto *states = static_cast<WorkerState *>(sharedMemory);
+	for (unsigned worker = 0; worker < options.jobs; worker++)
+		new (&states[worker]) WorkerState {};
+#endif
+
+	const auto start = std::chrono::steady_clock::now();
+#ifdef _WIN32
+	RunWorker(level, options, 0, states[0]);
+#else
+	RunWorkers(level, options, states);
+#endif
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	WorkerState total {};
+	total.maxAttemptsSeed = options.firstSeed;
+	for (unsigned worker = 0; worker < options.jobs; worker++) {
+		const WorkerState &state = states[worker];
+		total.generated += state.generated.load();
+		total.attempts += state.attempts;
+		if (state.maxAttempts > total.maxAttempts) {
+			total.maxAttempts = state.maxAttempts;
+			total.maxAttemptsSeed = state.maxAttemptsSeed;
+		}
+		if (state.retryLoops != 0 && (total.retryLoops == 0 || state.firstRetryLoopSeed < total.firstRetryLoopSeed))
+			total.firstRetryLoopSeed = state.firstRetryLoopSeed;
+		total.retryLoops += state.retryLoops;
+		if (state.invalidLayouts != 0 && (total.invalidLayouts == 0 || state.firstInvalidSeed < total.firstInvalidSeed))
+			total.firstInvalidSeed = state.firstInvalidSeed;
+		total.invalidLayouts += state.invalidLayouts;
+		if (state.hangs != 0 && (total.hangs == 0 || state.firstHangSeed < total.firstHangSeed))
+			total.firstHangSeed = state.firstHangSeed;
+		total.hangs += state.hangs;
+		if (state.crashes != 0 && (total.crashes == 0 || state.firstCrashSeed < total.firstCrashSeed))
+			total.firstCrashSeed = state.firstCrashSeed;
+		total.crashes += state.crashes;
+	}
+
+#ifndef _WIN32
+	munmap(sharedMemory, sizeof(WorkerState) * options.jobs);
+#endif
+
+	const uint32_t generated = total.generated.load();
+	std::printf("level %2d: %u layouts in %.2fs (%.0f/s), attempts avg %.2f max %u (seed %u)",
+	    level, generated, elapsed.count(), generated / std::max(elapsed.count(), 1e-9),
+	    generated != 0 ? static_cast<double>(total.attempts) / generated : 0.0, total.maxAttempts, total.maxAttemptsSeed);
+	if (total.retryLoops != 0)
+		std::printf(", %u over %u attempts (first seed %u)", total.retryLoops, options.retryThreshold, total.firstRetryLoopSeed);
+	if (total.invalidLayouts != 0)
+		std::printf(", %u invalid (first seed %u)", total.invalidLayouts, total.firstInvalidSeed);
+	if (total.hangs != 0)
+		std::printf(", %u timed out (first seed %u)", total.hangs, total.firstHangSeed);
+	if (total.crashes != 0)
+		std::printf(", %u crashed (first seed %u)", total.crashes, total.firstCrashSeed);
+	std::printf("\n");
+	std::fflush(stdout);
+
+	return total.hangs == 0 && total.crashes == 0 && total.invalidLayouts == 0;
+}
+
+[[noreturn]] void PrintUsage(const char *program)
+{
+	std::fprintf(stderr, "Usage: %s [--levels 1-28] [--seeds 100000] [--start 0] [--jobs N] [--timeout 10] [--retries 100] [--assets DIR]\n", program);
+	std::exit(EXIT_FAILURE);
+}
+
+SweepOptions ParseOptions(int argc, char **argv)
+{
+	SweepOptions options;
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		if (i + 1 >= argc)
+			PrintUsage(argv[0]);
+		const char *value = argv[++i];
+		if (std::strcmp(arg, "--levels") == 0) {
+			const char *dash = std::strchr(value, '-');
+			options.firstLevel = std::atoi(value);
+			options.lastLevel = dash != nullptr ? std::atoi(dash + 1) : options.firstLevel;
+		} else if (std::strcmp(arg, "--seeds") == 0) {
+			options.seedCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (std::strcmp(arg, "--start") == 0) {
+			options.firstSeed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (std::strcmp(arg, "--jobs") == 0) {
+			options.jobs = std::max(std::atoi(value), 1);
+		} else if (std::strcmp(arg, "--timeout") == 0) {
+			options.timeoutSeconds = std::max(std::atoi(value), 1);
+		} else if (std::strcmp(arg, "--retries") == 0) {
+			options.retryThreshold = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (std::strcmp(arg, "--assets") == 0) {
+			paths::SetAssetsPath(value);
+		} else {
+			PrintUsage(argv[0]);
+		}
+	}
+	if (options.firstLevel < 0 || options.lastLevel < options.firstLevel || GetLevelType(options.lastLevel) == DTYPE_NONE)
+		PrintUsage(argv[0]);
+#ifdef _WIN32
+	options.jobs = 1;
+#endif
+	return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	const SweepOptions options = ParseOptions(argc, argv);
+
+	HeadlessMode = true;
+	LoadCoreArchives();
+	LoadGameArchives();
+
+	Players.resize(1);
+	MyPlayer = &Players[0];
+	sgGameInitInfo.fullQuests = 1;
+	InitQuests();
+
+	// Tile indices are bytes, so this covers any layout, the contents of the tiles don't affect generation.
+	pMegaTiles = std::make_unique<MegaTile[]>(256);
+
+	std::printf("Sweeping levels %d-%d, seeds %u-%u, %u jobs\n", options.firstLevel, options.lastLevel,
+	    options.firstSeed, options.firstSeed + options.seedCount - 1, options.jobs);
+	std::fflush(stdout);
+
+	bool ok = true;
+	for (int level = options.firstLevel; level <= options.lastLevel; level++)
+		ok = SweepLevel(level, options) && ok;
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,370 @@
+/**
+ * @file item_search.cpp
+ *
+ * Generates items without a window over a range of seeds and item levels, printing those that match
+ * the given base item, affixes, quality and stat ranges, along with the generation throughput.
+ *
+ * Usage: item_search [--item NAME] [--prefix NAME] [--suffix NAME] [--unique NAME] [--quality normal|magic|unique]
+ *                    [--stat NAME=MIN[:MAX]]... [--levels 1-30] [--seeds 10000] [--start 0] [--jobs N] [--limit 100]
+ *                    [--onlygood] [--uper 1|15] [--multiplayer]
+ *
+ * Names are matched case-insensitively against a part of the name. Stats: ac, damage, todam, tohit, acbonus,
+ * str, mag, dex, vit, fr, lr, mr, res (lowest resistance), life, mana, value.
+ *
+ * Every match is printed with the base item index, creation info and seed that `RecreateItem` takes, so it
+ * can be reproduced in game. Item generation uses global state, so the seeds are split between worker
+ * processes instead of threads (a single in-process worker on Windows). Each item is generated once, so
+ * the items are generated with `RecreateItemUncached`, bypassing the cache of recreated items.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "diablo.h"
+#include "itemdat.h"
+#include "items.h"
+#include "multi.h"
+#include "player.h"
+
+using namespace devilution;
+
+namespace {
+
+struct StatInfo {
+	const char *name;
+	int (*get)(const Item &item);
+};
+
+const StatInfo Stats[] = {
+	{ "ac", [](const Item &item) -> int { return item._iAC; } },
+	{ "damage", [](const Item &item) -> int { return item._iMaxDam; } },
+	{ "todam", [](const Item &item) -> int { return item._iPLDam; } },
+	{ "tohit", [](const Item &item) -> int { return item._iPLToHit; } },
+	{ "acbonus", [](const Item &item) -> int { return item._iPLAC; } },
+	{ "str", [](const Item &item) -> int { return item._iPLStr; } },
+	{ "mag", [](const Item &item) -> int { return item._iPLMag; } },
+	{ "dex", [](const Item &item) -> int { return item._iPLDex; } },
+	{ "vit", [](const Item &item) -> int { return item._iPLVit; } },
+	{ "fr", [](const Item &item) -> int { return item._iPLFR; } },
+	{ "lr", [](const Item &item) -> int { return item._iPLLR; } },
+	{ "mr", [](const Item &item) -> int { return item._iPLMR; } },
+	{ "res", [](const Item &item) -> int { return std::min({ item._iPLFR, item._iPLLR, item._iPLMR }); } },
+	{ "life", [](const Item &item) -> int { return item._iPLHP >> 6; } },
+	{ "mana", [](const Item &item) -> int { return item._iPLMana >> 6; } },
+	{ "value", [](const Item &item) -> int { return item._iIvalue; } },
+};
+
+struct StatRange {
+	const StatInfo *stat;
+	int min;
+	int max;
+};
+
+struct SearchOptions {
+	int firstLevel = 1;
+	int lastLevel = 30;
+	uint32_t firstSeed = 0;
+	uint32_t seedCount = 10000;
+	unsigned jobs = std::max(std::thread::hardware_concurrency(), 1U);
+	uint32_t limit = 100;
+	uint16_t flags = CF_UPER1;
+
+	const char *item = nullptr;
+	const char *prefix = nullptr;
+	const char *suffix = nullptr;
+	const char *unique = nullptr;
+	int quality = -1;
+	std::vector<StatRange> stats;
+
+	/** Base items to generate, all droppable weapons, armor and jewelry unless `--item` is given. */
+	std::vector<_item_indexes> baseItems;
+};
+
+/**
+ * @brief Progress of all the workers, in memory shared with the parent process.
+ */
+struct SearchProgress {
+	std::atomic<uint64_t> generated;
+	std::atomic<uint32_t> matches;
+};
+
+bool ContainsIgnoreCase(const char *haystack, const char *needle)
+{
+	const char *end = haystack + std::strlen(haystack);
+	return std::search(haystack, end, needle, needle + std::strlen(needle), [](char a, char b) {
+		return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+	}) != end;
+}
+
+/**
+ * @brief Checks that the prefix or suffix named `name` is part of the item, the power only tells the effect apart.
+ */
+bool HasAffix(const PLStruct *affixes, item_effect_type power, const char *itemName, const char *name)
+{
+	if (power == IPL_INVALID)
+		return false;
+	for (const PLStruct *affix = affixes; affix->power.type != IPL_INVALID; affix++) {
+		if (affix->power.type == power && ContainsIgnoreCase(affix->PLName, name) && std::strstr(itemName, affix->PLName) != nullptr)
+			return true;
+	}
+	return false;
+}
+
+bool Matches(const Item &item, const SearchOptions &options)
+{
+	if (options.quality != -1 && item._iMagical != options.quality)
+		return false;
+	if (options.prefix != nullptr && !HasAffix(ItemPrefixes, item._iPrePower, item._iIName, options.prefix))
+		return false;
+	if (options.suffix != nullptr && !HasAffix(ItemSuffixes, item._iSufPower, item._iIName, options.suffix))
+		return false;
+	if (options.unique != nullptr && (item._iMagical != ITEM_QUALITY_UNIQUE || !ContainsIgnoreCase(UniqueItems[item._iUid].UIName, options.unique)))
+		return false;
+	return std::all_of(options.stats.begin(), options.stats.end(), [&item](const StatRange &range) {
+		const int value = range.stat->get(item);
+		return value >= range.min && value <= range.max;
+	});
+}
+
+void PrintMatch(const Item &item)
+{
+	std::string line = std::string("level ") + std::to_string(item._iCreateInfo & CF_LEVEL) + ": " + item._iIName
+	    + " (idx " + std::to_string(item.IDidx) + ", createinfo " + std::to_string(item._iCreateInfo) + ", seed " + std::to_string(item._iSeed) + ")";
+	for (const StatInfo &stat : Stats) {
+		const int value = stat.get(item);
+		if (value != 0 && std::strcmp(stat.name, "value") != 0)
+			line += " " + std::string(stat.name) + "=" + std::to_string(value);
+	}
+	line += '\n';
+	// One write per line, so that lines from different workers don't interleave.
+	std::fputs(line.c_str(), stdout);
+	std::fflush(stdout);
+}
+
+void RunWorker(const SearchOptions &options, unsigned worker, SearchProgress &progress)
+{
+	const Player &player = *MyPlayer;
+	for (uint32_t i = worker; i < options.seedCount; i += options.jobs) {
+		if (progress.matches.load(std::memory_order_relaxed) >= options.limit)
+			return;
+		const int seed = static_cast<int>(options.firstSeed + i);
+		uint64_t generated = 0;
+		for (int level = options.firstLevel; level <= options.lastLevel; level++) {
+			for (const _item_indexes idx : options.baseItems) {
+				// Every item is searched as the first drop of a new game, not as a duplicate of an earlier unique.
+				std::fill(std::begin(UniqueItemFlags), std::end(UniqueItemFlags), false);
+				Item item {};
+				RecreateItemUncached(player, item, idx, static_cast<uint16_t>(level | options.flags), seed);
+				generated++;
+				if (Matches(item, options) && progress.matches.fetch_add(1, std::memory_order_relaxed) < options.limit)
+					PrintMatch(item);
+			}
+		}
+		progress.generated.fetch_add(generated, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Runs the workers and waits for them, returns false if any of them crashed.
+ */
+bool RunWorkers(const SearchOptions &options, SearchProgress &progress)
+{
+#ifdef _WIN32
+	RunWorker(options, 0, progress);
+	return true;
+#else
+	std::vector<pid_t> workers;
+	for (unsigned worker = 0; worker < options.jobs; worker++) {
+		const pid_t pid = fork();
+		if (pid == 0) {
+			RunWorker(options, worker, progress);
+			std::_Exit(EXIT_SUCCESS);
+		}
+		if (pid < 0) {
+			std::perror("fork");
+			std::exit(EXIT_FAILURE);
+		}
+		workers.push_back(pid);
+	}
+
+	bool ok = true;
+	for (unsigned worker = 0; worker < workers.size(); worker++) {
+		int status;
+		waitpid(workers[worker], &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+			std::printf("worker %u crashed\n", worker);
+			ok = false;
+		}
+	}
+	return ok;
+#endif
+}
+
+[[noreturn]] void PrintUsage(const char *program)
+{
+	std::fprintf(stderr, "Usage: %s [--item NAME] [--prefix NAME] [--suffix NAME] [--unique NAME] [--quality normal|magic|unique]\n"
+	                     "       [--stat NAME=MIN[:MAX]]... [--levels 1-30] [--seeds 10000] [--start 0] [--jobs N] [--limit 100]\n"
+	                     "       [--onlygood] [--uper 1|15] [--multiplayer]\n",
+	    program);
+	std::exit(EXIT_FAILURE);
+}
+
+StatRange ParseStatRange(const char *program, const char *value)
+{
+	const char *equals = std::strchr(value, '=');
+	if (equals == nullptr)
+		PrintUsage(program);
+	const std::string name(value, equals);
+	const auto stat = std::find_if(std::begin(Stats), std::end(Stats), [&name](const StatInfo &info) { return name == info.name; });
+	if (stat == std::end(Stats))
+		PrintUsage(program);
+	const char *colon = std::strchr(equals, ':');
+	return { &*stat, std::atoi(equals + 1), colon != nullptr ? std::atoi(colon + 1) : INT32_MAX };
+}
+
+bool IsDroppable(const ItemData &data)
+{
+	if (data.iRnd == IDROP_NEVER)
+		return false;
+	return data.iClass == ICLASS_WEAPON || data.iClass == ICLASS_ARMOR || data.iLoc == ILOC_RING || data.iLoc == ILOC_AMULET;
+}
+
+SearchOptions ParseOptions(int argc, char **argv)
+{
+	SearchOptions options;
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		if (std::strcmp(arg, "--onlygood") == 0) {
+			options.flags |= CF_ONLYGOOD;
+			continue;
+		}
+		if (std::strcmp(arg, "--multiplayer") == 0) {
+			gbIsMultiplayer = true;
+			continue;
+		}
+		if (i + 1 >= argc)
+			PrintUsage(argv[0]);
+		const char *value = argv[++i];
+		if (std::strcmp(arg, "--item") == 0) {
+			options.item = value;
+		} else if (std::strcmp(arg, "--prefix") == 0) {
+			options.prefix = value;
+		} else if (std::strcmp(arg, "--suffix") == 0) {
+			options.suffix = value;
+		} else if (std::strcmp(arg, "--unique") == 0) {
+			options.unique = value;
+		} else if (std::strcmp(arg, "--quality") == 0) {
+			if (std::strcmp(value, "normal") == 0)
+				options.quality = ITEM_QUALITY_NORMAL;
+			else if (std::strcmp(value, "magic") == 0)
+				options.quality = ITEM_QUALITY_MAGIC;
+			else if (std::strcmp(value, "unique") == 0)
+				options.quality = ITEM_QUALITY_UNIQUE;
+			else
+				PrintUsage(argv[0]);
+		} else if (std::strcmp(arg, "--stat") == 0) {
+			options.stats.push_back(ParseStatRange(argv[0], value));
+		} else if (std::strcmp(arg, "--levels") == 0) {
+			const char *dash = std::strchr(value, '-');
+			options.firstLevel = std::atoi(value);
+			options.lastLevel = dash != nullptr ? std::atoi(dash + 1) : options.firstLevel;
+		} else if (std::strcmp(arg, "--seeds") == 0) {
+			options.seedCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (std::strcmp(arg, "--start") == 0) {
+			options.firstSeed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (std::strcmp(arg, "--jobs") == 0) {
+			options.jobs = std::max(std::atoi(value), 1);
+		} else if (std::strcmp(arg, "--limit") == 0) {
+			options.limit = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (std::strcmp(arg, "--uper") == 0) {
+			options.flags &= ~CF_USEFUL;
+			if (std::strcmp(value, "1") == 0)
+				options.flags |= CF_UPER1;
+			else if (std::strcmp(value, "15") == 0)
+				options.flags |= CF_UPER15;
+			else
+				PrintUsage(argv[0]);
+		} else {
+			PrintUsage(argv[0]);
+		}
+	}
+	if (options.firstLevel < 1 || options.lastLevel < options.firstLevel || options.lastLevel > CF_LEVEL)
+		PrintUsage(argv[0]);
+
+	for (int idx = 0; idx <= IDI_LAST; idx++) {
+		const ItemData &data = AllItemsList[idx];
+		if (!IsDroppable(data))
+			continue;
+		if (options.item != nullptr && !ContainsIgnoreCase(data.iName, options.item))
+			continue;
+		options.baseItems.push_back(static_cast<_item_indexes>(idx));
+	}
+	if (options.baseItems.empty()) {
+		std::fprintf(stderr, "No droppable base item matches \"%s\"\n", options.item);
+		std::exit(EXIT_FAILURE);
+	}
+
+#ifdef _WIN32
+	options.jobs = 1;
+#endif
+	return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	const SearchOptions options = ParseOptions(argc, argv);
+
+	HeadlessMode = true;
+	Players.resize(1);
+	MyPlayer = &Players[0];
+
+	std::printf("Searching %zu base items, levels %d-%d, seeds %u-%u, %u jobs\n", options.baseItems.size(),
+	    options.firstLevel, options.lastLevel, options.firstSeed, options.firstSeed + options.seedCount - 1, options.jobs);
+	std::fflush(stdout);
+
+#ifdef _WIN32
+	SearchProgress progress {};
+#else
+	void *sharedMemory = mmap(nullptr, sizeof(SearchProgress), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (sharedMemory == MAP_FAILED) {
+		std::perror("mmap");
+		return EXIT_FAILURE;
+	}
+	SearchProgress &progress = *new (sharedMemory) SearchProgress {};
+#endif
+
+	const auto start = std::chrono::steady_clock::now();
+	const bool ok = RunWorkers(options, progress);
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	const uint64_t generated = progress.generated.load();
+	const uint32_t matches = progress.matches.load();
+	std::printf("%u matches", std::min(matches, options.limit));
+	if (matches >= options.limit)
+		std::printf(" (limit reached)");
+	std::printf(", %llu items in %.2fs (%.0f/s)\n", static_cast<unsigned long long>(generated), elapsed.count(),
+	    generated / std::max(elapsed.count(), 1e-9));
+
+#ifndef _WIN32
+	munmap(sharedMemory, sizeof(SearchProgress));
+#endif
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "engine/random.hpp"
+#include "items.h"
+#include "player.h"
+
+namespace devilution {
+namespace {
+
+class ItemsTest : public ::testing::Test {
+public:
+	void SetUp() override
+	{
+		Players.resize(1);
+		MyPlayer = &Players[0];
+		gbIsMultiplayer = false;
+		ClearItemRecreationCache();
+	}
+};
+
+void ExpectSameItem(const Item &expected, const Item &actual)
+{
+	EXPECT_STREQ(actual._iIName, expected._iIName);
+	EXPECT_EQ(actual._iMagical, expected._iMagical);
+	EXPECT_EQ(actual._iPrePower, expected._iPrePower);
+	EXPECT_EQ(actual._iSufPower, expected._iSufPower);
+	EXPECT_EQ(actual._iAC, expected._iAC);
+	EXPECT_EQ(actual._iMinDam, expected._iMinDam);
+	EXPECT_EQ(actual._iMaxDam, expected._iMaxDam);
+	EXPECT_EQ(actual._iIvalue, expected._iIvalue);
+	EXPECT_EQ(actual._iDurability, expected._iDurability);
+	EXPECT_EQ(actual._iCreateInfo, expected._iCreateInfo);
+	EXPECT_EQ(actual._iSeed, expected._iSeed);
+}
+
+TEST_F(ItemsTest, RecreateItemFromCache)
+{
+	const Player &player = *MyPlayer;
+	constexpr uint16_t CreateInfo = 30 | CF_ONLYGOOD;
+	constexpr int Seed = 123456;
+
+	Item generated {};
+	RecreateItem(player, generated, IDI_WARRCLUB, CreateInfo, Seed, 0);
+	const uint32_t rngState = GetLCGEngineState();
+	const ItemRecreationCacheStats statsAfterMiss = GetItemRecreationCacheStats();
+	EXPECT_EQ(statsAfterMiss.entries, 1U);
+
+	SetRndSeed(0);
+	Item cached {};
+	RecreateItem(player, cached, IDI_WARRCLUB, CreateInfo, Seed, 0);
+	EXPECT_EQ(GetItemRecreationCacheStats().hits, statsAfterMiss.hits + 1);
+	EXPECT_EQ(GetLCGEngineState(), rngState) << "A cached item leaves the random number generator in the same state";
+	ExpectSameItem(generated, cached);
+
+	ClearItemRecreationCache();
+	Item regenerated {};
+	RecreateItem(player, regenerated, IDI_WARRCLUB, CreateInfo, Seed, 0);
+	ExpectSameItem(generated, regenerated);
+}
+
+TEST_F(ItemsTest, RecreateItemCacheDependsOnGameMode)
+{
+	const Player &player = *MyPlayer;
+	Item item {};
+	RecreateItem(player, item, IDI_WARRCLUB, 30 | CF_ONLYGOOD, 42, 0);
+	const size_t misses = GetItemRecreationCacheStats().misses;
+
+	gbIsMultiplayer = true;
+	item = {};
+	RecreateItem(player, item, IDI_WARRCLUB, 30 | CF_ONLYGOOD, 42, 0);
+	EXPECT_EQ(GetItemRecreationCacheStats().misses, misses + 1) << "Multiplayer items are cached separately";
+	gbIsMultiplayer = false;
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "drlg_test.hpp"
+#include "levels/gendung.h"
+#include "levels/layout_cache.h"
+#include "options.h"
+
+using namespace devilution;
+
+namespace {
+
+class LayoutCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		sgOptions.Gameplay.reuseLevelLayouts.SetValue(true);
+		ClearLayoutCache();
+		before_ = GetLayoutCacheStats();
+	}
+
+	void TearDown() override
+	{
+		sgOptions.Gameplay.reuseLevelLayouts.SetValue(false);
+		ClearLayoutCache();
+	}
+
+	LayoutCacheStats before_;
+};
+
+TEST_F(LayoutCacheTest, ReusesLayoutForAnyEntry)
+{
+	LoadExpectedLevelData("diablo/13-428074402.dun");
+
+	TestInitGame();
+	Quests[Q_WARLORD]._qactive = QUEST_NOTAVAIL;
+
+	TestCreateDungeon(13, 428074402, ENTRY_MAIN);
+	EXPECT_EQ(ViewPosition, Point(26, 64));
+
+	// Entering again from either side restores the layout, which still matches the generated level,
+	// with the view at the stairs used.
+	TestCreateDungeon(13, 428074402, ENTRY_PREV);
+	EXPECT_EQ(ViewPosition, Point(49, 77));
+	TestCreateDungeon(13, 428074402, ENTRY_MAIN);
+	EXPECT_EQ(ViewPosition, Point(26, 64));
+
+	const LayoutCacheStats stats = GetLayoutCacheStats();
+	EXPECT_EQ(stats.layouts, 1U);
+	EXPECT_EQ(stats.hits - before_.hits, 2U);
+	EXPECT_EQ(stats.misses - before_.misses, 1U);
+}
+
+TEST_F(LayoutCacheTest, RegeneratesAfterQuestChange)
+{
+	LoadExpectedLevelData("diablo/13-594689775.dun");
+
+	TestInitGame();
+	Quests[Q_WARLORD]._qactive = QUEST_INIT;
+
+	TestCreateDungeon(13, 594689775, ENTRY_MAIN);
+	Quests[Q_WARLORD]._qvar1 = 1;
+	TestCreateDungeon(13, 594689775, ENTRY_MAIN);
+	EXPECT_EQ(ViewPosition, Point(72, 38));
+
+	const LayoutCacheStats stats = GetLayoutCacheStats();
+	EXPECT_EQ(stats.layouts, 1U) << "The outdated layout is replaced";
+	EXPECT_EQ(stats.hits - before_.hits, 0U);
+	EXPECT_EQ(stats.misses - before_.misses, 2U);
+}
+
+} // namespace
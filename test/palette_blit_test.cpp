@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <SDL.h>
+
+#include "utils/palette_blit.hpp"
+#include "utils/sdl_wrap.h"
+
+namespace devilution {
+namespace {
+
+constexpr int Width = 67;
+constexpr int Height = 23;
+
+SDLPaletteUniquePtr CreateTestPalette()
+{
+	SDLPaletteUniquePtr palette = SDLWrap::AllocPalette();
+	SDL_Color colors[256];
+	for (int i = 0; i < 256; ++i) {
+		colors[i].r = static_cast<Uint8>(i);
+		colors[i].g = static_cast<Uint8>(255 - i);
+		colors[i].b = static_cast<Uint8>(i * 37);
+		colors[i].a = SDL_ALPHA_OPAQUE;
+	}
+	SDL_SetPaletteColors(palette.get(), colors, 0, 256);
+	return palette;
+}
+
+SDLSurfaceUniquePtr CreateTestPalSurface(SDL_Palette *palette)
+{
+	SDLSurfaceUniquePtr surface = SDLWrap::CreateRGBSurfaceWithFormat(0, Width, Height, 8, SDL_PIXELFORMAT_INDEX8);
+	SDL_SetSurfacePalette(surface.get(), palette);
+	auto *pixels = static_cast<uint8_t *>(surface->pixels);
+	for (int y = 0; y < Height; ++y) {
+		for (int x = 0; x < Width; ++x) {
+			pixels[y * surface->pitch + x] = static_cast<uint8_t>(x * 7 + y * 13);
+		}
+	}
+	return surface;
+}
+
+void ExpectSurfacesEqual(const SDL_Surface &expected, const SDL_Surface &actual)
+{
+	ASSERT_EQ(expected.w, actual.w);
+	ASSERT_EQ(expected.h, actual.h);
+	for (int y = 0; y < expected.h; ++y) {
+		const auto *expectedRow = static_cast<const uint8_t *>(expected.pixels) + y * expected.pitch;
+		const auto *actualRow = static_cast<const uint8_t *>(actual.pixels) + y * actual.pitch;
+		ASSERT_EQ(std::memcmp(expectedRow, actualRow, expected.w * 4), 0) << "Row " << y << " differs";
+	}
+}
+
+TEST(PaletteBlitTest, ConvertRowKernelsMatchScalar)
+{
+	SDLPaletteUniquePtr palette = CreateTestPalette();
+	SDLSurfaceUniquePtr output = SDLWrap::CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+	PaletteBlitTable table;
+	BuildPaletteBlitTable(*palette, *output->format, table);
+
+	uint8_t indices[259];
+	for (unsigned i = 0; i < sizeof(indices); ++i)
+		indices[i] = static_cast<uint8_t>(i * 11);
+
+	for (const PaletteRowKernel kernel : { PaletteRowKernel::AVX2, PaletteRowKernel::NEON }) {
+		const ConvertPaletteRow32Fn convert = GetConvertPaletteRow32Kernel(kernel);
+		if (convert == nullptr)
+			continue;
+		// Odd lengths exercise both the vector loop and the scalar tail.
+		for (unsigned count : { 0U, 1U, 7U, 8U, 15U, 16U, 17U, 33U, 256U, 259U }) {
+			uint32_t expected[259];
+			uint32_t actual[259];
+			ConvertPaletteRow32Scalar(indices, expected, count, table);
+			convert(indices, actual, count, table);
+			EXPECT_EQ(std::memcmp(expected, actual, count * sizeof(uint32_t)), 0) << "kernel " << static_cast<int>(kernel) << " count " << count;
+		}
+	}
+
+	// The scalar kernel against the palette itself.
+	uint32_t actual[259];
+	GetConvertPaletteRow32Kernel(PaletteRowKernel::Scalar)(indices, actual, 259, table);
+	for (unsigned i = 0; i < 259; ++i)
+		EXPECT_EQ(actual[i], table.pixels[indices[i]]) << "index " << i;
+}
+
+TEST(PaletteBlitTest, BlitMatchesSDL)
+{
+	SDLPaletteUniquePtr palette = CreateTestPalette();
+	SDLSurfaceUniquePtr src = CreateTestPalSurface(palette.get());
+
+	for (Uint32 format : { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 }) {
+		SDLSurfaceUniquePtr expected = SDLWrap::CreateRGBSurfaceWithFormat(0, Width, Height, 32, format);
+		SDLSurfaceUniquePtr actual = SDLWrap::CreateRGBSurfaceWithFormat(0, Width, Height, 32, format);
+		ASSERT_TRUE(CanBlitPaletteSurface32(*src, *actual));
+
+		SDL_Rect srcRect { 3, 2, Width - 5, Height - 4 };
+		SDL_Rect dstRect { 1, 1, 0, 0 };
+		ASSERT_EQ(SDL_BlitSurface(src.get(), &srcRect, expected.get(), &dstRect), 0);
+
+		PaletteBlitTable table;
+		BuildPaletteBlitTable(*palette, *actual->format, table);
+		dstRect = { 1, 1, 0, 0 };
+		BlitPaletteSurface32(*src, &srcRect, *actual, &dstRect, table);
+
+		ExpectSurfacesEqual(*expected, *actual);
+	}
+}
+
+TEST(PaletteBlitTest, ScaledBlitMatchesNearestNeighbour)
+{
+	SDLPaletteUniquePtr palette = CreateTestPalette();
+	SDLSurfaceUniquePtr src = CreateTestPalSurface(palette.get());
+
+	for (unsigned factor : { 2U, 3U, 4U }) {
+		SDLSurfaceUniquePtr unscaled = SDLWrap::CreateRGBSurfaceWithFormat(0, Width, Height, 32, SDL_PIXELFORMAT_RGB888);
+		ASSERT_EQ(SDL_BlitSurface(src.get(), nullptr, unscaled.get(), nullptr), 0);
+
+		SDLSurfaceUniquePtr expected = SDLWrap::CreateRGBSurfaceWithFormat(0, Width * factor, Height * factor, 32, SDL_PIXELFORMAT_RGB888);
+		auto *expectedPixels = static_cast<uint8_t *>(expected->pixels);
+		for (int y = 0; y < expected->h; ++y) {
+			for (int x = 0; x < expected->w; ++x) {
+				const auto *srcPixel = static_cast<const uint8_t *>(unscaled->pixels) + (y / factor) * unscaled->pitch + (x / factor) * 4;
+				std::memcpy(expectedPixels + y * expected->pitch + x * 4, srcPixel, 4);
+			}
+		}
+
+		SDLSurfaceUniquePtr actual = SDLWrap::CreateRGBSurfaceWithFormat(0, Width * factor, Height * factor, 32, SDL_PIXELFORMAT_RGB888);
+		PaletteBlitTable table;
+		BuildPaletteBlitTable(*palette, *actual->format, table);
+		BlitPaletteSurfaceScaled32(*src, nullptr, *actual, nullptr, factor, table);
+		ExpectSurfacesEqual(*expected, *actual);
+	}
+}
+
+} // namespace
+} // namespace devilution
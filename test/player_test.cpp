@@ -181,3 +181,36 @@ TEST(Player, CreatePlayer)
 	CreatePlayer(Players[0], HeroClass::Rogue);
 	AssertPlayer(Players[0]);
 }
+
+TEST(Player, CalcPlrInvAfterEquipmentChanges)
+{
+	Players.resize(1);
+	Player &player = Players[0];
+	CreatePlayer(player, HeroClass::Rogue);
+	const int toHit = player._pIBonusToHit;
+	const int maxDamage = player._pIMaxDam;
+
+	Item &ring = player.InvBody[INVLOC_RING_LEFT];
+	InitializeItem(ring, IDI_TRING);
+	ring._iMagical = ITEM_QUALITY_MAGIC;
+	ring._iIdentified = true;
+	ring._iStatFlag = true;
+	ring._iPLFR = 30;
+	ring._iPLStr = 5;
+	CalcPlrInv(player, false);
+	EXPECT_EQ(player._pFireResist, 30);
+	EXPECT_EQ(player._pStrength, player._pBaseStr + 5);
+
+	// Items are also changed in place while equipped.
+	player.InvBody[INVLOC_HAND_LEFT]._iPLToHit += 10;
+	CalcPlrInv(player, false);
+	EXPECT_EQ(player._pIBonusToHit, toHit + 10);
+
+	ring.clear();
+	player.InvBody[INVLOC_HAND_LEFT]._iPLToHit -= 10;
+	CalcPlrInv(player, false);
+	EXPECT_EQ(player._pFireResist, 0);
+	EXPECT_EQ(player._pStrength, player._pBaseStr);
+	EXPECT_EQ(player._pIBonusToHit, toHit);
+	EXPECT_EQ(player._pIMaxDam, maxDamage);
+}
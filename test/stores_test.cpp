@@ -1,11 +1,76 @@
 #include <gtest/gtest.h>
 
+#include <vector>
+
+#include "engine/random.hpp"
+#include "items.h"
+#include "player.h"
 #include "stores.h"
 
 using namespace devilution;
 
 namespace {
 
+/** @brief The store stock and the rubble next to the Hell entrance, which `CreateTown` rolls from where the stock left the RNG. */
+struct TownStock {
+	std::vector<Item> items;
+	std::vector<int> rubble;
+};
+
+TownStock GetTownStock()
+{
+	TownStock stock;
+	stock.items.insert(stock.items.end(), std::begin(smithitem), std::end(smithitem));
+	stock.items.insert(stock.items.end(), std::begin(premiumitems), std::end(premiumitems));
+	stock.items.insert(stock.items.end(), std::begin(healitem), std::end(healitem));
+	stock.items.insert(stock.items.end(), std::begin(witchitem), std::end(witchitem));
+	stock.items.push_back(boyitem);
+	for (int x = 36; x < 46; x++)
+		stock.rubble.push_back(GenerateRnd(4) + 1);
+	return stock;
+}
+
+void SetUpStoresPlayer()
+{
+	Players.resize(1);
+	MyPlayer = &Players[0];
+	gbIsMultiplayer = false;
+	MyPlayer->_pLevel = 12;
+	MyPlayer->_pLvlVisited[6] = true;
+	InitStores();
+}
+
+TEST(Stores, TownStockMatchesBaseline)
+{
+	constexpr uint32_t Seed = 1729;
+
+	// What entering town did before the stock was spawned on a worker thread.
+	SetUpStoresPlayer();
+	SetRndSeed(Seed);
+	SpawnSmith(8);
+	SpawnWitch(8);
+	SpawnHealer(8);
+	SpawnBoy(MyPlayer->_pLevel);
+	SpawnPremium(*MyPlayer);
+	const TownStock baseline = GetTownStock();
+
+	SetUpStoresPlayer();
+	SetRndSeed(Seed);
+	QueueTownStores();
+	SetRndSeed(0); // The level loader keeps rolling while the stock is spawned.
+	FinishTownStores();
+	const TownStock queued = GetTownStock();
+
+	EXPECT_EQ(queued.rubble, baseline.rubble);
+	ASSERT_EQ(queued.items.size(), baseline.items.size());
+	for (size_t i = 0; i < baseline.items.size(); i++) {
+		EXPECT_EQ(queued.items[i].IDidx, baseline.items[i].IDidx) << "Item " << i;
+		EXPECT_EQ(queued.items[i]._iSeed, baseline.items[i]._iSeed) << "Item " << i;
+		EXPECT_EQ(queued.items[i]._iCreateInfo, baseline.items[i]._iCreateInfo) << "Item " << i;
+		EXPECT_EQ(queued.items[i]._iIvalue, baseline.items[i]._iIvalue) << "Item " << i;
+	}
+}
+
 TEST(Stores, AddStoreHoldRepair_magic)
 {
 	Item *item;
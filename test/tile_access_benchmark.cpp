@@ -0,0 +1,205 @@
+/**
+ * @file tile_access_benchmark.cpp
+ *
+ * Times the per-tile lookups of movement and rendering on a synthetic level, to compare the dungeon
+ * tile layouts (build once with and once without DEVILUTIONX_PACKED_DUNGEON_TILES).
+ *
+ * Usage: tile_access_benchmark [--passes 200] [--seed 1]
+ *
+ * The rendering pass reads the same tile state as `DrawDungeon` for every tile of a view sliding
+ * over the map, without drawing anything, so it only measures the memory access.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "engine/path.h"
+#include "engine/random.hpp"
+#include "items.h"
+#include "levels/gendung.h"
+#include "monster.h"
+#include "player.h"
+
+using namespace devilution;
+
+namespace {
+
+constexpr int ViewColumns = 20;
+constexpr int ViewRows = 30;
+
+struct BenchmarkOptions {
+	int passes = 200;
+	uint32_t seed = 1;
+};
+
+/**
+ * @brief Fills the level with floor and walls and scatters monsters, players, items and objects, like a populated level.
+ */
+void CreateSyntheticLevel(uint32_t seed)
+{
+	SOLData.fill(TileProperties::None);
+	SOLData[1] = TileProperties::Solid | TileProperties::BlockLight | TileProperties::BlockMissile;
+
+	SetRndSeed(seed);
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			const bool edge = x < 16 || y < 16 || x >= MAXDUNX - 16 || y >= MAXDUNY - 16;
+			dPiece[x][y] = edge || GenerateRnd(4) == 0 ? 1 : 0;
+			dFlags[x][y] = GenerateRnd(3) == 0 ? DungeonFlag::Visible | DungeonFlag::Lit : DungeonFlag::Lit;
+			dLight[x][y] = static_cast<char>(GenerateRnd(16));
+			dTransVal[x][y] = static_cast<int8_t>(GenerateRnd(8));
+			// Negative ids are actors moving onto the tile, they block it without looking up the actor itself.
+			dMonster[x][y] = GenerateRnd(50) == 0 ? -1 : 0;
+			dPlayer[x][y] = GenerateRnd(500) == 0 ? -1 : 0;
+			dItem[x][y] = GenerateRnd(100) == 0 ? 1 : 0;
+			dCorpse[x][y] = GenerateRnd(100) == 0 ? 1 : 0;
+			dSpecial[x][y] = GenerateRnd(20) == 0 ? 1 : 0;
+			dObject[x][y] = 0;
+		}
+	}
+}
+
+template <typename Function>
+double TimeNanoseconds(Function function)
+{
+	const auto start = std::chrono::steady_clock::now();
+	function();
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void PrintResult(const char *name, double nanoseconds, uint64_t calls, uint64_t checksum)
+{
+	std::printf("%-18s %8.2f ns/call (%llu calls, checksum %llu)\n", name, nanoseconds / calls,
+	    static_cast<unsigned long long>(calls), static_cast<unsigned long long>(checksum));
+}
+
+void BenchmarkPosOkPlayer(const BenchmarkOptions &options)
+{
+	const Player &player = *MyPlayer;
+	uint64_t ok = 0;
+	const double time = TimeNanoseconds([&]() {
+		for (int pass = 0; pass < options.passes; pass++) {
+			for (int x = 0; x < MAXDUNX; x++) {
+				for (int y = 0; y < MAXDUNY; y++)
+					ok += PosOkPlayer(player, { x, y }) ? 1 : 0;
+			}
+		}
+	});
+	PrintResult("PosOkPlayer", time, static_cast<uint64_t>(options.passes) * MAXDUNX * MAXDUNY, ok);
+}
+
+void BenchmarkIsTileAvailable(const BenchmarkOptions &options)
+{
+	const Monster monster {};
+	uint64_t ok = 0;
+	const double time = TimeNanoseconds([&]() {
+		for (int pass = 0; pass < options.passes; pass++) {
+			for (int x = 0; x < MAXDUNX; x++) {
+				for (int y = 0; y < MAXDUNY; y++)
+					ok += IsTileAvailable(monster, { x, y }) ? 1 : 0;
+			}
+		}
+	});
+	PrintResult("IsTileAvailable", time, static_cast<uint64_t>(options.passes) * MAXDUNX * MAXDUNY, ok);
+}
+
+void BenchmarkFindPath(const BenchmarkOptions &options)
+{
+	const Player &player = *MyPlayer;
+	int8_t path[MaxPathLength];
+	uint64_t steps = 0;
+	const uint64_t paths = static_cast<uint64_t>(options.passes) * 100;
+	SetRndSeed(options.seed);
+	const double time = TimeNanoseconds([&]() {
+		for (uint64_t i = 0; i < paths; i++) {
+			const Point start { 16 + GenerateRnd(MAXDUNX - 32), 16 + GenerateRnd(MAXDUNY - 32) };
+			const Point destination = start + Displacement { GenerateRnd(21) - 10, GenerateRnd(21) - 10 };
+			steps += FindPath([&player](Point position) { return PosOkPlayer(player, position); }, start, destination, path);
+		}
+	});
+	PrintResult("FindPath", time, paths, steps);
+}
+
+void BenchmarkViewTiles(const BenchmarkOptions &options)
+{
+	uint64_t checksum = 0;
+	uint64_t tiles = 0;
+	const double time = TimeNanoseconds([&]() {
+		for (int pass = 0; pass < options.passes; pass++) {
+			const int viewY = ViewColumns + pass % (MAXDUNY - ViewColumns - ViewRows / 2);
+			for (int viewX = 0; viewX + ViewColumns + ViewRows / 2 < MAXDUNX; viewX += 4) {
+				// Like `DrawTileContent`, each screen row is a diagonal of the map, going east.
+				Point rowStart { viewX, viewY };
+				for (int row = 0; row < ViewRows; row++) {
+					for (int column = 0; column < ViewColumns; column++) {
+						const int x = rowStart.x + column;
+						const int y = rowStart.y - column;
+						if (!HasAnyOf(dFlags[x][y], DungeonFlag::Lit))
+							continue;
+						checksum += dPiece[x][y] + dLight[x][y] + dTransVal[x][y];
+						if (dMonster[x][y] != 0 || dPlayer[x][y] != 0)
+							checksum++;
+						checksum += dItem[x][y] + dObject[x][y] + dCorpse[x][y] + dSpecial[x][y];
+						if (HasAnyOf(dFlags[x][y], DungeonFlag::Visible))
+							checksum++;
+						tiles++;
+					}
+					rowStart += (row % 2) == 0 ? Displacement { 1, 0 } : Displacement { 0, 1 };
+				}
+			}
+		}
+	});
+	PrintResult("view tiles", time, tiles, checksum);
+}
+
+[[noreturn]] void PrintUsage(const char *program)
+{
+	std::fprintf(stderr, "Usage: %s [--passes 200] [--seed 1]\n", program);
+	std::exit(EXIT_FAILURE);
+}
+
+BenchmarkOptions ParseOptions(int argc, char **argv)
+{
+	BenchmarkOptions options;
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		if (i + 1 >= argc)
+			PrintUsage(argv[0]);
+		const char *value = argv[++i];
+		if (std::strcmp(arg, "--passes") == 0) {
+			options.passes = std::max(std::atoi(value), 1);
+		} else if (std::strcmp(arg, "--seed") == 0) {
+			options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else {
+			PrintUsage(argv[0]);
+		}
+	}
+	return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	const BenchmarkOptions options = ParseOptions(argc, argv);
+
+	Players.resize(1);
+	MyPlayer = &Players[0];
+	leveltype = DTYPE_CATHEDRAL;
+	CreateSyntheticLevel(options.seed);
+
+#ifdef DEVILUTIONX_PACKED_DUNGEON_TILES
+	std::printf("Layout: one %zu byte record per tile\n", sizeof(DungeonTile));
+#else
+	std::printf("Layout: one array per field\n");
+#endif
+	BenchmarkPosOkPlayer(options);
+	BenchmarkIsTileAvailable(options);
+	BenchmarkFindPath(options);
+	BenchmarkViewTiles(options);
+
+	return EXIT_SUCCESS;
+}
@@ -384,6 +384,7 @@ TEST(Writehero, pfile_write_hero)
 	UnPackPlayer(&pks, *MyPlayer, true);
 	AssertPlayer(Players[0]);
 	pfile_write_hero();
+	pfile_flush_saves();
 
 	const char *path = "multi_0.sv";
 	uintmax_t size;